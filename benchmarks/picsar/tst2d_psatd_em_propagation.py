@@ -0,0 +1,58 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+#   Vacuum propagation with the native PSATD solver: an antenna uniform along y
+#   emits two plane pulses along +x and -x, with a timestep twice the cell length
+#   (beyond the Yee CFL). Without numerical dispersion, the pulses travel at c
+#   and keep their energy.
+#   Requires a build with FFTW (config=fftw).
+# ----------------------------------------------------------------------------------------
+
+import math
+
+l0 = 2.0*math.pi        # laser wavelength
+t0 = l0                 # optical cycle
+resx = 16.              # nb of cells in one laser wavelength
+rest = 8.               # nb of timesteps in one optical cycle
+Lx = 32.*l0
+xa = 0.5*Lx             # antenna position
+
+Main(
+    geometry = "2Dcartesian",
+    interpolation_order = 2,
+    maxwell_solver = "PSATD",
+    cell_length = [l0/resx, l0/resx],
+    grid_length  = [Lx, 2.*l0],
+    number_of_patches = [16, 2],
+    timestep = t0/rest,
+    simulation_time = 14.*t0,
+    EM_boundary_conditions = [ ["periodic"], ["periodic"] ],
+    solve_poisson = False,
+)
+
+MultipleDecomposition(
+    region_ghost_cells = 16,
+)
+
+Antenna(
+    field = 'Jz',
+    time_profile = lambda t: math.sin(t)*math.exp(-((t-4.*t0)/(1.5*t0))**2),
+    space_profile = lambda x,y: math.exp(-((x-xa)/(0.25*l0))**2),
+)
+
+DiagFields(
+    every = [int(8*rest), int(6*rest)],
+    fields = ['Ez']
+)
+
+DiagScalar(
+    every = int(rest),
+    vars = ['Uelm'],
+)
+
+# Poynting flux on each side of the antenna (uniform along y)
+for xp in [xa-4.*l0, xa+4.*l0]:
+    DiagProbe(
+        every = 1,
+        origin = [xp, l0],
+        fields = ['PoyX'],
+    )
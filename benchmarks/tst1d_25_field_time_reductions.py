@@ -0,0 +1,66 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+#   In-situ time reductions (rms, max, dft) of field and probe diagnostics,
+#   applied to a plane wave of constant amplitude
+# ----------------------------------------------------------------------------------------
+
+import math
+l0 = 2.0*math.pi  # wavelength in normalized units
+t0 = l0           # optical cycle in normalized units
+rest = 34         # nb of timestep in 1 optical cycle
+resx = 32.0       # nb cells in 1 wavelength
+a0 = 0.01
+period = 4*rest   # the reductions cover 4 optical cycles
+
+Main(
+    geometry = "1Dcartesian",
+    interpolation_order = 2,
+    
+    cell_length = [l0/resx],
+    grid_length  = [4.0*l0],
+    
+    number_of_patches = [ 8 ],
+    
+    timestep = t0/rest,
+    simulation_time = 12.0*t0,
+    
+    EM_boundary_conditions = [ ['silver-muller'] ],
+    
+    print_every = rest,
+)
+
+LaserPlanar1D(
+    a0 = a0,
+    omega = 1.,
+    time_envelope = tconstant(),
+)
+
+DiagFields(
+    every = period,
+    fields = ['Ey'],
+    time_average = period,
+    time_reduction = "rms",
+)
+
+DiagFields(
+    every = period,
+    fields = ['Ey'],
+    time_average = period,
+    time_reduction = "max",
+)
+
+DiagFields(
+    every = period,
+    fields = ['Ey'],
+    time_average = period,
+    time_reduction = "dft",
+    frequencies = [1., 2.],
+)
+
+DiagProbe(
+    every = period,
+    origin = [Main.grid_length[0]*0.5],
+    fields = ['Ey'],
+    time_average = period,
+    time_reduction = "rms",
+)
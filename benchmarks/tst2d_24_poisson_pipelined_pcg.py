@@ -0,0 +1,76 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+#   Initial fields of a sinusoidal charge perturbation, computed by the
+#   pipelined preconditioned conjugate gradient Poisson solver
+# ----------------------------------------------------------------------------------------
+
+from math import pi, cos
+
+dx = 0.25
+dy = 0.25
+ny = 64                     # cells in one wavelength of the perturbation along y
+Ly = ny*dy
+k  = 2.*pi/Ly
+delta = 0.05                # relative amplitude of the electron density perturbation
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [dx, dy],
+    grid_length  = [4.*Ly, Ly],
+    
+    number_of_patches = [ 8, 4 ],
+    
+    timestep = 0.95*dx/2**0.5,
+    simulation_time = 2*0.95*dx/2**0.5,
+    
+    EM_boundary_conditions = [
+        ['silver-muller'],
+        ['periodic'],
+    ],
+    
+    solve_poisson = True,
+    poisson_solver = "pipelined_PCG",
+    poisson_chebyshev_degree = 4,
+    poisson_max_iteration = 50000,
+    poisson_max_error = 1.e-14,
+    
+    print_every = 1,
+)
+
+Species(
+    name = "ion",
+    position_initialization = "regular",
+    momentum_initialization = "cold",
+    particles_per_cell = 4,
+    mass = 1836.,
+    charge = 1.0,
+    number_density = 1.,
+    time_frozen = 10.,
+    boundary_conditions = [
+        ["remove", "remove"],
+        ["periodic", "periodic"],
+    ],
+)
+
+Species(
+    name = "eon",
+    position_initialization = "regular",
+    momentum_initialization = "cold",
+    particles_per_cell = 4,
+    mass = 1.0,
+    charge = -1.0,
+    number_density = lambda x,y: 1. + delta*cos(k*y),
+    time_frozen = 10.,
+    boundary_conditions = [
+        ["remove", "remove"],
+        ["periodic", "periodic"],
+    ],
+)
+
+DiagFields(
+    every = 1,
+    fields = ['Ex','Ey','Rho']
+)
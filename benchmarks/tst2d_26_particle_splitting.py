@@ -0,0 +1,55 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+#
+# Particle splitting of neutral, drifting particles: no field is created,
+# so that the total weight and momentum must be conserved across the splits
+# ----------------------------------------------------------------------------------------
+
+dx = 0.5
+Lx = 16.
+nsplit = 5
+
+Main(
+    geometry = "2Dcartesian",
+    interpolation_order = 2,
+    timestep = 0.95 * dx / 2**0.5,
+    simulation_time = 4 * nsplit * 0.95 * dx / 2**0.5,
+    cell_length  = [dx, dx],
+    grid_length = [Lx, Lx],
+    number_of_patches = [4, 4],
+    EM_boundary_conditions = [ ["periodic"], ["periodic"] ],
+    random_seed = 0,
+)
+
+for name, displacement in [("split", 0.), ("split_displaced", 0.25)]:
+    Species(
+        name = name,
+        position_initialization = "random",
+        momentum_initialization = "maxwell-juettner",
+        particles_per_cell = 2,
+        mass = 1.0,
+        charge = 0.,
+        number_density = 1.,
+        mean_velocity = [0.3, 0.1, 0.],
+        temperature = [0.01],
+        boundary_conditions = [["periodic"], ["periodic"]],
+        # Splitting parameters
+        splitting_method = "pair",
+        split_every = nsplit,
+        split_target_particles_per_cell = 8,
+        split_displacement = displacement,
+    )
+
+DiagScalar(
+    every = 1,
+    vars = ["Ntot_split", "Ntot_split_displaced"],
+)
+
+for name in ["split", "split_displaced"]:
+    for quantity in ["weight", "weight_px", "weight_py"]:
+        DiagParticleBinning(
+            deposited_quantity = quantity,
+            every = 1,
+            species = [name],
+            axes = [ ["x", 0., Lx, 1] ],
+        )
@@ -282,7 +282,10 @@ class Field(Diagnostic):
 	def _info(self):
 		s = "Field diagnostic #"+str(self.diagNumber)+": "+self._title
 		tavg = self.namelist.DiagFields[self.diagNumber].time_average
-		if tavg > 1:
+		tred = self.namelist.DiagFields[self.diagNumber].time_reduction
+		if tred != "average":
+			s += "\n\tTime_reduction: " + tred + " over " + str(tavg) + " timesteps"
+		elif tavg > 1:
 			s += "\n\tTime_average: " + str(tavg) + " timesteps"
 		if any(self._offset > 0.):
 			s += "\n\tGrid offset: " + ", ".join([str(a) for a in self._offset])
@@ -453,6 +453,22 @@ class TrackParticles(ParticleList):
 							ordered[locs] = group[k][()][selectedIndices]
 							f0[name].write_direct(ordered, dest_sel=self._np.s_[it,:])
 				
+				# If particles already sorted by ID, only one pass on the chunks
+				elif selectedIds is None and "sorted_offsets" in f["data/"+"%010i/"%t]:
+					for first_i, last_i, npart_i in ChunkedRange(nparticles, chunksize):
+						ID = group["id"][first_i:last_i]
+						loc_in_output = ID.astype("uint32") + offset[ (ID>>32).astype("uint32") & 0b111111111111111111111111 ] - 1
+						first_o, last_o = int(loc_in_output[0]), int(loc_in_output[-1])+1
+						loc_in_output -= first_o
+						for k, name in self._short_properties_from_raw.items():
+							if k not in group: continue
+							ordered = self._np.empty((last_o-first_o, ), dtype=group[k].dtype)
+							if k == "id"      : ordered.fill(0)
+							elif k == "charge": ordered.fill(9999)
+							else              : ordered.fill(self._np.nan)
+							ordered[loc_in_output] = group[k][first_i:last_i]
+							f0[name][it, first_o:last_o] = ordered
+				
 				# If too many particles, sort by chunks
 				else:
 					data = {}
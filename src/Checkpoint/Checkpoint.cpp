@@ -9,6 +9,10 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
 
 #include <mpi.h>
 
@@ -92,55 +96,147 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
         smpi->barrier();
 
         if( params.restart ) {
+            // Only the master looked for the restart files: it sends the list to all processes
             std::vector<std::string> restart_files;
-            if( ! PyTools::extractV( "restart_files", restart_files, "Checkpoints" ) ) {
-                ERROR( "Internal parameter `restart_files` not understood. This should not happen" );
+            string all_files( "" );
+            if( smpi->isMaster() ) {
+                if( ! PyTools::extractV( "restart_files", restart_files, "Checkpoints" ) ) {
+                    ERROR( "Internal parameter `restart_files` not understood. This should not happen" );
+                }
+                for( unsigned int ifile=0; ifile<restart_files.size(); ifile++ ) {
+                    all_files += restart_files[ifile] + "\n";
+                }
+            }
+            smpi->bcast( all_files );
+            restart_files.resize( 0 );
+            istringstream files_stream( all_files );
+            for( string file; getline( files_stream, file ); ) {
+                restart_files.push_back( file );
             }
 
-            // This will open all dumps and pick the last one
-            restart_file = "";
-            for( unsigned int num_dump=0; num_dump<restart_files.size(); num_dump++ ) {
-                string dump_name = restart_files[num_dump];
-                H5Read f( dump_name, NULL, false );
-                if( f.valid() ) {
-                    unsigned int dump_step = 0;
-                    f.attr( "dump_step", dump_step );
-                    if( dump_step > this_run_start_step ) {
-                        this_run_start_step = dump_step;
-                        restart_file = dump_name;
-                        dump_number = num_dump;
-                        f.attr( "dump_number", dump_number );
-                    }
+            // Sort the files of all MPI processes by dump number and file index:
+            // the simulation may restart with a different number of MPI processes
+            map<unsigned int, map<int, string> > dumps;
+            for( unsigned int ifile=0; ifile<restart_files.size(); ifile++ ) {
+                size_t pos = restart_files[ifile].rfind( "dump-" );
+                unsigned int num;
+                int index;
+                if( pos == string::npos || sscanf( restart_files[ifile].c_str() + pos, "dump-%u-%d.h5", &num, &index ) != 2 ) {
+                    ERROR( "Restart file `" << restart_files[ifile] << "` is not named as a checkpoint" );
                 }
+                dumps[num][index] = restart_files[ifile];
             }
 
-            if( restart_file == "" ) {
-                ERROR( "Cannot find a valid restart file for rank "<<smpi->getRank() );
+            // The master opens all dumps and sorts them from the last one to the first one
+            vector<int> candidates;
+            if( smpi->isMaster() ) {
+                vector<pair<unsigned int, int> > steps;
+                for( auto &dump : dumps ) {
+                    H5Read f( dump.second.begin()->second, NULL, false );
+                    if( f.valid() ) {
+                        unsigned int step = 0;
+                        f.attr( "dump_step", step );
+                        steps.push_back( make_pair( step, ( int ) dump.first ) );
+                    }
+                }
+                sort( steps.rbegin(), steps.rend() );
+                for( unsigned int i=0; i<steps.size(); i++ ) {
+                    candidates.push_back( steps[i].second );
+                }
+            }
+            int n_candidates = candidates.size();
+            smpi->bcast( n_candidates );
+            candidates.resize( n_candidates );
+            if( n_candidates > 0 ) {
+                MPI_Bcast( &candidates[0], n_candidates, MPI_INT, 0, smpi->world() );
             }
 
-            // Make sure all ranks have the same dump number
-            // Different numbers can be due to corrupted restart files
-            if( ! smpi->test_mode ) {
-                unsigned int prev_number;
-                MPI_Status status;
-                MPI_Sendrecv(
-                    &dump_number, 1, MPI_UNSIGNED, (smpi->getRank()+1) % smpi->getSize(), smpi->getRank(),
-                    &prev_number, 1, MPI_UNSIGNED, (smpi->getRank()+smpi->getSize()-1) % smpi->getSize(), (smpi->getRank()+smpi->getSize()-1)%smpi->getSize(),
-                    smpi->world(), &status
-                );
-                int problem = (prev_number != dump_number);
-                int any_problem;
-                MPI_Allreduce( &problem, &any_problem, 1, MPI_INT, MPI_LOR, smpi->world() );
-                if( any_problem ) {
-                    if( problem ) {
-                        ostringstream t("");
-                        t << "\t[ERROR]: Issue with restart file on rank " << smpi->getRank() << endl;
-                        cout << t.str();
+            // Make sure that all the files of a dump exist and have the same dump number
+            // (corrupted or partly written files otherwise), or fall back to the previous dump
+            int restart_num = -1;
+            vector<int> expected;
+            for( int icand=0; icand<n_candidates; icand++ ) {
+                map<int, string> &paths = dumps[candidates[icand]];
+                int problem = 0;
+                unsigned int number_min = numeric_limits<unsigned int>::max(), number_max = 0;
+                // The first file tells which files belong to the dump: other files matching
+                // dump-<n>-*.h5 may remain from a previous run with another layout
+                expected.resize( 0 );
+                if( smpi->isMaster() ) {
+                    H5Read f( paths.begin()->second, NULL, false );
+                    if( f.valid() ) {
+                        vector<int> file_of_rank( f.vectSize( "patch_count" ) );
+                        if( f.has( "file_of_rank" ) ) {
+                            f.vect( "file_of_rank", file_of_rank );
+                        } else {
+                            for( unsigned int irk=0; irk<file_of_rank.size(); irk++ ) {
+                                file_of_rank[irk] = irk;
+                            }
+                        }
+                        expected = file_of_rank;
+                        sort( expected.begin(), expected.end() );
+                        expected.erase( unique( expected.begin(), expected.end() ), expected.end() );
+                        for( unsigned int i=0; i<expected.size(); i++ ) {
+                            if( paths.count( expected[i] ) == 0 ) {
+                                problem = 1;
+                            }
+                        }
+                    } else {
+                        problem = 1;
+                    }
+                }
+                smpi->bcast( problem );
+                int n_expected = expected.size();
+                smpi->bcast( n_expected );
+                expected.resize( n_expected );
+                if( n_expected > 0 ) {
+                    MPI_Bcast( &expected[0], n_expected, MPI_INT, 0, smpi->world() );
+                }
+                // Each process checks a share of the expected files
+                if( ! problem ) {
+                    if( ! smpi->test_mode ) {
+                        for( int i=smpi->getRank(); i<n_expected; i+=smpi->getSize() ) {
+                            H5Read f( paths[expected[i]], NULL, false );
+                            if( ! f.valid() ) {
+                                problem = 1;
+                                continue;
+                            }
+                            unsigned int number = 0;
+                            f.attr( "dump_number", number );
+                            number_min = min( number_min, number );
+                            number_max = max( number_max, number );
+                        }
+                        MPI_Allreduce( MPI_IN_PLACE, &problem, 1, MPI_INT, MPI_LOR, smpi->world() );
+                        MPI_Allreduce( MPI_IN_PLACE, &number_min, 1, MPI_UNSIGNED, MPI_MIN, smpi->world() );
+                        MPI_Allreduce( MPI_IN_PLACE, &number_max, 1, MPI_UNSIGNED, MPI_MAX, smpi->world() );
+                    } else {
+                        H5Read f( paths.begin()->second );
+                        f.attr( "dump_number", number_min );
+                        number_max = number_min;
                     }
-                    MPI_Finalize();
-                    exit(EXIT_FAILURE);
                 }
+                if( ! problem && number_min == number_max ) {
+                    restart_num = candidates[icand];
+                    dump_number = number_min;
+                    break;
+                }
+                WARNING( "Checkpoint files dump-" << candidates[icand] << "-*.h5 are missing or corrupted: trying the previous dump" );
+            }
+
+            if( restart_num < 0 ) {
+                ERROR( "Cannot find a valid restart file" );
             }
+            // Only the files of the dump layout are kept
+            restart_file = dumps[restart_num].begin()->second;
+            restart_paths_.clear();
+            for( unsigned int i=0; i<expected.size(); i++ ) {
+                restart_paths_[expected[i]] = dumps[restart_num][expected[i]];
+            }
+            if( smpi->isMaster() ) {
+                H5Read f( restart_file );
+                f.attr( "dump_step", this_run_start_step );
+            }
+            MPI_Bcast( &this_run_start_step, 1, MPI_UNSIGNED, 0, smpi->world() );
 
 #ifdef  __DEBUG
             MESSAGEALL( 2, " : Restarting fields and particles, dump_number = " << dump_number << " step=" << this_run_start_step << "\n\t\t" << restart_file );
@@ -200,6 +296,8 @@ void Checkpoint::dump( VectorPatch &vecPatches, Region &region, unsigned int iti
     dump_now = dump_now || ( dump_step != 0 && ( ( itime-this_run_start_step ) % dump_step == 0 ) );
     
     if( signal_received != 0 || dump_now ) {
+        // The diagnostics files are complete when the checkpoint is written
+        vecPatches.waitDiagsOutput();
         dumpAll( vecPatches, region, itime,  smpi, simWindow, params );
         if( exit_after_dump || ( ( signal_received!=0 ) && ( signal_received != SIGUSR2 ) ) ) {
             exit_asap = true;
@@ -213,25 +311,29 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
 {
     unsigned int num_dump=dump_number % keep_n_dumps;
 
+    // With subfiling, the MPI processes of a group dump in the same file
+    int file_index = smpi->hasSubfiles() ? smpi->subfileIndex() : smpi->getRank();
+    int nfiles     = smpi->hasSubfiles() ? smpi->subfileOf( smpi->getSize()-1 )+1 : smpi->getSize();
+
     ostringstream nameDumpTmp( "" );
     nameDumpTmp << "checkpoints" << PATH_SEPARATOR;
     if( file_grouping>0 ) {
-        nameDumpTmp << setfill( '0' ) << setw( int( 1+log10( smpi->getSize()/file_grouping+1 ) ) ) << smpi->getRank()/file_grouping << PATH_SEPARATOR;
+        nameDumpTmp << setfill( '0' ) << setw( int( 1+log10( nfiles/file_grouping+1 ) ) ) << file_index/file_grouping << PATH_SEPARATOR;
     }
 
-    nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << smpi->getRank() << ".h5" ;
+    nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << file_index << ".h5" ;
     std::string dumpName=nameDumpTmp.str();
 
-
-    H5Write f( dumpName );
     dump_number++;
 
-#ifdef  __DEBUG
-    //MESSAGEALL( "Step " << itime << " : DUMP fields and particles " << dumpName );
-    MESSAGEALL( " Checkpoint #" << dumpName << " at iteration " << itime << " dumped" );
-#else
-    MESSAGE( " Checkpoint #" << num_dump << " at iteration " << itime << " dumped" );
-#endif
+    // The Maxwell steps deferred in vacuum patches (Main.temporal_blocking) are applied before dumping the fields
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+        if( EMfields->deferred_steps_ > 0 ) {
+            EMfields->applyDeferredSteps( true );
+            EMfields->centerMagneticFields();
+        }
+    }
 
 #if defined( SMILEI_ACCELERATOR_GPU_OMP ) || defined( SMILEI_ACCELERATOR_GPU_OACC )
     MESSAGE( " Copying device data in main memory" );
@@ -245,6 +347,52 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
     //vecPatches.copyDeviceStateToHost();
 #endif
 
+    if( smpi->hasSubfiles() ) {
+        // The MPI processes of the group write the file one after the other
+        MPI_Comm &comm = smpi->subfileComm();
+        int rank, size, token = 0;
+        MPI_Comm_rank( comm, &rank );
+        MPI_Comm_size( comm, &size );
+        if( rank > 0 ) {
+            MPI_Recv( &token, 1, MPI_INT, rank-1, 0, comm, MPI_STATUS_IGNORE );
+        }
+        {
+            H5Write f( dumpName, NULL, true, rank > 0 );
+            if( rank == 0 ) {
+                dumpFileData( f, itime, smpi, simWin );
+            }
+            H5Write g = f.group( processGroupName( smpi->getRank() ) );
+            dumpProcessData( g, vecPatches, smpi, params );
+            if( params.multiple_decomposition ) {
+                dumpRegion( g, region, params );
+            }
+            dumpPatches( f, vecPatches, params );
+        }
+        if( rank < size-1 ) {
+            MPI_Send( &token, 1, MPI_INT, rank+1, 0, comm );
+        }
+    } else {
+        H5Write f( dumpName );
+        dumpFileData( f, itime, smpi, simWin );
+        dumpProcessData( f, vecPatches, smpi, params );
+        if( params.multiple_decomposition ) {
+            dumpRegion( f, region, params );
+        }
+        dumpPatches( f, vecPatches, params );
+    }
+
+#ifdef  __DEBUG
+    //MESSAGEALL( "Step " << itime << " : DUMP fields and particles " << dumpName );
+    MESSAGEALL( " Checkpoint #" << dumpName << " at iteration " << itime << " dumped" );
+#else
+    MESSAGE( " Checkpoint #" << num_dump << " at iteration " << itime << " dumped" );
+#endif
+
+}
+
+
+void Checkpoint::dumpFileData( H5Write &f, unsigned int itime, SmileiMPI *smpi, SimWindow *simWin )
+{
     // Write basic attributes
     f.attr( "Version", string( __VERSION ) );
 
@@ -253,6 +401,24 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
 
     f.vect( "patch_count", smpi->patch_count );
 
+    // File containing the data of each MPI process
+    if( smpi->hasSubfiles() ) {
+        vector<int> file_of_rank( smpi->getSize() );
+        for( int irk=0; irk<smpi->getSize(); irk++ ) {
+            file_of_rank[irk] = smpi->subfileOf( irk );
+        }
+        f.vect( "file_of_rank", file_of_rank );
+    }
+
+    // Write the moving window status
+    if( simWin!=NULL ) {
+        dumpMovingWindow( f, simWin );
+    }
+}
+
+
+void Checkpoint::dumpProcessData( H5Write &f, VectorPatch &vecPatches, SmileiMPI *smpi, Params &params )
+{
     // Write diags scalar data
     DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
     f.attr( "latest_timestep",   scalars->latest_timestep );
@@ -290,6 +456,19 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
         }
     }
 
+    // Write the latest Id that the MPI processes have given to each species
+    for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
+        if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
+            ostringstream n( "" );
+            n<< "latest_ID_" << track->species_name_;
+            f.attr( n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
+        }
+    }
+}
+
+
+void Checkpoint::dumpPatches( H5Write &f, VectorPatch &vecPatches, Params &params )
+{
     // Write all the patch data
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
 
@@ -305,30 +484,25 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
         g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
 
     }
+}
 
-    if (params.multiple_decomposition) {
-        // Open a group
-        ostringstream patch_name( "" );
-        patch_name << setfill( '0' ) << setw( 6 ) << region.patch_->Hindex();
-        string patchName=Tools::merge( "region-", patch_name.str() );
-        H5Write g = f.group( patchName.c_str() );
-        dumpPatch( region.patch_, params, g );
-    }
 
-    // Write the latest Id that the MPI processes have given to each species
-    for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
-        if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
-            ostringstream n( "" );
-            n<< "latest_ID_" << track->species_name_;
-            f.attr( n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
-        }
-    }
+void Checkpoint::dumpRegion( H5Write &f, Region &region, Params &params )
+{
+    // Open a group
+    ostringstream patch_name( "" );
+    patch_name << setfill( '0' ) << setw( 6 ) << region.patch_->Hindex();
+    string patchName=Tools::merge( "region-", patch_name.str() );
+    H5Write g = f.group( patchName.c_str() );
+    dumpPatch( region.patch_, params, g );
+}
 
-    // Write the moving window status
-    if( simWin!=NULL ) {
-        dumpMovingWindow( f, simWin );
-    }
 
+string Checkpoint::processGroupName( int rank )
+{
+    ostringstream name( "" );
+    name << "process-" << setfill( '0' ) << setw( 10 ) << rank;
+    return name.str();
 }
 
 
@@ -452,7 +626,7 @@ void Checkpoint::dumpPatch( Patch *patch, Params &params, H5Write &g )
         }
     }
 
-    // Fields required for DiagProbes with time integral
+    // Data required for DiagProbes with time integral or time reduction
     for( unsigned int iprobe=0; iprobe<patch->probes.size(); iprobe++ ) {
         unsigned int nFields = patch->probes[iprobe]->integrated_data.size();
         if( nFields > 0 ) {
@@ -588,6 +762,7 @@ void Checkpoint::dumpPatch( Patch *patch, Params &params, H5Write &g )
 
 void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
 {
+    // The first file of the dump has the attributes common to all files
     H5Read f( restart_file );
 
     // Read basic attributes
@@ -599,9 +774,39 @@ void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
         WARNING( "                while running version is " << string( __VERSION ) );
     }
 
-    vector<int> patch_count( smpi->getSize() );
-    f.vect( "patch_count", patch_count );
-    smpi->patch_count = patch_count;
+    int restart_size = f.vectSize( "patch_count" );
+    restart_patch_count_.resize( restart_size );
+    f.vect( "patch_count", restart_patch_count_ );
+
+    // Without subfiling, each MPI process dumped its own file
+    restart_file_of_rank_.resize( restart_size );
+    if( f.has( "file_of_rank" ) ) {
+        f.vect( "file_of_rank", restart_file_of_rank_ );
+    } else {
+        for( int irk=0; irk<restart_size; irk++ ) {
+            restart_file_of_rank_[irk] = irk;
+        }
+    }
+    for( int irk=0; irk<restart_size; irk++ ) {
+        if( restart_paths_.count( restart_file_of_rank_[irk] ) == 0 ) {
+            ERROR( "Restart file #" << restart_file_of_rank_[irk] << " is missing in dump " << restart_file );
+        }
+    }
+
+    if( restart_size == smpi->getSize() ) {
+        smpi->patch_count = restart_patch_count_;
+    } else {
+        // Different number of MPI processes: the patches are distributed evenly
+        WARNING( "Restarting with " << smpi->getSize() << " MPI processes from a dump of " << restart_size << " MPI processes" );
+        int tot_patches = 0;
+        for( int irk=0; irk<restart_size; irk++ ) {
+            tot_patches += restart_patch_count_[irk];
+        }
+        smpi->patch_count.resize( smpi->getSize() );
+        for( int irk=0; irk<smpi->getSize(); irk++ ) {
+            smpi->patch_count[irk] = tot_patches / smpi->getSize() + ( irk < tot_patches % smpi->getSize() ? 1 : 0 );
+        }
+    }
 
     smpi->patch_refHindexes.resize( smpi->patch_count.size(), 0 );
     smpi->patch_refHindexes[0] = 0;
@@ -611,6 +816,13 @@ void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
 
     // load window status : required to know the patch movement
     restartMovingWindow( f, simWin );
+
+    // File containing the data of the current MPI process
+    restart_redistributed_ = restart_size != smpi->getSize();
+    restart_process_name_ = processGroupName( smpi->getRank() );
+    if( smpi->getRank() < restart_size ) {
+        restart_file = restart_paths_[restart_file_of_rank_[smpi->getRank()]];
+    }
 }
 
 
@@ -618,28 +830,123 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
 {
     MESSAGE( 1, "READING fields and particles for restart" );
 
-    H5Read f( restart_file );
+    int restart_size = restart_patch_count_.size();
+
+    // Read the data of the MPI processes of the dump: the current process receives that of the processes
+    // with the same rank modulo the number of processes. Processes with no counterpart read the first one.
+    if( smpi->getRank() < restart_size ) {
+        for( int irk=smpi->getRank(); irk<restart_size; irk+=smpi->getSize() ) {
+            restartProcess( vecPatches, smpi, params, irk );
+        }
+    } else {
+        restartProcess( vecPatches, smpi, params, 0 );
+    }
+
+    // MPI process which dumped each patch, from the previous patch distribution
+    vector<int> restart_refHindexes( restart_size+1, 0 );
+    for( int irk=0; irk<restart_size; irk++ ) {
+        restart_refHindexes[irk+1] = restart_refHindexes[irk] + restart_patch_count_[irk];
+    }
+
+    // Read all the patch data
+    H5Read *f = NULL;
+    int current_file = -1;
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
+
+        int hindex = vecPatches( ipatch )->Hindex();
+        int irk = upper_bound( restart_refHindexes.begin(), restart_refHindexes.end(), hindex ) - restart_refHindexes.begin() - 1;
+        if( restart_file_of_rank_[irk] != current_file ) {
+            delete f;
+            current_file = restart_file_of_rank_[irk];
+            f = new H5Read( restart_paths_[current_file] );
+        }
+
+        ostringstream patch_name( "" );
+        patch_name << setfill( '0' ) << setw( 6 ) << hindex;
+        string patchName = Tools::merge( "patch-", patch_name.str() );
+        H5Read g = f->group( patchName );
+
+        restartPatch( vecPatches( ipatch ), params, g );
+
+        // Random number generator state
+        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+
+    }
+    delete f;
+
+    if (params.multiple_decomposition) {
+        H5Read f( restart_file );
+        ostringstream patch_name( "" );
+        patch_name << setfill( '0' ) << setw( 6 ) << region.patch_->Hindex();
+        string patchName = Tools::merge( "region-", patch_name.str() );
+        string process_name = processGroupName( smpi->getRank() );
+        if( f.has( process_name ) ) {
+            patchName = process_name + "/" + patchName;
+        }
+        H5Read g = f.group( patchName );
+        restartPatch( region.patch_, params, g );
+    }
+
+}
+
+
+void Checkpoint::restartProcess( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, int dumped_rank )
+{
+    H5Read f( restart_paths_[restart_file_of_rank_[dumped_rank]] );
+    // With subfiling, the data of each MPI process is in its own group
+    string process_name = processGroupName( dumped_rank );
+    if( f.has( process_name ) ) {
+        H5Read g = f.group( process_name );
+        restartProcessData( g, vecPatches, smpi, params, dumped_rank );
+    } else {
+        restartProcessData( f, vecPatches, smpi, params, dumped_rank );
+    }
+}
+
+
+void Checkpoint::restartProcessData( H5Read &f, VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, int dumped_rank )
+{
+    bool own = dumped_rank == smpi->getRank();
 
     // Write diags scalar data
     DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
     f.attr( "latest_timestep", scalars->latest_timestep );
     // Scalars only by master
-    if( smpi->isMaster() ) {
+    if( own && smpi->isMaster() ) {
         f.attr( "Energy_time_zero",  scalars->Energy_time_zero );
         f.attr( "EnergyUsedForNorm", scalars->EnergyUsedForNorm );
     }
-    // Poynting scalars
-    unsigned int k=0;
+    // Poynting scalars, summed over the dumped processes
     for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
         for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
             string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
-            if( f.hasAttr( poy_name ) ) {
-                f.attr( poy_name, vecPatches( 0 )->EMfields->poynting[j][i] );
+            if( dumped_rank % smpi->getSize() == smpi->getRank() && f.hasAttr( poy_name ) ) {
+                double poy_val = 0.;
+                f.attr( poy_name, poy_val );
+                vecPatches( 0 )->EMfields->poynting[j][i] += poy_val;
             }
-            k++;
         }
     }
 
+    if( ! own ) {
+        if( smpi->getRank() < ( int )restart_patch_count_.size() ) {
+            return;
+        }
+        // New particle IDs are given from a range that the dumped processes could not reach
+        for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
+            if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
+                ostringstream n( "" );
+                n<< "latest_ID_" << track->species_name_;
+                if( f.hasAttr( n.str() ) ) {
+                    track->latest_Id = smpi->getRank() * 4294967296; // 2^32
+                } else {
+                    track->IDs_done=false;
+                }
+            }
+        }
+        return;
+    }
+
     // Read the diags screen data
     if( smpi->isMaster() ) {
         unsigned int iscreen = 0;
@@ -659,29 +966,6 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         }
     }
 
-    // Read all the patch data
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
-
-        ostringstream patch_name( "" );
-        patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
-        string patchName = Tools::merge( "patch-", patch_name.str() );
-        H5Read g = f.group( patchName );
-
-        restartPatch( vecPatches( ipatch ), params, g );
-
-        // Random number generator state
-        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
-
-    }
-
-    if (params.multiple_decomposition) {
-        ostringstream patch_name( "" );
-        patch_name << setfill( '0' ) << setw( 6 ) << region.patch_->Hindex();
-        string patchName = Tools::merge( "region-", patch_name.str() );
-        H5Read g = f.group( patchName );
-        restartPatch( region.patch_, params, g );
-    }
-
     // Read the latest Id that the MPI processes have given to each species
     for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
@@ -694,16 +978,25 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
             }
         }
     }
-
 }
 
 
 void Checkpoint::readRegionDistribution( Region &region )
 {
+    if( restart_redistributed_ ) {
+        ERROR( "Restarting with a different number of MPI processes is not supported with MultipleDecomposition" );
+    }
+
     int read_hindex( -1 );
 
     hid_t file = H5Fopen(restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
-    hid_t grp = H5Gopen(file,"/",H5P_DEFAULT);
+    // With subfiling, the region is in the group of the MPI process
+    hid_t grp;
+    if( H5Lexists( file, restart_process_name_.c_str(), H5P_DEFAULT ) > 0 ) {
+        grp = H5Gopen(file,restart_process_name_.c_str(),H5P_DEFAULT);
+    } else {
+        grp = H5Gopen(file,"/",H5P_DEFAULT);
+    }
 
     hsize_t nobj;
     H5Gget_num_objs(grp, &nobj);
@@ -860,7 +1153,7 @@ void Checkpoint::restartPatch( Patch *patch, Params &params, H5Read &g )
         }
     }
 
-    // Fields required for DiagProbes with time integral
+    // Data required for DiagProbes with time integral or time reduction
     for( unsigned int iprobe=0; iprobe<patch->probes.size(); iprobe++ ) {
         ostringstream group_name( "" );
         group_name << "DataForProbes" << iprobe;
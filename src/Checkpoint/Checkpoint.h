@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -97,6 +98,17 @@ private:
 
     //! initialize the time zero of the simulation
     void initDumpCases();
+
+    //! dump the data common to the file, to the MPI process, to its patches and to its region
+    void dumpFileData( H5Write &f, unsigned int itime, SmileiMPI *smpi, SimWindow *simWin );
+    void dumpProcessData( H5Write &f, VectorPatch &vecPatches, SmileiMPI *smpi, Params &params );
+    void dumpPatches( H5Write &f, VectorPatch &vecPatches, Params &params );
+    void dumpRegion( H5Write &f, Region &region, Params &params );
+    //! restart the data of the MPI process dumped_rank of the previous run
+    void restartProcess( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, int dumped_rank );
+    void restartProcessData( H5Read &f, VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, int dumped_rank );
+    //! group of the data of an MPI process in a file shared by several processes (subfiling)
+    static std::string processGroupName( int rank );
     
     //! dump/restart field per proc
     void dumpFieldsPerProc( H5Write &g, Field *field );
@@ -132,6 +144,17 @@ private:
     
     //! restart file
     std::string restart_file;
+
+    //! files of the restart dump, by file index
+    std::map<int, std::string> restart_paths_;
+    //! patch count of the MPI processes of the restart dump
+    std::vector<int> restart_patch_count_;
+    //! file index of the MPI processes of the restart dump
+    std::vector<int> restart_file_of_rank_;
+    //! the restart dump has a different number of MPI processes
+    bool restart_redistributed_ = false;
+    //! group of the current MPI process in a subfiled restart dump
+    std::string restart_process_name_;
     
     //! dump PML in the checkpoint file 
     template <typename Tpml>
@@ -0,0 +1,69 @@
+#include "AsyncWriter.h"
+
+using namespace std;
+
+
+AsyncWriter::AsyncWriter( size_t max_bytes ) :
+    max_bytes_( max_bytes ),
+    pending_bytes_( 0 ),
+    pending_jobs_( 0 ),
+    stop_( false )
+{
+    thread_ = thread( &AsyncWriter::loop, this );
+}
+
+
+AsyncWriter::~AsyncWriter()
+{
+    {
+        unique_lock<mutex> lock( mutex_ );
+        stop_ = true;
+    }
+    queued_.notify_one();
+    thread_.join();
+}
+
+
+void AsyncWriter::enqueue( size_t bytes, function<void()> job )
+{
+    unique_lock<mutex> lock( mutex_ );
+    // A job larger than the maximum is accepted when nothing else is pending
+    completed_.wait( lock, [&] { return pending_jobs_ == 0 || pending_bytes_ + bytes <= max_bytes_; } );
+    queue_.push_back( make_pair( bytes, job ) );
+    pending_bytes_ += bytes;
+    pending_jobs_++;
+    lock.unlock();
+    queued_.notify_one();
+}
+
+
+void AsyncWriter::wait()
+{
+    unique_lock<mutex> lock( mutex_ );
+    completed_.wait( lock, [&] { return pending_jobs_ == 0; } );
+}
+
+
+void AsyncWriter::loop()
+{
+    unique_lock<mutex> lock( mutex_ );
+    while( true ) {
+        queued_.wait( lock, [&] { return stop_ || !queue_.empty(); } );
+        if( queue_.empty() ) {
+            // stop_ is only checked once all jobs are done
+            return;
+        }
+        pair<size_t, function<void()> > job = std::move( queue_.front() );
+        queue_.pop_front();
+
+        lock.unlock();
+        job.second();
+        // The staged data is released before the job is reported complete
+        job.second = nullptr;
+        lock.lock();
+
+        pending_bytes_ -= job.first;
+        pending_jobs_--;
+        completed_.notify_all();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef ASYNCWRITER_H
+#define ASYNCWRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class AsyncWriter
+//! Background thread executing, in order, the writes of the diagnostics output by the MPI master (scalars and
+//! particle binnings), so that the PIC loop does not wait for the file system
+//!     - each write is a job holding its own copy of the data to be written (staging buffer)
+//!     - the memory held by the pending jobs is bounded: enqueue() blocks until there is room for the new job
+//!     - wait() must be called before any other use of the HDF5 library on this MPI process, which is not
+//!       thread-safe in general
+//  --------------------------------------------------------------------------------------------------------------------
+class AsyncWriter
+{
+public:
+    //! \param max_bytes maximum memory held by the pending jobs
+    AsyncWriter( size_t max_bytes );
+    //! Completes all pending jobs
+    ~AsyncWriter();
+
+    //! Queue a job holding bytes of staged data
+    void enqueue( size_t bytes, std::function<void()> job );
+
+    //! Wait for the completion of all pending jobs
+    void wait();
+
+private:
+    void loop();
+
+    size_t max_bytes_;
+    //! Memory held by the queued and running jobs
+    size_t pending_bytes_;
+    //! Number of queued and running jobs
+    unsigned int pending_jobs_;
+    bool stop_;
+
+    std::deque<std::pair<size_t, std::function<void()> > > queue_;
+    std::mutex mutex_;
+    //! Signals a new job (or the end) to the thread
+    std::condition_variable queued_;
+    //! Signals the completion of a job
+    std::condition_variable completed_;
+    std::thread thread_;
+};
+
+#endif
@@ -1,23 +1,26 @@
 #ifndef DIAGNOSTIC_H
 #define DIAGNOSTIC_H
 
+#include <functional>
+
 #include "H5.h"
 #include "Patch.h"
 #include "Timers.h"
+#include "AsyncWriter.h"
 
 #include "OpenPMDparams.h"
+#include "TimeSelection.h"
 
 class SmileiMPI;
 class VectorPatch;
-class TimeSelection;
 
 class Diagnostic
 {
 
 public :
 
-    Diagnostic( ) : file_ ( NULL ), openPMD_( NULL ) {};
-    Diagnostic( OpenPMDparams *o, std::string diag_type, int idiag ) : file_ ( NULL ), openPMD_( o ) {
+    Diagnostic( ) : async_writer_( NULL ), file_ ( NULL ), openPMD_( NULL ) {};
+    Diagnostic( OpenPMDparams *o, std::string diag_type, int idiag ) : async_writer_( NULL ), file_ ( NULL ), openPMD_( o ) {
         PyTools::extract( "name", diag_name_, diag_type, idiag );
     };
     virtual ~Diagnostic() {
@@ -52,6 +55,12 @@ public :
         return false;
     };
     
+    //! Tells whether this diagnostic may read E and B at this iteration (see Main.temporal_blocking)
+    virtual bool readsFields( int itime )
+    {
+        return timeSelection->theTimeIsNow( itime );
+    };
+    
     //! Time selection for writing the diagnostic
     TimeSelection *timeSelection;
     
@@ -76,8 +85,22 @@ public :
         return diag_name_;
     };
     
+    //! Background writer of the output (MPI master of the global diags), NULL if written synchronously
+    AsyncWriter *async_writer_;
+    
 protected :
 
+    //! Runs the job writing the output, in the background if there is an async_writer_.
+    //! The job must own the data it writes (bytes) and use only members which do not change after init.
+    void submit( size_t bytes, std::function<void()> job )
+    {
+        if( async_writer_ ) {
+            async_writer_->enqueue( bytes, job );
+        } else {
+            job();
+        }
+    };
+
     //! File for one diagnostic
     H5Write * file_;
     
@@ -14,14 +14,19 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     
     filespace = NULL;
     memspace = NULL;
-    
-    // Extract the time_average parameter
-    time_average = 1;
-    PyTools::extract( "time_average", time_average, "DiagFields", ndiag );
-    if( time_average < 1 ) {
-        time_average = 1;
-    }
+    subfiling_ = NULL;
+    subfile_space_ = NULL;
+    
+    // Extract the time_average and time_reduction parameters
+    ostringstream diag_name( "" );
+    diag_name << "Diagnostic Fields #" << ndiag;
+    time_reduction_ = new TimeReduction( "DiagFields", ndiag, diag_name.str(), params.timestep );
+    time_average = time_reduction_->time_average;
     time_average_inv = 1./( ( double )time_average );
+    n_components_ = time_reduction_->size();
+    if( params.geometry == "AMcylindrical" && ! time_reduction_->isAverage() ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<": `time_reduction` must be \"average\" in AMcylindrical geometry" );
+    }
     
     // Define the filename
     ostringstream fn( "" );
@@ -145,19 +150,25 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     
     // Some output
     ostringstream p( "" );
-    p << "(time average = " << time_average << ")";
-    MESSAGE( 1, "Diagnostic Fields #"<<ndiag<<" "<<( time_average>1?p.str():"" )<<" :" );
+    if( time_reduction_->isAverage() ) {
+        p << "(time average = " << time_average << ")";
+    } else {
+        p << "(time " << time_reduction_->name() << " over " << time_average << " timesteps)";
+    }
+    MESSAGE( 1, "Diagnostic Fields #"<<ndiag<<" "<<( time_reduction_->accumulates()?p.str():"" )<<" :" );
     MESSAGE( 2, ss.str() );
     
-    // Create new fields in each patch, for time-average storage
+    // Create new fields in each patch, for the storage of the time reduction
     if( ! smpi->test_mode ) {
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
             vecPatches( ipatch )->EMfields->allFields_avg.resize( diag_n+1 );
-            if( time_average > 1 ) {
+            if( time_reduction_->accumulates() ) {
                 for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
-                    vecPatches( ipatch )->EMfields->allFields_avg[diag_n].push_back(
-                        vecPatches( ipatch )->EMfields->createField( fields_names[ifield], params )
-                    );
+                    for( unsigned int icomp=0; icomp<n_components_; icomp++ ) {
+                        vecPatches( ipatch )->EMfields->allFields_avg[diag_n].push_back(
+                            vecPatches( ipatch )->EMfields->createField( fields_names[ifield] + time_reduction_->suffix( icomp ), params )
+                        );
+                    }
                 }
             }
         }
@@ -218,6 +229,7 @@ DiagnosticFields::~DiagnosticFields()
     }
     delete timeSelection;
     delete flush_timeSelection;
+    delete time_reduction_;
 }
 
 void DiagnosticFields::openFile( Params &, SmileiMPI *smpi )
@@ -226,10 +238,16 @@ void DiagnosticFields::openFile( Params &, SmileiMPI *smpi )
         return;
     }
     
-    // Create file
-    file_ = new H5Write( filename, &smpi->world() );
+    // Create file (or the subfile of this MPI process)
+    if( smpi->hasSubfiles() ) {
+        subfiling_ = new H5Subfiling( filename, smpi->world(), smpi->subfileComm(), smpi->subfileIndex() );
+        file_ = new H5Write( subfiling_->subfileName(), &smpi->subfileComm() );
+    } else {
+        file_ = new H5Write( filename, &smpi->world() );
+    }
     
     file_->attr( "name", diag_name_ );
+    time_reduction_->writeAttributes( file_ );
     
     // Attributes for openPMD
     openPMD_->writeRootAttributes( *file_, "", "no_particles" );
@@ -238,6 +256,10 @@ void DiagnosticFields::openFile( Params &, SmileiMPI *smpi )
     data_group_ = new H5Write( file_, "data" );
     
     file_->flush();
+    
+    if( subfiling_ ) {
+        subfiling_->mirror( file_, "/" );
+    }
 }
 
 void DiagnosticFields::closeFile()
@@ -250,6 +272,10 @@ void DiagnosticFields::closeFile()
         delete file_;
         file_ = NULL;
     }
+    if( subfiling_ ) {
+        delete subfiling_;
+        subfiling_ = NULL;
+    }
 }
 
 
@@ -274,14 +300,15 @@ bool DiagnosticFields::prepare( int itime )
 
 void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers & )
 {
-    // If time-averaging, increment the average
-    if( time_average>1 ) {
+    // If time-reducing, accumulate
+    if( time_reduction_->accumulates() ) {
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
             for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
-                vecPatches( ipatch )->EMfields->incrementAvgField(
-                    vecPatches( ipatch )->EMfields->allFields[fields_indexes[ifield]], // instantaneous field
-                    vecPatches( ipatch )->EMfields->allFields_avg[diag_n][ifield]    // averaged field
+                time_reduction_->accumulate(
+                    itime,
+                    vecPatches( ipatch )->EMfields->allFields[fields_indexes[ifield]],         // instantaneous field
+                    &vecPatches( ipatch )->EMfields->allFields_avg[diag_n][ifield*n_components_] // accumulated fields
                 );
             }
         }
@@ -308,6 +335,10 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             openPMD_->writeBasePathAttributes( *iteration_group_, itime );
             // Add openPMD attributes ( "meshesPath" )
             openPMD_->writeMeshesAttributes( *iteration_group_ );
+            // Place the selection in the subfile
+            if( subfiling_ ) {
+                subfile_space_ = subfiling_->select( filespace );
+            }
         }
     }
     #pragma omp barrier
@@ -319,20 +350,21 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     unsigned int nPatches( vecPatches.size() );
     
-    // For each field, combine all patches and write out
-    for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
-    
+    // For each field (and each component of its reduction), combine all patches and write out
+    for( unsigned int ioutput=0; ioutput < fields_indexes.size()*n_components_; ioutput++ ) {
+        unsigned int ifield = ioutput / n_components_;
+        
         // Copy the patch field to the buffer
         #pragma omp barrier
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-            getField( vecPatches( ipatch ), ifield );
+            getField( vecPatches( ipatch ), ioutput );
         }
         
         #pragma omp master
         {
             // Write
-            H5Write dset = writeField( iteration_group_, fields_names[ifield] );
+            H5Write dset = writeField( iteration_group_, fields_names[ifield] + time_reduction_->suffix( ioutput % n_components_ ), subfiling_ ? subfile_space_ : filespace );
             // Attributes for openPMD
             Field *f = vecPatches( 0 )->EMfields->allFields[fields_indexes[ifield]];
             vector<double> stagger( f->dims().size() );
@@ -356,8 +388,19 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         double x_moved = simWindow ? simWindow->getXmoved() : 0.;
         iteration_group_->attr( "x_moved", x_moved );
         delete iteration_group_;
+        if( subfiling_ ) {
+            delete subfile_space_;
+            subfile_space_ = NULL;
+            // Map this iteration of all subfiles in the master file
+            ostringstream name_t;
+            name_t << "/data/" << setfill( '0' ) << setw( 10 ) << itime;
+            subfiling_->mirror( file_, name_t.str() );
+        }
         if( flush_timeSelection->theTimeIsNow( itime ) ) {
             file_->flush();
+            if( subfiling_ ) {
+                subfiling_->flush();
+            }
         }
     }
     #pragma omp barrier
@@ -373,7 +416,7 @@ bool DiagnosticFields::needsRhoJs( int itime )
 uint64_t DiagnosticFields::getDiskFootPrint( int istart, int istop, Patch * )
 {
     uint64_t footprint = 0;
-    uint64_t nfields = fields_indexes.size();
+    uint64_t nfields = fields_indexes.size() * n_components_;
     
     // Calculate the number of dumps between istart and istop
     uint64_t ndumps = timeSelection->howManyTimesBefore( istop ) - timeSelection->howManyTimesBefore( istart );
@@ -2,6 +2,8 @@
 #define DIAGNOSTICFIELDS_H
 
 #include "Diagnostic.h"
+#include "TimeReduction.h"
+#include "H5Subfiling.h"
 
 class DiagnosticFields  : public Diagnostic
 {
@@ -23,10 +25,17 @@ public :
     
     virtual void run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers ) override;
     
-    virtual H5Write writeField( H5Write*, std::string ) = 0;
+    //! Write the current buffer in the selection file_space of a new dataset
+    virtual H5Write writeField( H5Write*, std::string, H5Space *file_space ) = 0;
     
     virtual bool needsRhoJs( int itime ) override;
     
+    //! The fields are read at all the iterations of the time reduction
+    virtual bool readsFields( int itime ) override
+    {
+        return prepare( itime );
+    };
+    
     void findSubgridIntersection( unsigned int subgrid_start,
                                   unsigned int subgrid_stop,
                                   unsigned int subgrid_step,
@@ -65,6 +74,12 @@ protected :
     //! Inverse of the time average
     double time_average_inv;
     
+    //! Reduction over the time_average timesteps
+    TimeReduction *time_reduction_;
+    
+    //! Number of outputs per field (several for the Fourier transform)
+    unsigned int n_components_;
+    
     //! Subgrid requested
     std::vector<unsigned int> subgrid_start_, subgrid_stop_, subgrid_step_;
     
@@ -81,6 +96,11 @@ protected :
     H5Write *data_group_, *iteration_group_;
     H5Space *filespace, *memspace;
     
+    //! Subfiles of the output (NULL if a single file is shared by all MPI processes)
+    H5Subfiling *subfiling_;
+    //! Selection of filespace in the subfile
+    H5Space *subfile_space_;
+    
     //! Total number of patches
     int tot_number_of_patches;
     
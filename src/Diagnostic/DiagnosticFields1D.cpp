@@ -74,7 +74,7 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
 {
     // Get current field
     Field1D *field;
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field = static_cast<Field1D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
     } else {
         field = static_cast<Field1D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
@@ -101,20 +101,20 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
     
     // Copy this patch field into buffer
     while( ix < ix_max ) {
-        data[iout] = ( *field )( ix ) * time_average_inv;
+        data[iout] = time_reduction_->value( ( *field )( ix ) );
         ix += subgrid_step_[0];
         iout++;
     }
     
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field->put_to( 0.0 );
     }
 }
 
 
 // Write current buffer to file
-H5Write DiagnosticFields1D::writeField( H5Write * loc, std::string name )
+H5Write DiagnosticFields1D::writeField( H5Write * loc, std::string name, H5Space *file_space )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], file_space, memspace, false, file_datatype_ );
 }
 
@@ -147,7 +147,7 @@ void DiagnosticFields2D::getField( Patch *patch, unsigned int ifield )
 {
     // Get current field
     Field2D *field;
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field = static_cast<Field2D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
     } else {
         field = static_cast<Field2D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
@@ -169,21 +169,21 @@ void DiagnosticFields2D::getField( Patch *patch, unsigned int ifield )
     unsigned int step_out = buffer_skip_x[patch->Hindex()-refHindex];
     for( unsigned int ix = start_in_patch[0]; ix < ix_max; ix += subgrid_step_[0] ) {
         for( unsigned int iy = start_in_patch[1]; iy < iy_max; iy += subgrid_step_[1] ) {
-            data[iout] = ( *field )( ix, iy ) * time_average_inv;
+            data[iout] = time_reduction_->value( ( *field )( ix, iy ) );
             iout++;
         }
         iout += step_out;
     }
     
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field->put_to( 0.0 );
     }
 }
 
 
 // Write current buffer to file
-H5Write DiagnosticFields2D::writeField( H5Write * loc, std::string name )
+H5Write DiagnosticFields2D::writeField( H5Write * loc, std::string name, H5Space *file_space )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], file_space, memspace, false, file_datatype_ );
 }
 
@@ -176,7 +176,7 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
 {
     // Get current field
     Field3D *field;
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field = static_cast<Field3D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
     } else {
         field = static_cast<Field3D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
@@ -201,7 +201,7 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
     for( unsigned int ix = start_in_patch[0]; ix < ix_max; ix += subgrid_step_[0] ) {
         for( unsigned int iy = start_in_patch[1]; iy < iy_max; iy += subgrid_step_[1] ) {
             for( unsigned int iz = start_in_patch[2]; iz < iz_max; iz += subgrid_step_[2] ) {
-                data[iout] = ( *field )( ix, iy, iz ) * time_average_inv;
+                data[iout] = time_reduction_->value( ( *field )( ix, iy, iz ) );
                 iout++;
             }
             iout += stepy_out;
@@ -209,15 +209,15 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
         iout += stepx_out;
     }
     
-    if( time_average>1 ) {
+    if( time_reduction_->accumulates() ) {
         field->put_to( 0.0 );
     }
 }
 
 
 // Write current buffer to file
-H5Write DiagnosticFields3D::writeField( H5Write * loc, string name )
+H5Write DiagnosticFields3D::writeField( H5Write * loc, string name, H5Space *file_space )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], file_space, memspace, false, file_datatype_ );
 }
 
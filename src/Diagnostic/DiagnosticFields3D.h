@@ -19,7 +19,7 @@ public:
     //! Copy patch field to current "data" buffer
     void getField( Patch *patch, unsigned int ) override;
     
-    H5Write writeField( H5Write*, std::string ) override;
+    H5Write writeField( H5Write*, std::string, H5Space *file_space ) override;
     
 private:
 
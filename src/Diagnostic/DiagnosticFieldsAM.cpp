@@ -223,20 +223,20 @@ void DiagnosticFieldsAM::getField( Patch *patch, unsigned int ifield, F& out_dat
 }
 
 // Write current buffer to file
-H5Write DiagnosticFieldsAM::writeField( H5Write * loc, string name )
+H5Write DiagnosticFieldsAM::writeField( H5Write * loc, string name, H5Space *file_space )
 {
     if( is_complex_ ) {
-        return writeField< std::vector< std::complex<double> > >( loc, name, idata );
+        return writeField< std::vector< std::complex<double> > >( loc, name, file_space, idata );
     } else {
-        return writeField< std::vector< double > >( loc, name, data );
+        return writeField< std::vector< double > >( loc, name, file_space, data );
     }
 }
 
 // Write current buffer to file
 template<typename F>
-H5Write DiagnosticFieldsAM::writeField( H5Write *loc, string name, F& linearized_data )
+H5Write DiagnosticFieldsAM::writeField( H5Write *loc, string name, H5Space *file_space, F& linearized_data )
 {
     // Rewrite the file with the previously defined partition
-    return loc->array( name, linearized_data[0], H5T_NATIVE_DOUBLE, filespace, memspace, false, file_datatype_ );
+    return loc->array( name, linearized_data[0], H5T_NATIVE_DOUBLE, file_space, memspace, false, file_datatype_ );
 }
 
@@ -20,8 +20,8 @@ public:
     void getField( Patch *patch, unsigned int ) override;
     template<typename T, typename F>  void getField( Patch *patch, unsigned int, F& out_data );
     
-    H5Write writeField( H5Write*, std::string ) override;
-    template<typename F> H5Write writeField( H5Write*, std::string, F& linearized_data );
+    H5Write writeField( H5Write*, std::string, H5Space *file_space ) override;
+    template<typename F> H5Write writeField( H5Write*, std::string, H5Space *file_space, F& linearized_data );
 
 private:
     std::vector<unsigned int> buffer_skip_x, buffer_skip_y;
@@ -1,5 +1,6 @@
 #include "PyTools.h"
 #include <iomanip>
+#include <memory>
 
 #include "DiagnosticParticleBinningBase.h"
 #include "HistogramFactory.h"
@@ -351,31 +352,46 @@ void DiagnosticParticleBinningBase::write( int itime, SmileiMPI *smpi )
     mystream << "timestep" << setw( 8 ) << setfill( '0' ) << itime;
     string dataname = mystream.str();
     
-    // write the array if it does not exist already
-    if( ! file_->has( dataname ) ) {
-        H5Space d( dims );
-        H5Write dataset = file_->array( dataname, data_sum[0], &d, &d );
-        
-        // When auto limits, write the limits
-        for( unsigned int iaxis=0 ; iaxis < histogram->axes.size() ; iaxis++ ) {
-            HistogramAxis * ax = histogram->axes[iaxis];
-            if( std::isnan(ax->min) ) {
-                dataset.attr( "min"+to_string(iaxis), ax->global_min );
-            }
-            if( std::isnan(ax->max) ) {
-                dataset.attr( "max"+to_string(iaxis), ax->global_max );
-            }
-        }
+    // Stage the data, so that the accumulation can restart while it is written
+    shared_ptr<vector<double> > data( new vector<double>() );
+    if( ! time_accumulate ) {
+        data->swap( data_sum );
+    } else {
+        *data = data_sum;
     }
     
-    if( flush_timeSelection->theTimeIsNow( itime ) ) {
-        file_->flush();
+    // When auto limits, the limits are written as attributes
+    vector<pair<string, double> > limits;
+    for( unsigned int iaxis=0 ; iaxis < histogram->axes.size() ; iaxis++ ) {
+        HistogramAxis * ax = histogram->axes[iaxis];
+        if( std::isnan(ax->min) ) {
+            limits.push_back( make_pair( "min"+to_string(iaxis), ax->global_min ) );
+        }
+        if( std::isnan(ax->max) ) {
+            limits.push_back( make_pair( "max"+to_string(iaxis), ax->global_max ) );
+        }
     }
     
+    bool flush = flush_timeSelection->theTimeIsNow( itime );
+    vector<hsize_t> data_dims = dims;
+    H5Write *file = file_;
+    submit( data->size() * sizeof( double ), [=]() {
+        // write the array if it does not exist already
+        if( ! file->has( dataname ) ) {
+            H5Space d( data_dims );
+            H5Write dataset = file->array( dataname, ( *data )[0], &d, &d );
+            for( unsigned int i=0; i<limits.size(); i++ ) {
+                dataset.attr( limits[i].first, limits[i].second );
+            }
+        }
+        if( flush ) {
+            file->flush();
+        }
+    } );
+    
     if( ! time_accumulate ) {
         // Clear the array
         clear();
-        data_sum.resize( 0 );
     }
 } // END write
 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 
 #include "ParticleData.h"
 #include "PeekAtSpecies.h"
@@ -216,18 +217,30 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
             }
         }
         
-        // Specify the memory dataspace (the size of the local buffer)
-        mem_space = new H5Space( (hsize_t)nParticles_local );
+        // Number of particles written by this MPI rank, once reordered
+        uint32_t nParticles_written = prepareReordering( vecPatches, smpi );
+        
+        // Specify the memory dataspace (the size of the written buffer)
+        mem_space = new H5Space( (hsize_t)nParticles_written );
         
         // Get the number of offset for this MPI rank
-        uint64_t np_local = nParticles_local, offset;
+        uint64_t np_local = nParticles_written, offset;
         MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
         nParticles_global = offset;
         offset -= np_local;
         MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, smpi->getSize()-1, MPI_COMM_WORLD );
         
         // Prepare all HDF5 groups and datasets
-        file_space = prepareH5( simWindow, smpi, itime, nParticles_local, nParticles_global, offset );
+        file_space = prepareH5( simWindow, smpi, itime, nParticles_written, nParticles_global, offset );
+        
+        // Place the range of this MPI rank in the subfile
+        if( subfiling_ ) {
+            uint64_t subfile_size = nParticles_global, subfile_offset = offset;
+            subfiling_->selectRange( subfile_size, subfile_offset, nParticles_written );
+            hsize_t chunk = file_space->chunk_.empty() ? 0 : min( ( uint64_t )file_space->chunk_[0], subfile_size );
+            delete file_space;
+            file_space = new H5Space( subfile_size, subfile_offset, nParticles_written, chunk );
+        }
     }
     
     // Id
@@ -444,6 +457,9 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
         
         if( flush_timeSelection->theTimeIsNow( itime ) ) {
             file_->flush();
+            if( subfiling_ ) {
+                subfiling_->flush();
+            }
         }
     }
     #pragma omp barrier
@@ -3,6 +3,7 @@
 
 #include "VectorPatch.h"
 #include "Diagnostic.h"
+#include "H5Subfiling.h"
 
 class Patch;
 class Params;
@@ -40,6 +41,13 @@ public :
     //! Returns the Particles object of interest in a given patch
     virtual Particles * getParticles( Patch * patch ) = 0;
     
+    //! Prepare the reordering of the particles across MPI ranks before writing
+    //! \return the number of particles written by this MPI rank
+    virtual uint32_t prepareReordering( VectorPatch &, SmileiMPI * )
+    {
+        return nParticles_local;
+    };
+    
     //! Prepare all HDF5 groups, datasets and spaces
     virtual H5Space * prepareH5( SimWindow *simWindow, SmileiMPI *smpi, int itime, uint32_t nParticles_local, uint64_t nParticles_global, uint64_t offset ) = 0;
     
@@ -145,6 +153,9 @@ protected:
     bool write_any_W_;
     
     H5Write* loc_birth_time_ = nullptr;
+    
+    //! Subfiles of the output (NULL if a single file is shared by all MPI processes)
+    H5Subfiling *subfiling_ = nullptr;
 };
 
 #endif
@@ -1,5 +1,6 @@
 
 
+#include <algorithm>
 #include <sstream>
 #include <vector>
 #include <limits>
@@ -362,6 +363,25 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
         ERROR( "Probe #"<<n_probe<<": `time_integral` incompatible with the moving window" );
     }
     
+    // Extract time_average and time_reduction
+    ostringstream probe_name( "" );
+    probe_name << "Probe #" << n_probe;
+    time_reduction_ = new TimeReduction( "DiagProbe", n_probe, probe_name.str(), params.timestep );
+    if( time_reduction_->accumulates() ) {
+        if( time_integral ) {
+            ERROR( "Probe #"<<n_probe<<": `time_integral` incompatible with `time_average` and `time_reduction`" );
+        }
+        if( params.hasWindow ) {
+            ERROR( "Probe #"<<n_probe<<": `time_average` and `time_reduction` incompatible with the moving window" );
+        }
+        if( timeSelection->smallestInterval() < time_reduction_->time_average ) {
+            ERROR( "Probe #"<<n_probe<<" has a time average too large compared to its time-selection interval ('every')" );
+        }
+        if( params.has_load_balancing ) {
+            WARNING( "Probe #"<<n_probe<<": the time reduction restarts in the patches moved by the load balancing" );
+        }
+    }
+    
     // Extract the datatype
     string datatype = "";
     PyTools::extract( "datatype", datatype, "DiagProbe", n_probe );
@@ -390,7 +410,13 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
     }
     
     // Display info
-    MESSAGE( 1, "Probe diagnostic #"<<n_probe<< (time_integral?" (integrated over time)":"") );
+    ostringstream reduction( "" );
+    if( time_integral ) {
+        reduction << " (integrated over time)";
+    } else if( time_reduction_->accumulates() ) {
+        reduction << " (time " << time_reduction_->name() << " over " << time_reduction_->time_average << " timesteps)";
+    }
+    MESSAGE( 1, "Probe diagnostic #"<<n_probe<<reduction.str() );
     
     ostringstream t( "" );
     t << vecNumber[0];
@@ -427,6 +453,7 @@ DiagnosticProbes::~DiagnosticProbes()
 {
     delete timeSelection;
     delete flush_timeSelection;
+    delete time_reduction_;
 }
 
 
@@ -438,6 +465,7 @@ void DiagnosticProbes::openFile( Params &, SmileiMPI *smpi )
     file_->attr( "Version", string( __VERSION ) );
     file_->attr( "dimension", dimProbe );
     file_->attr( "time_integral", time_integral );
+    time_reduction_->writeAttributes( file_ );
     
     // Add arrays "p0", "p1", ...
     file_->vect( "p0", origin );
@@ -453,9 +481,10 @@ void DiagnosticProbes::openFile( Params &, SmileiMPI *smpi )
     
     // Add "fields"
     ostringstream fields( "" );
-    fields << fieldname[0];
-    for( unsigned int i=1; i<fieldname.size(); i++ ) {
-        fields << "," << fieldname[i];
+    for( unsigned int i=0; i<fieldname.size(); i++ ) {
+        for( unsigned int icomp=0; icomp<time_reduction_->size(); icomp++ ) {
+            fields << ( i+icomp>0 ? "," : "" ) << fieldname[i] << time_reduction_->suffix( icomp );
+        }
     }
     file_->attr( "fields", fields.str() );
     
@@ -473,7 +502,7 @@ void DiagnosticProbes::closeFile()
 
 bool DiagnosticProbes::prepare( int itime )
 {
-    return time_integral || timeSelection->theTimeIsNow( itime );
+    return time_integral || itime - timeSelection->previousTime( itime ) < time_reduction_->time_average;
 } 
 
 
@@ -623,6 +652,10 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
         // Resize the array with only particles in this patch
         particles->resize( ipart_local, nDim_particle, false );
         particles->shrinkToFit();
+        
+        // The points do not move with the patch: their interpolation stencils are computed once
+        ProbeParticles *probe = vecPatches( ipatch )->probes[probe_n];
+        probe->has_stencils = vecPatches( ipatch )->probesInterp->stencils( *particles, probe->stencils );
 
         // Add the local offset
         offset_in_MPI[ipatch] = nPart_MPI;
@@ -664,6 +697,7 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         name_t << "/" << setfill( '0' ) << setw( 10 ) << itime;
         dataset_name = name_t.str();
         has_dataset = file_->has( dataset_name );
+        output_now = itime - timeSelection->previousTime( itime ) == time_reduction_->time_average-1;
     }
     #pragma omp barrier
     if( has_dataset ) {
@@ -718,7 +752,7 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         // Make the array that will contain the data
         vector<unsigned int> probesArraySize( 2 );
         probesArraySize[1] = nPart_MPI; // number of particles
-        probesArraySize[0] = nBuffers;
+        probesArraySize[0] = max( nBuffers, nFields*time_reduction_->size() ); // the time reduction may have more outputs
         probesArray = new Field2D( probesArraySize );
     }
     #pragma omp barrier
@@ -748,35 +782,56 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         smpi->resizeBuffers( ithread, nDim_particle, npart, false );
 #endif
 
-        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-            int iparticle( ipart ); // Compatibility
-            int false_idx( 0 );   // Use in classical interp for now, not for probes
-            patch->probesInterp->fieldsAndCurrents(
-                patch->EMfields,
-                patch->probes[probe_n]->particles, smpi,
-                &iparticle, &false_idx, ithread,
-                &Jloc_fields, &Rloc_fields
-            );
-            //! here we fill the probe data!!!
-            ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
-            if (smpi->use_BTIS3){
-                if (fieldlocation[17] < nFields){
-                    ( *probesArray )( fieldlocation[17], iPart_MPI )=smpi->dynamics_Bpart_yBTIS3[ithread][ipart+0*npart];
+        if( patch->probes[probe_n]->has_stencils ) {
+            // Interpolate each field on all points with the stored stencils
+            InterpolationStencils &stencils = patch->probes[probe_n]->stencils;
+            ElectroMagn *EM = patch->EMfields;
+            Field *fields[10] = { EM->Ex_, EM->Ey_, EM->Ez_, EM->Bx_m, EM->By_m, EM->Bz_m, EM->Jx_, EM->Jy_, EM->Jz_, EM->rho_ };
+            for( unsigned int k=0; k<10; k++ ) {
+                // Fields neither requested nor needed by the Poynting flux go to the garbage buffer
+                if( fieldlocation[k] != nFields ) {
+                    stencils.gather( fields[k], &( ( *probesArray )( fieldlocation[k], offset_in_MPI[ipatch] ) ) );
+                }
+            }
+            if( smpi->use_BTIS3 ) {
+                if( fieldlocation[17] < nFields ) {
+                    stencils.gather( EM->By_mBTIS3, &( ( *probesArray )( fieldlocation[17], offset_in_MPI[ipatch] ) ) );
                 }
-                if (fieldlocation[18] < nFields){
-                    ( *probesArray )( fieldlocation[18], iPart_MPI )=smpi->dynamics_Bpart_zBTIS3[ithread][ipart+0*npart];
+                if( fieldlocation[18] < nFields ) {
+                    stencils.gather( EM->Bz_mBTIS3, &( ( *probesArray )( fieldlocation[18], offset_in_MPI[ipatch] ) ) );
+                }
+            }
+        } else {
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                int iparticle( ipart ); // Compatibility
+                int false_idx( 0 );   // Use in classical interp for now, not for probes
+                patch->probesInterp->fieldsAndCurrents(
+                    patch->EMfields,
+                    patch->probes[probe_n]->particles, smpi,
+                    &iparticle, &false_idx, ithread,
+                    &Jloc_fields, &Rloc_fields
+                );
+                //! here we fill the probe data!!!
+                ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
+                if (smpi->use_BTIS3){
+                    if (fieldlocation[17] < nFields){
+                        ( *probesArray )( fieldlocation[17], iPart_MPI )=smpi->dynamics_Bpart_yBTIS3[ithread][ipart+0*npart];
+                    }
+                    if (fieldlocation[18] < nFields){
+                        ( *probesArray )( fieldlocation[18], iPart_MPI )=smpi->dynamics_Bpart_zBTIS3[ithread][ipart+0*npart];
+                    }
                 }
+                ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
+                ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
+                ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
+                ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
+                iPart_MPI++;
             }
-            ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
-            ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
-            ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
-            ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
-            iPart_MPI++;
         }
         
         // Calculate Poynting flux on each point if needed
@@ -833,6 +888,10 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                     unsigned int iloc = species_field_location[ispec][j];
                     int istart( 0 ), iend( npart );
                     double *FieldLoc = &( ( *probesArray )( iloc, offset_in_MPI[ipatch] ) );
+                    if( patch->probes[probe_n]->has_stencils ) {
+                        patch->probes[probe_n]->stencils.gather( patch->EMfields->allFields[start+ifield], FieldLoc );
+                        continue;
+                    }
                     patch->probesInterp->oneField(
                         &patch->EMfields->allFields[start+ifield],
                         patch->probes[probe_n]->particles,
@@ -879,31 +938,57 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             }
         }
         
+        // Accumulate the time reduction, and replace the data by the reduced one at the output
+        if( time_reduction_->accumulates() ) {
+            unsigned int ncomp = time_reduction_->size();
+            vector<vector<double> > &acc = patch->probes[probe_n]->integrated_data;
+            acc.resize( nFields*ncomp );
+            vector<double *> acc_ptr( ncomp );
+            for( unsigned int i = 0; i < nFields; i++ ) {
+                for( unsigned int icomp = 0; icomp < ncomp; icomp++ ) {
+                    acc[i*ncomp+icomp].resize( npart, 0. );
+                    acc_ptr[icomp] = acc[i*ncomp+icomp].data();
+                }
+                time_reduction_->accumulate( itime, &( ( *probesArray )( i, offset_in_MPI[ipatch] ) ), &acc_ptr[0], npart );
+            }
+            if( output_now ) {
+                for( unsigned int i = 0; i < nFields*ncomp; i++ ) {
+                    unsigned int iPart_MPI = offset_in_MPI[ipatch];
+                    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                        ( *probesArray )( i, iPart_MPI ) = time_reduction_->value( acc[i][ipart] );
+                        acc[i][ipart] = 0.;
+                        iPart_MPI++;
+                    }
+                }
+            }
+        }
+        
     } // END for ipatch
     
     #pragma omp master
     {
-        if( timeSelection->theTimeIsNow( itime ) ) {
+        if( output_now ) {
             // Define spaces
-            H5Space memspace( {(hsize_t)nFields, nPart_MPI}, {}, {} );
-            H5Space filespace( {(hsize_t)nFields, nPart_total_actual}, {0, offset_in_file[0]}, {(hsize_t)nFields, nPart_MPI} );
+            hsize_t nOutputs = nFields*time_reduction_->size();
+            H5Space memspace( {nOutputs, nPart_MPI}, {}, {} );
+            H5Space filespace( {nOutputs, nPart_total_actual}, {0, offset_in_file[0]}, {nOutputs, nPart_MPI} );
             // Create new dataset for this timestep
             H5Write d = file_->array( dataset_name, *(probesArray->data_), &filespace, &memspace, true, file_datatype_ );
             // Write x_moved
             d.attr( "x_moved", x_moved );
             
-            delete probesArray;
             if( flush_timeSelection->theTimeIsNow( itime ) ) {
                 file_->flush();
             }
         }
+        delete probesArray;
     }
     #pragma omp barrier
 }
 
 bool DiagnosticProbes::needsRhoJs( int itime )
 {
-    return hasRhoJs && timeSelection->theTimeIsNow( itime );
+    return hasRhoJs && itime - timeSelection->previousTime( itime ) < time_reduction_->time_average;
 }
 
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
@@ -924,10 +1009,11 @@ uint64_t DiagnosticProbes::getDiskFootPrint( int istart, int istop, Patch * )
     }
 
     // Add local headers
-    footprint += ndumps * ( uint64_t )( 480 + nFields * 6 );
+    uint64_t nOutputs = nFields * time_reduction_->size();
+    footprint += ndumps * ( uint64_t )( 480 + nOutputs * 6 );
 
     // Add size of each field
-    footprint += ndumps * ( uint64_t )( nFields * nPart_total ) * (file_datatype_==H5T_NATIVE_DOUBLE?8:4);
+    footprint += ndumps * ( uint64_t )( nOutputs * nPart_total ) * (file_datatype_==H5T_NATIVE_DOUBLE?8:4);
 
     return footprint;
 }
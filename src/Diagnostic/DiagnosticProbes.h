@@ -2,8 +2,10 @@
 #define DIAGNOSTICPROBES_H
 
 #include "Diagnostic.h"
+#include "TimeReduction.h"
 
 #include "Field2D.h"
+#include "Interpolator.h"
 
 
 class DiagnosticProbes : public Diagnostic
@@ -30,6 +32,12 @@ public :
     
     virtual bool needsRhoJs( int itime ) override;
     
+    //! The fields are read at all the iterations of the time reduction
+    virtual bool readsFields( int itime ) override
+    {
+        return prepare( itime );
+    };
+    
     //! Creates the probe's particles (or "points")
     void createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, double x_moved );
     
@@ -54,6 +62,9 @@ protected:
     //! Array to accumulate the data for the time_integral
     Field2D *probesArrayIntegral;
     
+    //! Reduction of the data over the time_average timesteps preceding each output
+    TimeReduction *time_reduction_;
+    
 private:
     //! Index of the probe diagnostic
     int probe_n;
@@ -114,6 +125,9 @@ private:
     bool has_dataset;
     std::string dataset_name;
     
+    //! Whether the data of the current timestep is written
+    bool output_now;
+    
     //! Temporary buffer to write probes
     Field2D *probesArray;
     
@@ -153,7 +167,11 @@ public :
     
     Particles particles;
     int offset_in_file;
+    //! Data accumulated for the time_integral or the time reduction, for each output and each point
     std::vector<std::vector<double> > integrated_data;
+    //! Interpolation stencils of the points, computed with the points (when available for the interpolator)
+    InterpolationStencils stencils;
+    bool has_stencils = false;
 };
 
 
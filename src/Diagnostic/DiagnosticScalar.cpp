@@ -28,6 +28,12 @@ DiagnosticScalar::DiagnosticScalar( Params &params, SmileiMPI *, Patch * = NULL
             "Scalars"
         );
         
+        // get parameter "flush_every" (time selection for flushing the file)
+        flush_timeSelection = new TimeSelection(
+            PyTools::extract_py( "flush_every", "DiagScalar", 0 ),
+            "DiagScalar flush_every"
+        );
+        
         precision = 10;
         PyTools::extract( "precision", precision, "DiagScalar"  );
         PyTools::extractV( "vars", vars, "DiagScalar" );
@@ -42,6 +48,7 @@ DiagnosticScalar::DiagnosticScalar( Params &params, SmileiMPI *, Patch * = NULL
         filename = "scalars.txt";
     } else {
         timeSelection = new TimeSelection();
+        flush_timeSelection = new TimeSelection();
         filename = "";
     }
     
@@ -54,6 +61,7 @@ DiagnosticScalar::~DiagnosticScalar()
         delete allScalars[i];
     }
     delete timeSelection;
+    delete flush_timeSelection;
 } // END DiagnosticScalar::#DiagnosticScalar
 
 
@@ -354,45 +362,58 @@ void DiagnosticScalar::write( int itime, SmileiMPI *smpi )
         
             unsigned int j, k, s = allScalars.size();
             
-            fout << std::scientific << setprecision( precision );
+            // The text is formatted here and written by submit(), possibly in the background
+            ostringstream header( "" ), line( "" );
+            header << std::scientific << setprecision( precision );
+            line << std::scientific << setprecision( precision );
             // At the beginning of the file, we write some headers
-            if( fout.tellp()==ifstream::pos_type( 0 ) ) { // file beginning
-                // First header: list of scalars, one by line
-                fout << "# " << 1 << " time" << endl;
-                j = 2;
-                for( k=0; k<s; k++ ) {
-                    if( allScalars[k]->allowed_ ) {
-                        fout << "# " << j << " " << allScalars[k]->name_ << endl;
+            // First header: list of scalars, one by line
+            header << "# " << 1 << " time" << endl;
+            j = 2;
+            for( k=0; k<s; k++ ) {
+                if( allScalars[k]->allowed_ ) {
+                    header << "# " << j << " " << allScalars[k]->name_ << endl;
+                    j++;
+                    if( ! allScalars[k]->secondname_.empty() ) {
+                        header << "# " << j << " " << allScalars[k]->secondname_ << endl;
                         j++;
-                        if( ! allScalars[k]->secondname_.empty() ) {
-                            fout << "# " << j << " " << allScalars[k]->secondname_ << endl;
-                            j++;
-                        }
                     }
                 }
-                // Second header: list of scalars, but all in one line
-                fout << "#\n#" << setw( precision+9 ) << "time";
-                for( k=0; k<s; k++ ) {
-                    if( allScalars[k]->allowed_ ) {
-                        fout << setw( allScalars[k]->width_ ) << allScalars[k]->name_;
-                        if( ! allScalars[k]->secondname_.empty() ) {
-                            fout << setw( allScalars[k]->width_ ) << allScalars[k]->secondname_;
-                        }
+            }
+            // Second header: list of scalars, but all in one line
+            header << "#\n#" << setw( precision+9 ) << "time";
+            for( k=0; k<s; k++ ) {
+                if( allScalars[k]->allowed_ ) {
+                    header << setw( allScalars[k]->width_ ) << allScalars[k]->name_;
+                    if( ! allScalars[k]->secondname_.empty() ) {
+                        header << setw( allScalars[k]->width_ ) << allScalars[k]->secondname_;
                     }
                 }
-                fout << endl;
             }
+            header << endl;
             // Each requested timestep, the following writes the values of the scalars
-            fout << setw( precision+10 ) << itime/res_time;
+            line << setw( precision+10 ) << itime/res_time;
             for( k=0; k<s; k++ ) {
                 if( allScalars[k]->allowed_ ) {
-                    fout << setw( allScalars[k]->width_ ) << ( double )*allScalars[k];
+                    line << setw( allScalars[k]->width_ ) << ( double )*allScalars[k];
                     if( ! allScalars[k]->secondname_.empty() ) {
-                        fout << setw( allScalars[k]->width_ ) << ( int )*static_cast<Scalar_value_location *>( allScalars[k] );
+                        line << setw( allScalars[k]->width_ ) << ( int )*static_cast<Scalar_value_location *>( allScalars[k] );
                     }
                 }
             }
-            fout << endl;
+            line << endl;
+            
+            string header_text = header.str(), line_text = line.str();
+            bool flush = flush_timeSelection->theTimeIsNow( itime );
+            submit( header_text.size() + line_text.size(), [this, header_text, line_text, flush]() {
+                if( fout.tellp()==ifstream::pos_type( 0 ) ) { // file beginning
+                    fout << header_text;
+                }
+                fout << line_text;
+                if( flush ) {
+                    fout.flush();
+                }
+            } );
             
         }
         
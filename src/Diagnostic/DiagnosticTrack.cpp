@@ -2,6 +2,7 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 
 #include "ParticleData.h"
 #include "PeekAtSpecies.h"
@@ -17,6 +18,9 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
 {
     write_id_ = true;
     
+    // Get parameter "sort_by_id" which tells whether particles are written sorted by ID
+    PyTools::extract( "sort_by_id", sort_by_id_, "DiagTrackParticles", iDiagTrackParticles );
+    
     // Inform each patch about this diag
     for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
         vecPatches( ipatch )->vecSpecies[species_index_]->tracking_diagnostic = idiag;
@@ -38,8 +42,13 @@ DiagnosticTrack::~DiagnosticTrack()
 
 void DiagnosticTrack::openFile( Params &, SmileiMPI *smpi )
 {
-    // Create HDF5 file
-    file_ = new H5Write( filename, &smpi->world() );
+    // Create HDF5 file (or the subfile of this MPI process)
+    if( smpi->hasSubfiles() ) {
+        subfiling_ = new H5Subfiling( filename, smpi->world(), smpi->subfileComm(), smpi->subfileIndex() );
+        file_ = new H5Write( subfiling_->subfileName(), &smpi->subfileComm() );
+    } else {
+        file_ = new H5Write( filename, &smpi->world() );
+    }
     file_->attr( "name", diag_name_ );
     
     // Attributes for openPMD
@@ -48,6 +57,10 @@ void DiagnosticTrack::openFile( Params &, SmileiMPI *smpi )
     data_group_ = new H5Write( file_, "data" );
     
     file_->flush();
+    
+    if( subfiling_ ) {
+        subfiling_->mirror( file_, "/" );
+    }
 }
 
 void DiagnosticTrack::closeFile()
@@ -57,6 +70,10 @@ void DiagnosticTrack::closeFile()
         delete file_;
         file_ = NULL;
     }
+    if( subfiling_ ) {
+        delete subfiling_;
+        subfiling_ = NULL;
+    }
 }
 
 void DiagnosticTrack::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches )
@@ -77,6 +94,88 @@ void DiagnosticTrack::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPat
 }
 
 
+uint32_t DiagnosticTrack::prepareReordering( VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    if( ! sort_by_id_ ) {
+        return nParticles_local;
+    }
+    
+    // IDs of the local particles, without the first byte, in the order of the buffers
+    vector<uint64_t> id( nParticles_local );
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Particles *p = getParticles( vecPatches( ipatch ) );
+        if( has_filter ) {
+            for( unsigned int i=0; i<patch_selection[ipatch].size(); i++ ) {
+                id[patch_start[ipatch]+i] = p->id( patch_selection[ipatch][i] ) & 72057594037927935;
+            }
+        } else {
+            for( unsigned int i=0; i<p->numberOfParticles(); i++ ) {
+                id[patch_start[ipatch]+i] = p->id( i ) & 72057594037927935;
+            }
+        }
+    }
+    
+    // Particles are sent to the MPI rank which created them (the 3 bytes before the last 4 bytes of the ID),
+    // so that the IDs are sorted across MPI ranks (the last MPI rank receives those created by higher ranks after a restart)
+    int nranks = smpi->getSize();
+    send_order_.resize( nParticles_local );
+    for( uint32_t i=0; i<nParticles_local; i++ ) {
+        send_order_[i] = i;
+    }
+    sort( send_order_.begin(), send_order_.end(), [&id]( uint32_t a, uint32_t b ) {
+        return id[a] < id[b];
+    } );
+    send_count_.assign( nranks, 0 );
+    vector<uint64_t> send_id( nParticles_local );
+    for( uint32_t i=0; i<nParticles_local; i++ ) {
+        send_id[i] = id[send_order_[i]];
+        send_count_[min( ( int )( send_id[i] >> 32 ), nranks-1 )]++;
+    }
+    recv_count_.resize( nranks );
+    MPI_Alltoall( &send_count_[0], 1, MPI_INT, &recv_count_[0], 1, MPI_INT, MPI_COMM_WORLD );
+    send_displ_.assign( nranks, 0 );
+    recv_displ_.assign( nranks, 0 );
+    for( int irank=1; irank<nranks; irank++ ) {
+        send_displ_[irank] = send_displ_[irank-1] + send_count_[irank-1];
+        recv_displ_[irank] = recv_displ_[irank-1] + recv_count_[irank-1];
+    }
+    uint32_t nParticles_sorted = recv_displ_[nranks-1] + recv_count_[nranks-1];
+    
+    // Received IDs are sorted for each sender, merge them
+    vector<uint64_t> recv_id( nParticles_sorted );
+    MPI_Alltoallv( send_id.data(), &send_count_[0], &send_displ_[0], MPI_UNSIGNED_LONG_LONG,
+                   recv_id.data(), &recv_count_[0], &recv_displ_[0], MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD );
+    recv_order_.resize( nParticles_sorted );
+    for( uint32_t i=0; i<nParticles_sorted; i++ ) {
+        recv_order_[i] = i;
+    }
+    sort( recv_order_.begin(), recv_order_.end(), [&recv_id]( uint32_t a, uint32_t b ) {
+        return recv_id[a] < recv_id[b];
+    } );
+    
+    return nParticles_sorted;
+}
+
+template<typename T> T & DiagnosticTrack::reordered( T &buffer, vector<T> &sorted, MPI_Datatype type )
+{
+    if( ! sort_by_id_ ) {
+        return buffer;
+    }
+    T *data = &buffer;
+    vector<T> send( nParticles_local );
+    for( uint32_t i=0; i<nParticles_local; i++ ) {
+        send[i] = data[send_order_[i]];
+    }
+    vector<T> recv( recv_order_.size() );
+    MPI_Alltoallv( send.data(), &send_count_[0], &send_displ_[0], type,
+                   recv.data(), &recv_count_[0], &recv_displ_[0], type, MPI_COMM_WORLD );
+    sorted.resize( recv_order_.size() );
+    for( uint32_t i=0; i<recv_order_.size(); i++ ) {
+        sorted[i] = recv[recv_order_[i]];
+    }
+    return sorted[0];
+}
+
 H5Space * DiagnosticTrack::prepareH5( SimWindow *simWindow, SmileiMPI *smpi, int itime, uint32_t nParticles_local, uint64_t nParticles_global, uint64_t offset )
 {
     // Make a new group for this iteration
@@ -131,9 +230,25 @@ H5Space * DiagnosticTrack::prepareH5( SimWindow *simWindow, SmileiMPI *smpi, int
     // Write x_moved
     iteration_group.attr( "x_moved", simWindow ? simWindow->getXmoved() : 0. );
 
-    // Create the "latest_IDs" dataset
-    // Create file space and select one element for each proc
-    iteration_group.vect( "latest_IDs", latest_Id, smpi->getSize(), H5T_NATIVE_UINT64, smpi->getRank(), 1 );
+    if( subfiling_ ) {
+        // The datasets with one element for each proc are only written in the master file
+        iteration_path_ = "/data/" + t.str();
+        latest_IDs_.resize( smpi->isMaster() ? smpi->getSize() : 0 );
+        MPI_Gather( &latest_Id, 1, MPI_UINT64_T, smpi->isMaster() ? &latest_IDs_[0] : NULL, 1, MPI_UINT64_T, 0, smpi->world() );
+        if( sort_by_id_ ) {
+            sorted_offsets_.resize( smpi->isMaster() ? smpi->getSize() : 0 );
+            MPI_Gather( &offset, 1, MPI_UINT64_T, smpi->isMaster() ? &sorted_offsets_[0] : NULL, 1, MPI_UINT64_T, 0, smpi->world() );
+        }
+    } else {
+        // Create the "latest_IDs" dataset
+        // Create file space and select one element for each proc
+        iteration_group.vect( "latest_IDs", latest_Id, smpi->getSize(), H5T_NATIVE_UINT64, smpi->getRank(), 1 );
+        
+        // Index of the particles sorted by ID: the particles created by each proc start at "sorted_offsets"
+        if( sort_by_id_ ) {
+            iteration_group.vect( "sorted_offsets", offset, smpi->getSize(), H5T_NATIVE_UINT64, smpi->getRank(), 1 );
+        }
+    }
     
     // Filespace and chunks
     hsize_t chunk = 0;
@@ -165,6 +280,18 @@ void DiagnosticTrack::deleteH5()
     delete loc_B_[0];
     delete loc_W_[0];
     delete loc_id_;
+    
+    // Map this iteration of all subfiles in the master file
+    if( subfiling_ ) {
+        subfiling_->mirror( file_, iteration_path_ );
+        if( H5Write *master = subfiling_->master() ) {
+            H5Write iteration_group = master->group( iteration_path_ );
+            iteration_group.vect( "latest_IDs", latest_IDs_, H5T_NATIVE_UINT64 );
+            if( sort_by_id_ ) {
+                iteration_group.vect( "sorted_offsets", sorted_offsets_, H5T_NATIVE_UINT64 );
+            }
+        }
+    }
 }
 
 void DiagnosticTrack::modifyFiltered( VectorPatch &vecPatches, unsigned int ipatch )
@@ -212,36 +339,36 @@ void DiagnosticTrack::setIDs( Particles &particles )
 
 void DiagnosticTrack::write_scalar_uint64( H5Write * location, string name, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_UINT64, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_uint64_, MPI_UNSIGNED_LONG_LONG ), H5T_NATIVE_UINT64, file_space, mem_space );
     openPMD_->writeRecordAttributes( a, unit_type );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 void DiagnosticTrack::write_scalar_short( H5Write * location, string name, short &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_SHORT, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_short_, MPI_SHORT ), H5T_NATIVE_SHORT, file_space, mem_space );
     openPMD_->writeRecordAttributes( a, unit_type );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 void DiagnosticTrack::write_scalar_double( H5Write * location, string name, double &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_DOUBLE, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_double_, MPI_DOUBLE ), H5T_NATIVE_DOUBLE, file_space, mem_space );
     openPMD_->writeRecordAttributes( a, unit_type );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 
 void DiagnosticTrack::write_component_uint64( H5Write * location, string name, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_UINT64, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_uint64_, MPI_UNSIGNED_LONG_LONG ), H5T_NATIVE_UINT64, file_space, mem_space );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 void DiagnosticTrack::write_component_short( H5Write * location, string name, short &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_SHORT, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_short_, MPI_SHORT ), H5T_NATIVE_SHORT, file_space, mem_space );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 void DiagnosticTrack::write_component_double( H5Write * location, string name, double &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type )
 {
-    H5Write a = location->array( name, buffer, H5T_NATIVE_DOUBLE, file_space, mem_space );
+    H5Write a = location->array( name, reordered( buffer, sorted_double_, MPI_DOUBLE ), H5T_NATIVE_DOUBLE, file_space, mem_space );
     openPMD_->writeComponentAttributes( a, unit_type );
 }
 
@@ -28,6 +28,9 @@ public :
     //! Returns the Particles object of interest in a given patch
     Particles * getParticles( Patch * patch ) override;
     
+    //! Sort the particles by ID across MPI ranks, if requested
+    uint32_t prepareReordering( VectorPatch &vecPatches, SmileiMPI *smpi ) override;
+    
     //! Prepare all HDF5 groups, datasets and spaces
     H5Space * prepareH5( SimWindow *simWindow, SmileiMPI *smpi, int itime, uint32_t nParticles_local, uint64_t nParticles_global, uint64_t offset ) override;
     
@@ -59,7 +62,27 @@ public :
     
 private :
     
+    //! Reorder a buffer of nParticles_local particles as prepared by prepareReordering
+    //! \return the reordered buffer (the buffer itself if the particles are not sorted)
+    template<typename T> T & reordered( T &buffer, std::vector<T> &sorted, MPI_Datatype type );
+    
     H5Write * data_group_;
+    
+    //! Tells whether the particles are written sorted by ID
+    bool sort_by_id_;
+    
+    //! Order of the local particles sent to each MPI rank, and order of the received particles
+    std::vector<uint32_t> send_order_, recv_order_;
+    std::vector<int> send_count_, send_displ_, recv_count_, recv_displ_;
+    
+    //! Buffers of the sorted particles
+    std::vector<double> sorted_double_;
+    std::vector<short> sorted_short_;
+    std::vector<uint64_t> sorted_uint64_;
+    
+    //! With subfiles: group of the current iteration, and data of all procs gathered for the master file
+    std::string iteration_path_;
+    std::vector<uint64_t> latest_IDs_, sorted_offsets_;
 };
 
 #endif
@@ -0,0 +1,127 @@
+#include "TimeReduction.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "PyTools.h"
+#include "Field.h"
+#include "H5.h"
+
+using namespace std;
+
+
+TimeReduction::TimeReduction( string diag_type, unsigned int idiag, string name, double timestep ) :
+    timestep_( timestep )
+{
+    // Extract the number of timesteps
+    time_average = 1;
+    PyTools::extract( "time_average", time_average, diag_type, idiag );
+    if( time_average < 1 ) {
+        time_average = 1;
+    }
+    time_average_inv_ = 1./( ( double )time_average );
+
+    // Extract the type of reduction
+    string reduction = "";
+    PyTools::extract( "time_reduction", reduction, diag_type, idiag );
+    if( reduction == "average" ) {
+        type_ = average;
+    } else if( reduction == "rms" ) {
+        type_ = rms;
+    } else if( reduction == "max" ) {
+        type_ = max;
+    } else if( reduction == "dft" ) {
+        type_ = dft;
+    } else {
+        ERROR( name << ": unknown `time_reduction` `" << reduction << "`" );
+    }
+
+    // Extract the frequencies of the Fourier transform
+    PyTools::extractV( "frequencies", frequencies_, diag_type, idiag );
+    if( type_ == dft && frequencies_.size() == 0 ) {
+        ERROR( name << ": `time_reduction = \"dft\"` requires a list of `frequencies`" );
+    }
+    if( type_ != dft && frequencies_.size() > 0 ) {
+        ERROR( name << ": `frequencies` only apply to `time_reduction = \"dft\"`" );
+    }
+}
+
+
+string TimeReduction::suffix( unsigned int icomp ) const
+{
+    if( type_ != dft ) {
+        return "";
+    }
+    ostringstream s( "" );
+    s << "_dft" << ( icomp/2 ) << ( icomp%2 == 0 ? "_re" : "_im" );
+    return s.str();
+}
+
+
+string TimeReduction::name() const
+{
+    switch( type_ ) {
+        case rms:
+            return "rms";
+        case max:
+            return "max";
+        case dft:
+            return "dft";
+        default:
+            return "average";
+    }
+}
+
+
+void TimeReduction::accumulate( int itime, const double *value, double **acc, unsigned int n ) const
+{
+    if( type_ == average ) {
+        double *const __restrict__ a = acc[0];
+        for( unsigned int i=0; i<n; i++ ) {
+            a[i] += value[i];
+        }
+    } else if( type_ == rms ) {
+        double *const __restrict__ a = acc[0];
+        for( unsigned int i=0; i<n; i++ ) {
+            a[i] += value[i] * value[i];
+        }
+    } else if( type_ == max ) {
+        double *const __restrict__ a = acc[0];
+        for( unsigned int i=0; i<n; i++ ) {
+            a[i] = std::max( a[i], std::abs( value[i] ) );
+        }
+    } else {
+        // Running Fourier transform: the phase is computed once per timestep, not per point
+        double t = itime * timestep_;
+        for( unsigned int ifreq=0; ifreq<frequencies_.size(); ifreq++ ) {
+            double c =  cos( frequencies_[ifreq] * t );
+            double s = -sin( frequencies_[ifreq] * t );
+            double *const __restrict__ re = acc[2*ifreq  ];
+            double *const __restrict__ im = acc[2*ifreq+1];
+            for( unsigned int i=0; i<n; i++ ) {
+                re[i] += c * value[i];
+                im[i] += s * value[i];
+            }
+        }
+    }
+}
+
+
+void TimeReduction::accumulate( int itime, Field *field, Field **acc ) const
+{
+    vector<double *> a( size() );
+    for( unsigned int icomp=0; icomp<a.size(); icomp++ ) {
+        a[icomp] = acc[icomp]->data();
+    }
+    accumulate( itime, field->data(), &a[0], field->number_of_points_ );
+}
+
+
+void TimeReduction::writeAttributes( H5Write *file ) const
+{
+    file->attr( "time_average", time_average );
+    file->attr( "time_reduction", name() );
+    if( type_ == dft ) {
+        file->attr( "frequencies", frequencies_ );
+    }
+}
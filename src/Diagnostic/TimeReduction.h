@@ -0,0 +1,85 @@
+#ifndef TIMEREDUCTION_H
+#define TIMEREDUCTION_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+class Field;
+class H5Write;
+
+//! Class for reducing the data of a diagnostic over the time_average timesteps preceding each output.
+//! Each quantity of the diagnostic is accumulated in size() buffers, which are turned into the output by value().
+class TimeReduction
+{
+
+public:
+    //! Constructor from the namelist block diag_type #idiag: time_average, time_reduction and frequencies
+    //! \param name of the diagnostic, for error messages
+    TimeReduction( std::string diag_type, unsigned int idiag, std::string name, double timestep );
+
+    ~TimeReduction() {};
+
+    //! Number of timesteps of the reduction
+    int time_average;
+
+    //! Whether the data needs to be accumulated (any reduction but the instantaneous value)
+    inline bool accumulates() const
+    {
+        return type_ != average || time_average > 1;
+    }
+
+    //! Whether the reduction is a sum over time, so that it can be computed on linear combinations of the data
+    inline bool isAverage() const
+    {
+        return type_ == average;
+    }
+
+    //! Number of buffers per reduced quantity
+    inline unsigned int size() const
+    {
+        return type_ == dft ? 2*frequencies_.size() : 1;
+    }
+
+    //! Suffix of the name of the buffer icomp in the output
+    std::string suffix( unsigned int icomp ) const;
+
+    //! Name of the reduction
+    std::string name() const;
+
+    //! Accumulate n values of the timestep itime in the size() buffers acc
+    void accumulate( int itime, const double *value, double **acc, unsigned int n ) const;
+    //! Accumulate a field in the size() fields acc
+    void accumulate( int itime, Field *field, Field **acc ) const;
+
+    //! Reduced value from the accumulated one
+    inline double value( double accumulated ) const
+    {
+        switch( type_ ) {
+            case rms:
+                return std::sqrt( accumulated * time_average_inv_ );
+            case max:
+                return accumulated;
+            case dft:
+                return 2. * accumulated * time_average_inv_;
+            default:
+                return accumulated * time_average_inv_;
+        }
+    }
+
+    //! Write the parameters of the reduction as attributes
+    void writeAttributes( H5Write *file ) const;
+
+private:
+    enum Type { average, rms, max, dft };
+    Type type_;
+
+    double time_average_inv_;
+
+    double timestep_;
+
+    //! Angular frequencies of the Fourier transform
+    std::vector<double> frequencies_;
+};
+
+#endif
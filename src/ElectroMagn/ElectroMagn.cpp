@@ -1,5 +1,6 @@
 #include "ElectroMagn.h"
 
+#include <algorithm>
 #include <limits>
 #include <iostream>
 
@@ -53,6 +54,9 @@ ElectroMagn::ElectroMagn( Params &params, vector<Species *> &vecSpecies, Patch *
     emBoundCond = ElectroMagnBC_Factory::create( params, patch );
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellSolver_        = SolverFactory::createMAMF( params );
+    quiescent_ = false;
+    deferred_steps_ = 0;
     
     envelope = NULL;
     
@@ -86,10 +90,95 @@ ElectroMagn::ElectroMagn( ElectroMagn *emFields, Params &params, Patch *patch )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellSolver_        = SolverFactory::createMAMF( params );
+    quiescent_ = false;
+    deferred_steps_ = 0;
     
     envelope = NULL;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Whether the points i0 to i1 of an array are zero, scanned by blocks so that a non-zero value stops the scan early
+// ---------------------------------------------------------------------------------------------------------------------
+static bool pointsAreZero( const double *const __restrict__ f, size_t i0, size_t i1 )
+{
+    const size_t block = 256;
+    for( size_t j0 = i0 ; j0 < i1 ; j0 += block ) {
+        const size_t j1 = std::min( j0 + block, i1 );
+        unsigned int nonzero = 0;
+        #pragma omp simd reduction(+:nonzero)
+        for( size_t j = j0 ; j < j1 ; j++ ) {
+            nonzero += ( f[j] != 0. );
+        }
+        if( nonzero > 0 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Whether E, B, B_m and J (or only J) are identically zero, ghost cells included (cartesian geometries only)
+// With borders_only, only the layers of 2*oversize+2 cells along the patch edges are scanned: the exchanges, the sums of
+// the currents and the boundary conditions write there only, so that the rest of a quiescent patch remains zero
+// ---------------------------------------------------------------------------------------------------------------------
+bool ElectroMagn::fieldsAreZero( bool borders_only, bool currents_only )
+{
+    // Currents first: they are the most likely to be non-zero
+    Field *fields[12] = { Jx_, Jy_, Jz_, Ex_, Ey_, Ez_, Bx_, By_, Bz_, Bx_m, By_m, Bz_m };
+    const unsigned int nfields = currents_only ? 3 : 12;
+    for( unsigned int ifield = 0 ; ifield < nfields ; ifield++ ) {
+        const double *const f = fields[ifield]->data();
+        const std::vector<unsigned int> dims = fields[ifield]->dims();
+        if( ! borders_only || dims.size() > 3 ) {
+            if( ! pointsAreZero( f, 0, fields[ifield]->number_of_points_ ) ) {
+                return false;
+            }
+            continue;
+        }
+        // Seen as a 3D array, the last dimension being contiguous, with the layer width in each dimension
+        size_t n[3] = { 1, 1, 1 };
+        size_t w[3] = { 0, 0, 0 };
+        for( unsigned int d = 0 ; d < dims.size() ; d++ ) {
+            n[3-dims.size()+d] = dims[d];
+            w[3-dims.size()+d] = 2*oversize[d] + 2;
+        }
+        for( size_t i = 0 ; i < n[0] ; i++ ) {
+            bool border_i = n[0] > 1 && ( i < w[0] || i + w[0] >= n[0] );
+            for( size_t j = 0 ; j < n[1] ; j++ ) {
+                bool border_j = n[1] > 1 && ( j < w[1] || j + w[1] >= n[1] );
+                const size_t row = ( i*n[1] + j )*n[2];
+                if( border_i || border_j || 2*w[2] >= n[2] ) {
+                    if( ! pointsAreZero( f, row, row + n[2] ) ) {
+                        return false;
+                    }
+                } else if( ! pointsAreZero( f, row, row + w[2] ) || ! pointsAreZero( f, row + n[2] - w[2], row + n[2] ) ) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Advance E and B by the Maxwell steps deferred in this vacuum patch (see VectorPatch::solveMaxwell)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::applyDeferredSteps( bool save_B_m )
+{
+    if( deferred_steps_ == 0 ) {
+        return;
+    }
+    if( save_B_m ) {
+        MaxwellSolver_->advanceVacuum( this, deferred_steps_-1 );
+        saveMagneticFields( false );
+        MaxwellSolver_->advanceVacuum( this, 1 );
+    } else {
+        MaxwellSolver_->advanceVacuum( this, deferred_steps_ );
+    }
+    deferred_steps_ = 0;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Initialize quantities used in ElectroMagn
 // ---------------------------------------------------------------------------------------------------------------------
@@ -287,6 +376,9 @@ ElectroMagn::~ElectroMagn()
         
     delete MaxwellAmpereSolver_;
     delete MaxwellFaradaySolver_;
+    if( MaxwellSolver_ ) {
+        delete MaxwellSolver_;
+    }
     
     if( envelope != NULL ) {
         delete envelope;
@@ -431,6 +523,61 @@ void ElectroMagn::restartRhoJs()
     restartRhoJ();
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Lazy allocation of the species densities : they are allocated (and set to 0) only when projected for diagnostics,
+// and freed again in the patches where the species has no particle (vacuum, ahead of the moving window)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::allocateRhoJs()
+{
+    for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
+        if( Jx_s [ispec] && !Jx_s [ispec]->data_ ) {
+            if( is_pxr ) {
+                Jx_s [ispec]->allocateDims();
+            } else {
+                Jx_s [ispec]->allocateDims( 0, false );
+            }
+        }
+        if( Jy_s [ispec] && !Jy_s [ispec]->data_ ) {
+            if( is_pxr ) {
+                Jy_s [ispec]->allocateDims();
+            } else {
+                Jy_s [ispec]->allocateDims( 1, false );
+            }
+        }
+        if( Jz_s [ispec] && !Jz_s [ispec]->data_ ) {
+            if( is_pxr ) {
+                Jz_s [ispec]->allocateDims();
+            } else {
+                Jz_s [ispec]->allocateDims( 2, false );
+            }
+        }
+        if( rho_s[ispec] && !rho_s[ispec]->data_ ) {
+            rho_s[ispec]->allocateDims();
+        }
+    }
+}
+
+void ElectroMagn::releaseRhoJs( std::vector<Species *> &vecSpecies )
+{
+    for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
+        if( vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
+            continue;
+        }
+        if( Jx_s [ispec] ) {
+            Jx_s [ispec]->deallocateDims();
+        }
+        if( Jy_s [ispec] ) {
+            Jy_s [ispec]->deallocateDims();
+        }
+        if( Jz_s [ispec] ) {
+            Jz_s [ispec]->deallocateDims();
+        }
+        if( rho_s[ispec] ) {
+            rho_s[ispec]->deallocateDims();
+        }
+    }
+}
+
 void ElectroMagn::restartEnvChis()
 {
     for( unsigned int ispec=0 ; ispec < n_species ; ispec++ ) {
@@ -441,16 +588,6 @@ void ElectroMagn::restartEnvChis()
     Env_Chi_->put_to( 0. );
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Increment an averaged field
-// ---------------------------------------------------------------------------------------------------------------------
-void ElectroMagn::incrementAvgField( Field *field, Field *field_avg )
-{
-    for( unsigned int i=0; i<field->number_of_points_; i++ ) {
-        ( *field_avg )( i ) += ( *field )( i );
-    }
-}//END incrementAvgField
-
 
 
 void ElectroMagn::laserDisabled()
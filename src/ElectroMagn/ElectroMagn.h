@@ -315,6 +315,10 @@ public:
     virtual void restartRhoJ();
     //! Method used to initialize the total charge currents and densities of species
     virtual void restartRhoJs();
+    //! Allocate the densities and currents of species released by releaseRhoJs, before projecting them
+    virtual void allocateRhoJs();
+    //! Free the densities and currents of the species which have no particle in this patch
+    virtual void releaseRhoJs( std::vector<Species *> &vecSpecies );
 
     //! Method used to initialize the total susceptibility
     virtual void restartEnvChi();
@@ -383,6 +387,21 @@ public:
     Solver *MaxwellAmpereSolver_;
     //! Maxwell Faraday Solver
     Solver *MaxwellFaradaySolver_;
+    //! Maxwell Ampere and Faraday Solvers fused (NULL if not available)
+    Solver *MaxwellSolver_;
+    //! Whether E, B and J are identically zero, so that the Maxwell solvers may be skipped
+    //! (see Main.skip_quiescent_patches), updated in VectorPatch::solveMaxwell
+    bool quiescent_;
+    //! Number of Maxwell steps deferred in this vacuum patch, to be advanced at once
+    //! (see Main.temporal_blocking), updated in VectorPatch::solveMaxwell
+    unsigned int deferred_steps_;
+    //! Whether E, B, B_m and J are identically zero, ghost cells included
+    //! \param borders_only  only check the layers along the patch edges (the rest is known to be zero)
+    //! \param currents_only only check J
+    bool fieldsAreZero( bool borders_only = false, bool currents_only = false );
+    //! Advance E and B by the deferred Maxwell steps, in a single sweep
+    //! \param save_B_m  save B in B_m before the last step, as VectorPatch::solveMaxwell does
+    void applyDeferredSteps( bool save_B_m );
     virtual void saveMagneticFields( bool ) = 0;
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes ) = 0;
@@ -392,8 +411,6 @@ public:
 
     void laserDisabled();
 
-    void incrementAvgField( Field *field, Field *field_avg );
-
     //! compute Poynting on borders
     virtual void computePoynting( unsigned int axis, unsigned int side ) = 0;
 
@@ -9,6 +9,7 @@
 #endif
 
 #include <cstring>
+#include <vector>
 
 #include "ElectroMagnBC.h"
 #include "Field3D.h"
@@ -1355,163 +1356,140 @@ void ElectroMagn3D::centerMagneticFields()
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Apply a single pass binomial filter on currents
+// Single pass of the binomial filter on a field of size n0 x n1 x n2, along the directions where filter[idim] is true.
+// The field is processed plane by plane (fixed first index): the X, Y and Z stencils are applied to a plane while it
+// is in cache, instead of sweeping the whole field twice per direction. The operations are the same as with successive
+// forward and backward sweeps along X, then Y, then Z: external points are treated by exchange, boundary points not
+// concerned by exchange are treated with a lower order filter.
 // ---------------------------------------------------------------------------------------------------------------------
-void ElectroMagn3D::binomialCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes)
+static void binomialFilterPlanes( double *const __restrict__ f, unsigned int n0, unsigned int n1, unsigned int n2, const bool *filter )
 {
-    const unsigned int nx_p = dimPrim[0];
-    const unsigned int ny_p = dimPrim[1];
-    const unsigned int nz_p = dimPrim[2];
-    const unsigned int nx_d = dimDual[0];
-    const unsigned int ny_d = dimDual[1];
-    const unsigned int nz_d = dimDual[2];
-    // Static-cast of the currents
-    Field3D *Jx3D = static_cast<Field3D *>( Jx_ );
-    Field3D *Jy3D = static_cast<Field3D *>( Jy_ );
-    Field3D *Jz3D = static_cast<Field3D *>( Jz_ );
-
-    // applying a single pass of the binomial filter along X
-    if (ipass < passes[0]){
-        // on Jx^(d,p) -- external points are treated by exchange. Boundary points not concerned by exchange are treated with a lower order filter.
-        for( unsigned int i=0; i<nx_d-1; i++ ) {
-            for( unsigned int j=0; j<ny_p; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i+1, j, k ) )*0.5;
+    const unsigned int plane = n1*n2;
+    // Unfiltered copies of the previous and current planes along X (one per thread)
+    static thread_local std::vector<double> previous_buffer, current_buffer, line_buffer;
+    if( previous_buffer.size() < plane ) {
+        previous_buffer.resize( plane );
+        current_buffer.resize( plane );
+    }
+    if( line_buffer.size() < n2 ) {
+        line_buffer.resize( n2 );
+    }
+    double *__restrict__ previous = previous_buffer.data();
+    double *__restrict__ current  = current_buffer.data();
+    double *const __restrict__ line = line_buffer.data();
+
+    for( unsigned int i=0; i<n0; i++ ) {
+        double *const __restrict__ p = &f[i*plane];
+
+        // Along X: the forward sweep gives (a_i+a_i+1)/2, the backward sweep averages it with (a_i-1+a_i)/2
+        if( filter[0] && i<n0-1 ) {
+            const double *const __restrict__ next = &f[( i+1 )*plane];
+            std::memcpy( current, p, plane*sizeof( double ) );
+            if( i==0 ) {
+                #pragma omp simd
+                for( unsigned int jk=0; jk<plane; jk++ ) {
+                    p[jk] = ( current[jk] + next[jk] )*0.5;
                 }
-            }
-        }
-        for( unsigned int i=nx_d-2; i>0; i-- ) {
-            for( unsigned int j=0; j<ny_p; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i-1, j, k ) )*0.5;
+            } else {
+                #pragma omp simd
+                for( unsigned int jk=0; jk<plane; jk++ ) {
+                    p[jk] = ( ( current[jk] + next[jk] )*0.5 + ( previous[jk] + current[jk] )*0.5 )*0.5;
                 }
             }
+            std::swap( previous, current );
         }
-        // Jy
-        for( unsigned int i=0; i<nx_p-1; i++ ) {
-            for( unsigned int j=0; j<ny_d; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i+1, j, k ) )*0.5;
-                }
-            }
+
+        if( i==0 || i==n0-1 ) {
+            continue;
         }
-        for( unsigned int i=nx_p-2; i>0; i-- ) {
-            for( unsigned int j=0; j<ny_d; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i-1, j, k ) )*0.5;
+
+        // Along Y, in the plane
+        if( filter[1] ) {
+            for( unsigned int j=0; j<n1-1; j++ ) {
+                double *const __restrict__ row = &p[j*n2];
+                const double *const __restrict__ next_row = &p[( j+1 )*n2];
+                #pragma omp simd
+                for( unsigned int k=0; k<n2; k++ ) {
+                    row[k] = ( row[k] + next_row[k] )*0.5;
                 }
             }
-        }
-        // Jz
-        for( unsigned int i=0; i<nx_p-1; i++ ) {
-            for( unsigned int j=0; j<ny_p; j++ ) {
-                for( unsigned int k=0; k<nz_d; k++ ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i+1, j, k ) )*0.5;
+            for( unsigned int j=n1-2; j>0; j-- ) {
+                double *const __restrict__ row = &p[j*n2];
+                const double *const __restrict__ previous_row = &p[( j-1 )*n2];
+                #pragma omp simd
+                for( unsigned int k=0; k<n2; k++ ) {
+                    row[k] = ( row[k] + previous_row[k] )*0.5;
                 }
             }
         }
-        for( unsigned int i=nx_p-2; i>0; i-- ) {
-            for( unsigned int j=0; j<ny_p; j++ ) {
-                for( unsigned int k=0; k<nz_d; k++ ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i-1, j, k ) )*0.5;
+
+        // Along Z, line by line
+        if( filter[2] ) {
+            for( unsigned int j=1; j<n1-1; j++ ) {
+                double *const __restrict__ row = &p[j*n2];
+                std::memcpy( line, row, n2*sizeof( double ) );
+                row[0] = ( line[0] + line[1] )*0.5;
+                #pragma omp simd
+                for( unsigned int k=1; k<n2-1; k++ ) {
+                    row[k] = ( ( line[k] + line[k+1] )*0.5 + ( line[k-1] + line[k] )*0.5 )*0.5;
                 }
             }
         }
     }
+}
 
-    // applying a single pass of the binomial filter along Y
-    if (ipass < passes[1]){
-        //Jx
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=0; j<ny_p-1; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i, j+1, k ) )*0.5;
-                }
-            }
-        }
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=ny_p-2; j>0; j-- ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i, j-1, k ) )*0.5;
-                }
-            }
-        }
-        //Jy
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=0; j<ny_d-1; j++ ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i, j+1, k ) )*0.5;
-                }
-            }
-        }
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=ny_d-2; j>0; j-- ) {
-                for( unsigned int k=0; k<nz_p; k++ ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i, j-1, k ) )*0.5;
-                }
-            }
-        }
-        //Jz
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=0; j<ny_p-1; j++ ) {
-                for( unsigned int k=0; k<nz_d; k++ ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i, j+1, k ) )*0.5;
-                }
-            }
-        }
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=ny_p-2; j>0; j-- ) {
-                for( unsigned int k=0; k<nz_d; k++ ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i, j-1, k ) )*0.5;
-                }
-            }
-        }
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply a single pass binomial filter on currents
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn3D::binomialCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes)
+{
+    const bool filter[3] = { ipass < passes[0], ipass < passes[1], ipass < passes[2] };
+    if( !filter[0] && !filter[1] && !filter[2] ) {
+        return;
     }
-    // applying a single pass of the binomial filter along Z
-    if (ipass < passes[2]){
-        //Jx
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=0; k<nz_p-1; k++ ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i, j, k+1 ) )*0.5;
-                }
-            }
-        }
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=nz_p-2; k>0; k-- ) {
-                    ( *Jx3D )( i, j, k ) = ( ( *Jx3D )( i, j, k ) + ( *Jx3D )( i, j, k-1 ) )*0.5;
-                }
-            }
-        }
-        //Jy
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_d-1; j++ ) {
-                for( unsigned int k=0; k<nz_p-1; k++ ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i, j, k+1 ) )*0.5;
-                }
-            }
-        }
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_d-1; j++ ) {
-                for( unsigned int k=nz_p-2; k>0; k-- ) {
-                    ( *Jy3D )( i, j, k ) = ( ( *Jy3D )( i, j, k ) + ( *Jy3D )( i, j, k-1 ) )*0.5;
-                }
-            }
-        }
-        //Jz
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=0; k<nz_d-1; k++ ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i, j, k+1 ) )*0.5;
+
+    binomialFilterPlanes( Jx_->data(), dimDual[0], dimPrim[1], dimPrim[2], filter );
+    binomialFilterPlanes( Jy_->data(), dimPrim[0], dimDual[1], dimPrim[2], filter );
+    binomialFilterPlanes( Jz_->data(), dimPrim[0], dimPrim[1], dimDual[2], filter );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Single pass of a custom FIR filter along the direction dir, on the points [lo[idim], hi[idim][ of a field of size
+// n[0] x n[1] x n[2]. The stencil is applied to whole lines along Z, from a copy of the field reused between calls.
+// ---------------------------------------------------------------------------------------------------------------------
+static void customFIRFilterLines( double *const __restrict__ f, const unsigned int *n, unsigned int dir,
+                                  const unsigned int *lo, const unsigned int *hi,
+                                  const std::vector<double> &filtering_coeff, unsigned int m )
+{
+    const size_t size = ( size_t )n[0]*n[1]*n[2];
+    static thread_local std::vector<double> copy;
+    if( copy.size() < size ) {
+        copy.resize( size );
+    }
+    std::memcpy( copy.data(), f, size*sizeof( double ) );
+
+    const ptrdiff_t stride[3] = { ( ptrdiff_t )n[1]*n[2], ( ptrdiff_t )n[2], 1 };
+    const ptrdiff_t half = ( filtering_coeff.size()-1 )/( m*2 );
+
+    for( unsigned int i=lo[0]; i<hi[0]; i++ ) {
+        for( unsigned int j=lo[1]; j<hi[1]; j++ ) {
+            double *const __restrict__ out = &f[i*stride[0] + j*stride[1]];
+            const double *const in = &copy[i*stride[0] + j*stride[1]];
+            #pragma omp simd
+            for( unsigned int k=lo[2]; k<hi[2]; k++ ) {
+                out[k] = 0.;
+            }
+            for( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m ) {
+                const double coeff = filtering_coeff[kernel_idx];
+                const double *const __restrict__ shifted = in + ( ( ptrdiff_t )( kernel_idx/m ) - half )*stride[dir];
+                #pragma omp simd
+                for( unsigned int k=lo[2]; k<hi[2]; k++ ) {
+                    out[k] += coeff*shifted[k];
                 }
             }
-        }
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=nz_d-2; k>0; k-- ) {
-                    ( *Jz3D )( i, j, k ) = ( ( *Jz3D )( i, j, k ) + ( *Jz3D )( i, j, k-1 ) )*0.5;
-                }
+            #pragma omp simd
+            for( unsigned int k=lo[2]; k<hi[2]; k++ ) {
+                out[k] *= m;
             }
         }
     }
@@ -1522,164 +1500,35 @@ void ElectroMagn3D::binomialCurrentFilter(unsigned int ipass, std::vector<unsign
 // ---------------------------------------------------------------------------------------------------------------------
 void ElectroMagn3D::customFIRCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes, std::vector<double> filtering_coeff)
 {
-    const unsigned int nx_p = dimPrim[0];
-    const unsigned int ny_p = dimPrim[1];
-    const unsigned int nz_p = dimPrim[2];
-    const unsigned int nx_d = dimDual[0];
-    const unsigned int ny_d = dimDual[1];
-    const unsigned int nz_d = dimDual[2];
-    // Static-cast of the currents
-    Field3D *Jx3D = static_cast<Field3D *>( Jx_ );
-    Field3D *Jy3D = static_cast<Field3D *>( Jy_ );
-    Field3D *Jz3D = static_cast<Field3D *>( Jz_ );
-
     unsigned int m=1 ;
 
     // Guard-Cell Current
     unsigned int gcfilt=0 ;
 
-    // Applying a single pass of the custom FIR based filter along X
-    if (ipass < passes[0]){
-        Field3D *tmp   = new Field3D( dimPrim, 0, false );
-        tmp->copyFrom( Jx3D );
-        for( unsigned int i=((filtering_coeff.size()-1)/(m*2)+gcfilt); i<nx_d-((filtering_coeff.size()-1)/(m*2)+gcfilt); i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=1; k<nz_p-1; k++ ) {
-                    ( *Jx3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jx3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m, j, k ) ;
-                    }
-                    ( *Jx3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-        tmp   = new Field3D( dimPrim, 1, false );
-        tmp->copyFrom( Jy3D );
-        for( unsigned int i=((filtering_coeff.size()-1)/(m*2)+gcfilt); i<nx_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); i++ ) {
-            for( unsigned int j=1; j<ny_d-1; j++ ) {
-                for( unsigned int k=1; k<nz_p-1; k++ ) {
-                    ( *Jy3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jy3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m, j, k ) ;
-                    }
-                    ( *Jy3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-        tmp   = new Field3D( dimPrim, 2, false );
-        tmp->copyFrom( Jz3D );
-        for( unsigned int i=((filtering_coeff.size()-1)/(m*2)+gcfilt); i<nx_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=1; k<nz_d-1; k++ ) {
-                    ( *Jz3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jz3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m, j, k ) ;
-                    }
-                    ( *Jz3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-    }
+    const unsigned int half = ( filtering_coeff.size()-1 )/( m*2 ) + gcfilt;
 
-    // Applying a single pass of the custom FIR based filter along Y
-    if (ipass < passes[1]){
-        // On Jx^(d,p,p) -- External points are treated by exchange
-        Field3D *tmp   = new Field3D( dimPrim, 0, false );
-        tmp->copyFrom( Jx3D );
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=((filtering_coeff.size()-1)/(m*2)+gcfilt); j<ny_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); j++ ) {
-                for( unsigned int k=1; k<nz_p-1; k++ ) {
-                    ( *Jx3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jx3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m, k ) ;
-                    }
-                    ( *Jx3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-        // On Jy^(p,d,p) -- External points are treated by exchange
-        tmp   = new Field3D( dimPrim, 1, false );
-        tmp->copyFrom( Jy3D );
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=((filtering_coeff.size()-1)/(m*2)+gcfilt); j<ny_d-((filtering_coeff.size()-1)/(m*2)+gcfilt); j++ ) {
-                for( unsigned int k=1; k<nz_p-1; k++ ) {
-                    ( *Jy3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jy3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m, k ) ;
-                    }
-                    ( *Jy3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-        // On Jz^(p,p,d) -- External points are treated by exchange
-        tmp   = new Field3D( dimPrim, 2, false );
-        tmp->copyFrom( Jz3D );
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=((filtering_coeff.size()-1)/(m*2)+gcfilt); j<ny_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); j++ ) {
-                for( unsigned int k=1; k<nz_d-1; k++ ) {
-                    ( *Jz3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jz3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m , k) ;
-                    }
-                    ( *Jz3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-    }
+    // Sizes of Jx^(d,p,p), Jy^(p,d,p) and Jz^(p,p,d)
+    const unsigned int nJx[3] = { dimDual[0], dimPrim[1], dimPrim[2] };
+    const unsigned int nJy[3] = { dimPrim[0], dimDual[1], dimPrim[2] };
+    const unsigned int nJz[3] = { dimPrim[0], dimPrim[1], dimDual[2] };
+    const unsigned int *sizes[3] = { nJx, nJy, nJz };
+    Field *J[3] = { Jx_, Jy_, Jz_ };
 
-    // Applying a single pass of the custom FIR based filter along Z
-    if (ipass < passes[2]){
-        // On Jx^(d,p,p) -- External points are treated by exchange
-        Field3D *tmp   = new Field3D( dimPrim, 0, false );
-        tmp->copyFrom( Jx3D );
-        for( unsigned int i=1; i<nx_d-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=((filtering_coeff.size()-1)/(m*2)+gcfilt); k<ny_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); k++ ) {
-                    ( *Jx3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jx3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j, k - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m ) ;
-                    }
-                    ( *Jx3D )( i, j, k ) *= m ;
-                }
-            }
+    // Applying a single pass of the custom FIR based filter along X, then Y, then Z.
+    // External points are treated by exchange
+    for( unsigned int dir=0; dir<3; dir++ ) {
+        if( ipass >= passes[dir] ) {
+            continue;
         }
-        delete tmp;
-        // On Jy^(p,d,p) -- External points are treated by exchange
-        tmp   = new Field3D( dimPrim, 1, false );
-        tmp->copyFrom( Jy3D );
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_d-1; j++ ) {
-                for( unsigned int k=((filtering_coeff.size()-1)/(m*2)+gcfilt); k<ny_p-((filtering_coeff.size()-1)/(m*2)+gcfilt); k++ ) {
-                    ( *Jy3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jy3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j, k - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m ) ;
-                    }
-                    ( *Jy3D )( i, j, k ) *= m ;
-                }
-            }
-        }
-        delete tmp;
-        // On Jz^(p,p,d) -- External points are treated by exchange
-        tmp   = new Field3D( dimPrim, 2, false );
-        tmp->copyFrom( Jz3D );
-        for( unsigned int i=1; i<nx_p-1; i++ ) {
-            for( unsigned int j=1; j<ny_p-1; j++ ) {
-                for( unsigned int k=((filtering_coeff.size()-1)/(m*2)+gcfilt); k<ny_d-((filtering_coeff.size()-1)/(m*2)+gcfilt); k++ ) {
-                    ( *Jz3D )( i, j, k ) = 0. ;
-                    for ( unsigned int kernel_idx = 0; kernel_idx < filtering_coeff.size(); kernel_idx+=m) {
-                        ( *Jz3D )( i, j, k ) += filtering_coeff[kernel_idx]*( *tmp )( i, j, k - (filtering_coeff.size()-1)/(m*2) + kernel_idx/m ) ;
-                    }
-                    ( *Jz3D )( i, j, k ) *= m ;
-                }
+        for( unsigned int icomp=0; icomp<3; icomp++ ) {
+            const unsigned int *n = sizes[icomp];
+            unsigned int lo[3], hi[3];
+            for( unsigned int idim=0; idim<3; idim++ ) {
+                lo[idim] = ( idim==dir ) ? half : 1;
+                hi[idim] = ( idim==dir ) ? n[idim]-half : n[idim]-1;
             }
+            customFIRFilterLines( J[icomp]->data(), n, dir, lo, hi, filtering_coeff, m );
         }
-        delete tmp;
     }
 
 }//END customFIRCurrentFilter
@@ -437,6 +437,58 @@ void ElectroMagnAM::restartRhoJs()
     }
 }
 
+void ElectroMagnAM::allocateRhoJs()
+{
+    for( unsigned int ifield=0 ; ifield < n_species*nmodes ; ifield++ ) {
+        if( Jl_s [ifield] && !Jl_s [ifield]->cdata_ ) {
+            if( is_pxr ) {
+                Jl_s [ifield]->allocateDims();
+            } else {
+                Jl_s [ifield]->allocateDims( 0, false );
+            }
+        }
+        if( Jr_s [ifield] && !Jr_s [ifield]->cdata_ ) {
+            if( is_pxr ) {
+                Jr_s [ifield]->allocateDims();
+            } else {
+                Jr_s [ifield]->allocateDims( 1, false );
+            }
+        }
+        if( Jt_s [ifield] && !Jt_s [ifield]->cdata_ ) {
+            if( is_pxr ) {
+                Jt_s [ifield]->allocateDims();
+            } else {
+                Jt_s [ifield]->allocateDims( 2, false );
+            }
+        }
+        if( rho_AM_s[ifield] && !rho_AM_s[ifield]->cdata_ ) {
+            rho_AM_s[ifield]->allocateDims();
+        }
+    }
+}
+
+void ElectroMagnAM::releaseRhoJs( std::vector<Species *> &vecSpecies )
+{
+    // ifield = imode*n_species+ispec
+    for( unsigned int ifield=0 ; ifield < n_species*nmodes ; ifield++ ) {
+        if( vecSpecies[ifield%n_species]->getNbrOfParticles() > 0 ) {
+            continue;
+        }
+        if( Jl_s [ifield] ) {
+            Jl_s [ifield]->deallocateDims();
+        }
+        if( Jr_s [ifield] ) {
+            Jr_s [ifield]->deallocateDims();
+        }
+        if( Jt_s [ifield] ) {
+            Jt_s [ifield]->deallocateDims();
+        }
+        if( rho_AM_s[ifield] ) {
+            rho_AM_s[ifield]->deallocateDims();
+        }
+    }
+}
+
 void ElectroMagnAM::restartRhos()
 {
     for( unsigned int ispec=0 ; ispec < n_species*nmodes ; ispec++ ) {
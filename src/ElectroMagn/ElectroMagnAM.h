@@ -45,6 +45,8 @@ public:
     void restartRhoold() ;
     void restartRhos() ;
     void restartRhoJs() override;
+    void allocateRhoJs() override;
+    void releaseRhoJs( std::vector<Species *> &vecSpecies ) override;
     
     // fields for Poisson solver
     cField2D *El_Poisson_;
@@ -0,0 +1,37 @@
+#ifndef MA_MF_SOLVER3D_YEE_H
+#define MA_MF_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MA_MF_Solver3D_Yee
+//! Maxwell-Ampere and Maxwell-Faraday (Yee) solvers fused in a single sweep along X, within one time step:
+//! the plane i of E is advanced, then the plane i of B, while the planes i-1 to i+1 of all fields are still
+//! in cache. Gives the same results as MA_Solver3D_norm followed by MF_Solver3D_Yee.
+//! In vacuum, several time steps may be advanced in the same sweep (temporal blocking, see advanceVacuum).
+//  --------------------------------------------------------------------------------------------------------------------
+class MA_MF_Solver3D_Yee : public Solver3D
+{
+
+public:
+    //! Creator for MA_MF_Solver3D_Yee
+    MA_MF_Solver3D_Yee( Params &params );
+    virtual ~MA_MF_Solver3D_Yee();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn *fields );
+
+    //! Advance E and B by nsteps time steps without currents, in a single sweep along X
+    void advanceVacuum( ElectroMagn *fields, unsigned int nsteps ) override;
+
+protected:
+
+private:
+    //! Advance the plane i of E, then the plane i of B, by one time step (with or without currents)
+    template<bool currents>
+    void advancePlane( ElectroMagn *fields, unsigned int i );
+
+};//END class
+
+#endif
@@ -0,0 +1,254 @@
+
+#include "PSATD_Solver.h"
+
+#include <cmath>
+#include <cstring>
+
+#ifdef _FFTW
+#include <fftw3.h>
+#endif
+
+#include "ElectroMagn.h"
+#include "Field.h"
+#include "Tools.h"
+
+using namespace std;
+
+PSATD_Solver::PSATD_Solver( Params &params )
+    : Solver(),
+      nreal_( 0 ),
+      ncomplex_( 0 ),
+      nk2_( 0 ),
+      real_( NULL ),
+      forward_( NULL ),
+      backward_( NULL )
+{
+    ndim_ = params.nDim_field;
+    dt_ = params.timestep;
+    cell_length_.resize( 3, 1. );
+    for( unsigned int i=0 ; i<ndim_ ; i++ ) {
+        cell_length_[i] = params.cell_length[i];
+    }
+    v_ = params.galilean_velocity;
+    for( unsigned int ic=0 ; ic<10 ; ic++ ) {
+        spectrum_[ic] = NULL;
+    }
+}
+
+PSATD_Solver::~PSATD_Solver()
+{
+    uncoupling();
+}
+
+void PSATD_Solver::coupling( Params &, ElectroMagn *EMfields, bool )
+{
+    prepare( EMfields->dimPrim );
+}
+
+void PSATD_Solver::uncoupling()
+{
+#ifdef _FFTW
+    if( forward_ ) {
+        fftw_destroy_plan( forward_ );
+        fftw_destroy_plan( backward_ );
+        forward_ = NULL;
+        backward_ = NULL;
+    }
+    if( real_ ) {
+        fftw_free( real_ );
+        real_ = NULL;
+    }
+    for( unsigned int ic=0 ; ic<10 ; ic++ ) {
+        if( spectrum_[ic] ) {
+            fftw_free( spectrum_[ic] );
+            spectrum_[ic] = NULL;
+        }
+    }
+#endif
+    n_.clear();
+}
+
+complex<double> PSATD_Solver::timeIntegral( double x )
+{
+    if( abs( x*dt_ ) < 1.e-6 ) {
+        return dt_ * complex<double>( 1., 0.5*x*dt_ );
+    }
+    return ( exp( complex<double>( 0., x*dt_ ) ) - 1. ) / complex<double>( 0., x );
+}
+
+void PSATD_Solver::prepare( vector<unsigned int> n )
+{
+#ifdef _FFTW
+    uncoupling();
+
+    // The 2D fields are seen as 3D fields with a single point along z
+    n_.resize( 3, 1 );
+    for( unsigned int i=0 ; i<ndim_ ; i++ ) {
+        n_[i] = n[i];
+    }
+    nk2_ = n_[2]/2 + 1;
+    nreal_    = ( size_t )n_[0]*n_[1]*n_[2];
+    ncomplex_ = ( size_t )n_[0]*n_[1]*nk2_;
+
+    real_ = fftw_alloc_real( nreal_ );
+    for( unsigned int ic=0 ; ic<10 ; ic++ ) {
+        spectrum_[ic] = reinterpret_cast<complex<double> *>( fftw_alloc_complex( ncomplex_ ) );
+    }
+    // The planner is not thread safe
+    #pragma omp critical (fftw_planner)
+    {
+        forward_  = fftw_plan_dft_r2c_3d( n_[0], n_[1], n_[2], real_, reinterpret_cast<fftw_complex *>( spectrum_[0] ), FFTW_ESTIMATE );
+        backward_ = fftw_plan_dft_c2r_3d( n_[0], n_[1], n_[2], reinterpret_cast<fftw_complex *>( spectrum_[0] ), real_, FFTW_ESTIMATE );
+    }
+
+    // Wave numbers, and shift of half a cell from the dual nodes (at -dx/2) to the primal nodes
+    for( unsigned int d=0 ; d<3 ; d++ ) {
+        unsigned int nk = ( d==2 ) ? nk2_ : n_[d];
+        k_[d].resize( nk );
+        shift_[d].resize( nk );
+        nyquist_[d].resize( nk );
+        for( unsigned int i=0 ; i<nk ; i++ ) {
+            int m = ( i <= n_[d]/2 ) ? ( int )i : ( int )i - ( int )n_[d];
+            k_[d][i] = 2.*M_PI*m / ( n_[d]*cell_length_[d] );
+            shift_[d][i] = exp( complex<double>( 0., 0.5*k_[d][i]*cell_length_[d] ) );
+            nyquist_[d][i] = ( n_[d]%2 == 0 ) && ( 2*i == n_[d] );
+        }
+    }
+
+    // Coefficients of the update, the currents move at v_ during the timestep
+    C_.resize( ncomplex_ );
+    S_.resize( ncomplex_ );
+    Jc_.resize( ncomplex_ );
+    Js_.resize( ncomplex_ );
+    for( unsigned int i=0 ; i<n_[0] ; i++ ) {
+        for( unsigned int j=0 ; j<n_[1] ; j++ ) {
+            for( unsigned int l=0 ; l<nk2_ ; l++ ) {
+                size_t idx = ( ( size_t )i*n_[1] + j )*nk2_ + l;
+                double k = sqrt( k_[0][i]*k_[0][i] + k_[1][j]*k_[1][j] + k_[2][l]*k_[2][l] );
+                double w = k_[0][i]*v_[0] + k_[1][j]*v_[1] + k_[2][l]*v_[2];
+                C_[idx] = cos( k*dt_ );
+                S_[idx] = sin( k*dt_ );
+                complex<double> phase = exp( complex<double>( 0., -0.5*w*dt_ ) );
+                complex<double> gp = timeIntegral( w + k );
+                complex<double> gm = timeIntegral( w - k );
+                // integrals over the timestep of cos(k(dt-t)) and sin(k(dt-t)) times the currents
+                Jc_[idx] = phase * 0.5 * ( gp + gm );
+                Js_[idx] = phase * ( gp - gm ) / complex<double>( 0., 2. );
+            }
+        }
+    }
+#else
+    SMILEI_UNUSED( n );
+    ERROR( "The PSATD solver requires Smilei to be compiled with FFTW (make config=fftw)" );
+#endif
+}
+
+void PSATD_Solver::operator()( ElectroMagn *fields )
+{
+#ifdef _FFTW
+    bool prepared = ( n_.size() == 3 );
+    for( unsigned int i=0 ; prepared && i<ndim_ ; i++ ) {
+        prepared = ( n_[i] == fields->dimPrim[i] );
+    }
+    if( !prepared ) {
+        prepare( fields->dimPrim );
+    }
+
+    Field *F[10] = { fields->Ex_, fields->Ey_, fields->Ez_, fields->Bx_, fields->By_, fields->Bz_,
+                     fields->Jx_, fields->Jy_, fields->Jz_, fields->rho_ };
+
+    for( unsigned int ic=0 ; ic<10 ; ic++ ) {
+        memcpy( real_, F[ic]->data(), nreal_*sizeof( double ) );
+        fftw_execute_dft_r2c( forward_, real_, reinterpret_cast<fftw_complex *>( spectrum_[ic] ) );
+    }
+
+    const complex<double> I( 0., 1. );
+    const double norm = 1. / nreal_;
+
+    for( unsigned int i=0 ; i<n_[0] ; i++ ) {
+        for( unsigned int j=0 ; j<n_[1] ; j++ ) {
+            for( unsigned int l=0 ; l<nk2_ ; l++ ) {
+                size_t idx = ( ( size_t )i*n_[1] + j )*nk2_ + l;
+
+                if( nyquist_[0][i] || nyquist_[1][j] || nyquist_[2][l] ) {
+                    for( unsigned int ic=0 ; ic<6 ; ic++ ) {
+                        spectrum_[ic][idx] = 0.;
+                    }
+                    continue;
+                }
+
+                const complex<double> sx = shift_[0][i], sy = shift_[1][j], sz = shift_[2][l];
+
+                // Fields on the primal nodes: Ex^(d,p,p), Ey^(p,d,p), Ez^(p,p,d), Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+                complex<double> Ex = spectrum_[0][idx]*sx;
+                complex<double> Ey = spectrum_[1][idx]*sy;
+                complex<double> Ez = spectrum_[2][idx]*sz;
+                complex<double> Bx = spectrum_[3][idx]*sy*sz;
+                complex<double> By = spectrum_[4][idx]*sx*sz;
+                complex<double> Bz = spectrum_[5][idx]*sx*sy;
+                complex<double> Jx = spectrum_[6][idx]*sx;
+                complex<double> Jy = spectrum_[7][idx]*sy;
+                complex<double> Jz = spectrum_[8][idx]*sz;
+                complex<double> rho = spectrum_[9][idx];
+
+                const double kx = k_[0][i], ky = k_[1][j], kz = k_[2][l];
+                const double k = sqrt( kx*kx + ky*ky + kz*kz );
+
+                complex<double> Ex_new, Ey_new, Ez_new, Bx_new, By_new, Bz_new;
+                if( k == 0. ) {
+                    Ex_new = Ex - dt_*Jx;
+                    Ey_new = Ey - dt_*Jy;
+                    Ez_new = Ez - dt_*Jz;
+                    Bx_new = Bx;
+                    By_new = By;
+                    Bz_new = Bz;
+                } else {
+                    const double ux = kx/k, uy = ky/k, uz = kz/k;
+                    const double C = C_[idx], S = S_[idx];
+                    const complex<double> Jc = Jc_[idx], Js = Js_[idx];
+
+                    // Transverse parts of E, B and J
+                    const complex<double> uE = ux*Ex + uy*Ey + uz*Ez;
+                    const complex<double> uB = ux*Bx + uy*By + uz*Bz;
+                    const complex<double> uJ = ux*Jx + uy*Jy + uz*Jz;
+                    const complex<double> ETx = Ex - ux*uE, ETy = Ey - uy*uE, ETz = Ez - uz*uE;
+                    const complex<double> BTx = Bx - ux*uB, BTy = By - uy*uB, BTz = Bz - uz*uB;
+                    const complex<double> JTx = Jx - ux*uJ, JTy = Jy - uy*uJ, JTz = Jz - uz*uJ;
+
+                    // Longitudinal part of E from Gauss's law
+                    const complex<double> EL = -I*rho/k;
+
+                    // Rotationals divided by k
+                    const complex<double> uBx = uy*Bz - uz*By, uBy = uz*Bx - ux*Bz, uBz = ux*By - uy*Bx;
+                    const complex<double> uEx = uy*Ez - uz*Ey, uEy = uz*Ex - ux*Ez, uEz = ux*Ey - uy*Ex;
+                    const complex<double> uJx = uy*Jz - uz*Jy, uJy = uz*Jx - ux*Jz, uJz = ux*Jy - uy*Jx;
+
+                    Ex_new = C*ETx + I*S*uBx - Jc*JTx + ux*EL;
+                    Ey_new = C*ETy + I*S*uBy - Jc*JTy + uy*EL;
+                    Ez_new = C*ETz + I*S*uBz - Jc*JTz + uz*EL;
+                    // The longitudinal part of B is left unchanged
+                    Bx_new = C*BTx + ux*uB - I*S*uEx + I*Js*uJx;
+                    By_new = C*BTy + uy*uB - I*S*uEy + I*Js*uJy;
+                    Bz_new = C*BTz + uz*uB - I*S*uEz + I*Js*uJz;
+                }
+
+                // Back to the staggered nodes, normalized for the backward transform
+                spectrum_[0][idx] = Ex_new*conj( sx )*norm;
+                spectrum_[1][idx] = Ey_new*conj( sy )*norm;
+                spectrum_[2][idx] = Ez_new*conj( sz )*norm;
+                spectrum_[3][idx] = Bx_new*conj( sy*sz )*norm;
+                spectrum_[4][idx] = By_new*conj( sx*sz )*norm;
+                spectrum_[5][idx] = Bz_new*conj( sx*sy )*norm;
+            }
+        }
+    }
+
+    for( unsigned int ic=0 ; ic<6 ; ic++ ) {
+        fftw_execute_dft_c2r( backward_, reinterpret_cast<fftw_complex *>( spectrum_[ic] ), real_ );
+        memcpy( F[ic]->data(), real_, nreal_*sizeof( double ) );
+    }
+#else
+    SMILEI_UNUSED( fields );
+    ERROR( "The PSATD solver requires Smilei to be compiled with FFTW (make config=fftw)" );
+#endif
+}
@@ -0,0 +1,73 @@
+#ifndef PSATD_SOLVER_H
+#define PSATD_SOLVER_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "Solver.h"
+class ElectroMagn;
+struct fftw_plan_s;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PSATD_Solver
+//! Pseudo-spectral analytical time-domain solver (2D and 3D cartesian geometries), without picsar: the fields of the
+//! region (MultipleDecomposition is required), ghost cells included, are Fourier transformed with FFTW and
+//! advanced analytically over a timestep. E, B and J are staggered as in the Yee scheme, with arrays of the same size
+//! (see Params::is_pxr): they are shifted to the primal nodes in Fourier space before the update, and back after.
+//!     - the transverse fields are advanced exactly, the currents being constant during the timestep, or moving at
+//!       Main.galilean_velocity
+//!     - the longitudinal electric field is given by Gauss's law from the charge density at the end of the timestep
+//  --------------------------------------------------------------------------------------------------------------------
+class PSATD_Solver : public Solver
+{
+
+public:
+    //! Creator for PSATD_Solver
+    PSATD_Solver( Params &params );
+    virtual ~PSATD_Solver();
+
+    //! Prepare the Fourier transforms and the coefficients of the update for the fields of EMfields
+    void coupling( Params &params, ElectroMagn *EMfields, bool full_domain = false ) override;
+    //! Free the Fourier transforms
+    void uncoupling() override;
+    //! Overloading of () operator: advances E and B by one timestep
+    virtual void operator()( ElectroMagn *fields ) override;
+
+protected:
+    //! Allocate the buffers, create the Fourier transforms and compute the coefficients for a grid of size n
+    void prepare( std::vector<unsigned int> n );
+    //! (exp(i x dt)-1)/(i x)
+    std::complex<double> timeIntegral( double x );
+
+    unsigned int ndim_;
+    double dt_;
+    std::vector<double> cell_length_;
+    //! Velocity of the currents during a timestep
+    std::vector<double> v_;
+
+    //! Size of the real grid (3 directions, 1 for the unused ones) and of its Fourier transform
+    std::vector<unsigned int> n_;
+    size_t nreal_, ncomplex_;
+    //! Last dimension of the Fourier transform (real to complex)
+    unsigned int nk2_;
+
+    //! Wave numbers along each direction
+    std::vector<double> k_[3];
+    //! Shift from the dual to the primal nodes along each direction, in Fourier space
+    std::vector<std::complex<double> > shift_[3];
+    //! Nyquist modes along each direction (discarded)
+    std::vector<bool> nyquist_[3];
+
+    //! Coefficients of each mode: cos(k dt), sin(k dt) and the time integrals of the currents
+    std::vector<double> C_, S_;
+    std::vector<std::complex<double> > Jc_, Js_;
+
+    //! Real buffer and spectra of Ex, Ey, Ez, Bx, By, Bz, Jx, Jy, Jz, rho
+    double *real_;
+    std::complex<double> *spectrum_[10];
+    fftw_plan_s *forward_, *backward_;
+
+};//END class
+
+#endif
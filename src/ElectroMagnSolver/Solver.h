@@ -23,6 +23,8 @@ public:
     virtual void densities_correction( ElectroMagn * ) {};
     //! Overloading of () operator
     virtual void operator()( ElectroMagn * ) = 0;
+    //! Advance E and B by several time steps without currents (temporal blocking)
+    virtual void advanceVacuum( ElectroMagn *, unsigned int ) {ERROR("No temporal blocking with this solver");};
 
     virtual void setDomainSizeAndCoefficients( int, int, std::vector<unsigned int>, int, int, int*, int*, Patch* ) {ERROR("Not using PML");};
     virtual void compute_E_from_D( ElectroMagn *, int, int, std::vector<unsigned int>, unsigned int, unsigned int ) {ERROR("Not using PML");};
@@ -9,6 +9,7 @@
 #include "MA_Solver3D_Friedman.h"
 #include "MA_SolverAM_norm.h"
 #include "MA_SolverAM_Friedman.h"
+#include "MA_MF_Solver3D_Yee.h"
 #include "MF_Solver1D_Yee.h"
 #include "MF_Solver2D_Yee.h"
 #include "MF_Solver3D_Yee.h"
@@ -30,6 +31,7 @@
 #include "PXR_Solver3D_FDTD.h"
 #include "PXR_Solver3D_GPSTD.h"
 #include "PXR_SolverAM_GPSTD.h"
+#include "PSATD_Solver.h"
 
 #include "PML_Solver2D_Bouchard.h"
 #include "PML_Solver2D_Yee.h"
@@ -66,7 +68,9 @@ public:
 
         } else if( params.geometry == "2Dcartesian" ) {
 
-            if( params.is_spectral ) {
+            if( params.maxwell_sol == "PSATD" ) {
+                solver = new PSATD_Solver( params );
+            } else if( params.is_spectral ) {
                 solver = new PXR_Solver2D_GPSTD( params );
             } else if( params.Friedman_filter ) {
                 if ( (params.maxwell_sol != "Yee") && (params.maxwell_sol != "Bouchard") && (params.maxwell_sol != "Grassi") && (params.maxwell_sol != "GrassiSpL") ){
@@ -80,7 +84,9 @@ public:
         } else if( params.geometry == "3Dcartesian" ) {
 
             if( params.is_spectral ) {
-                if( params.is_pxr ) {
+                if( params.maxwell_sol == "PSATD" ) {
+                    solver = new PSATD_Solver( params );
+                } else if( params.is_pxr ) {
                     solver = new PXR_Solver3D_GPSTD( params );
                 } else {
                     ERROR( "Spectral solver not available without Picsar" );
@@ -122,6 +128,26 @@ public:
         return solver;
     };
 
+    // Create a solver doing both Maxwell-Ampere and Maxwell-Faraday in one sweep, for a single time step
+    // (NULL when not available, the two solvers are then called one after the other)
+    // ----------------------------------------------------------------------------
+    static Solver *createMAMF( Params &params )
+    {
+        Solver *solver = NULL;
+
+#ifndef SMILEI_ACCELERATOR_GPU
+        if( params.geometry == "3Dcartesian"
+            && params.maxwell_sol == "Yee"
+            && !params.is_spectral
+            && !params.is_pxr
+            && !params.Friedman_filter ) {
+            solver = new MA_MF_Solver3D_Yee( params );
+        }
+#endif
+
+        return solver;
+    };
+
     // Create Maxwell-Faraday solver
     // -----------------------------
     static Solver *createMF( Params &params )
@@ -82,6 +82,9 @@ public:
     //! Virtual method to deallocate Field
     virtual void deallocateDataAndSetTo( Field* f ) = 0;
 
+    //! Virtual method to free the data of a Field, it can be allocated again with allocateDims
+    virtual void deallocateDims() = 0;
+
     //! Virtual method to shift field in space
     virtual void shift_x( unsigned int delta ) = 0;
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstring>
 
+#include "FieldBufferPool.h"
 #include "Params.h"
 #include "SmileiMPI.h"
 #include "Patch.h"
@@ -78,7 +79,7 @@ Field1D::~Field1D()
         }
     }
     if( data_!=NULL ) {
-        delete [] data_;
+        FieldBufferPool<double>::release( data_, number_of_points_ );
     }
 }
 
@@ -95,7 +96,7 @@ void Field1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[ dims_[0] ];
+    data_ = FieldBufferPool<double>::acquire( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         data_[i]=0.0;
@@ -113,6 +114,24 @@ void Field1D::deallocateDataAndSetTo( Field* f )
     data_ = f->data_;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a Field1D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void Field1D::deallocateDims()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<double>::release( data_, number_of_points_ );
+    data_ = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0];
+}
+
 
 void Field1D::allocateDims( unsigned int dims1 )
 {
@@ -147,7 +166,7 @@ void Field1D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[ dims_[0] ];
+    data_ = FieldBufferPool<double>::acquire( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         data_[i]=0.0;
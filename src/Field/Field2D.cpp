@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 
+#include "FieldBufferPool.h"
 #include "Params.h"
 #include "Patch.h"
 #include "SmileiMPI.h"
@@ -90,7 +91,7 @@ Field2D::~Field2D()
         }
     }
     if( data_!=NULL ) {
-        delete [] data_;
+        FieldBufferPool<double>::release( data_, number_of_points_ );
         delete [] data_2D;
     }
 }
@@ -110,7 +111,7 @@ void Field2D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = FieldBufferPool<double>::acquire( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D = new double *[dims_[0]];
@@ -137,6 +138,26 @@ void Field2D::deallocateDataAndSetTo( Field* f )
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a Field2D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void Field2D::deallocateDims()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<double>::release( data_, number_of_points_ );
+    data_ = NULL;
+    delete [] data_2D;
+    data_2D = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0]*dims_[1];
+}
+
 void Field2D::allocateDims( unsigned int dims1, unsigned int dims2 )
 {
     std::vector<unsigned int> dims( 2 );
@@ -171,7 +192,7 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = FieldBufferPool<double>::acquire( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
 
     data_2D = new double *[dims_[0]];
@@ -8,6 +8,7 @@
 #include <openacc.h>
 #endif
 
+#include "FieldBufferPool.h"
 #include "Params.h"
 #include "Patch.h"
 #include "SmileiMPI.h"
@@ -105,7 +106,7 @@ Field3D::~Field3D()
 #if defined(SMILEI_ACCELERATOR_GPU_OACC)
         #pragma acc exit data delete (data_[0:number_of_points_]) if (acc_deviceptr(data_) != NULL)
 #endif
-        delete [] data_;
+        FieldBufferPool<double>::release( data_, number_of_points_ );
         for( unsigned int i=0; i<dims_[0]; i++ ) {
             delete [] this->data_3D[i];
         }
@@ -128,7 +129,7 @@ void Field3D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = FieldBufferPool<double>::acquire( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
@@ -160,6 +161,29 @@ void Field3D::deallocateDataAndSetTo( Field* f )
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a Field3D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void Field3D::deallocateDims()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<double>::release( data_, number_of_points_ );
+    data_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0]*dims_[1]*dims_[2];
+}
+
 
 void Field3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
@@ -197,7 +221,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = FieldBufferPool<double>::acquire( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]*dims_[1]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
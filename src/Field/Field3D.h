@@ -39,6 +39,7 @@ public:
     //! Method used to allocate a Field3D
     void allocateDims() override;
     void deallocateDataAndSetTo( Field* f ) override;
+    void deallocateDims() override;
     //! a Field3D can also be initialized win three unsigned int
     void allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 );
     //! allocate dimensions for field3D isPrimal define if mainDim is Primal or Dual
@@ -0,0 +1,96 @@
+#ifndef FIELDBUFFERPOOL_H
+#define FIELDBUFFERPOOL_H
+
+#include <map>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class FieldBufferPool
+//! Pool of field data buffers, used by the moving window to recycle the memory of the patches which leave the box at
+//! xmin for the patches created at xmax, instead of freeing and reallocating all fields at each shift.
+//!     - buffers are kept only while the pool is collecting (deletion of the patches in SimWindow::shift)
+//!     - buffers not reused at the next shift are freed when the pool starts collecting again
+//!     - all remaining buffers are freed by clear(), after load balancing and at the end of the run
+//! All buffers are allocated with new[] so that a buffer taken from the pool may be freed with delete[].
+//  --------------------------------------------------------------------------------------------------------------------
+template<typename T>
+class FieldBufferPool
+{
+public:
+    //! Return a buffer of n elements, taken from the pool if possible (content is not initialized)
+    static T *acquire( unsigned int n )
+    {
+        T *buffer = NULL;
+        #pragma omp critical (field_buffer_pool)
+        {
+            typename std::multimap<unsigned int, T *>::iterator it = buffers_.find( n );
+            if( it != buffers_.end() ) {
+                buffer = it->second;
+                buffers_.erase( it );
+            }
+        }
+        if( buffer == NULL ) {
+            buffer = new T[n];
+        }
+        return buffer;
+    }
+
+    //! Give back a buffer of n elements : kept in the pool if it is collecting, freed otherwise
+    static void release( T *buffer, unsigned int n )
+    {
+        bool kept = false;
+        #pragma omp critical (field_buffer_pool)
+        {
+            if( collecting_ ) {
+                buffers_.insert( std::make_pair( n, buffer ) );
+                kept = true;
+            }
+        }
+        if( !kept ) {
+            delete [] buffer;
+        }
+    }
+
+    //! Free the buffers which were not reused, then keep the next released ones
+    static void startCollecting()
+    {
+        #pragma omp critical (field_buffer_pool)
+        {
+            freeBuffers();
+            collecting_ = true;
+        }
+    }
+
+    static void stopCollecting()
+    {
+        #pragma omp critical (field_buffer_pool)
+        collecting_ = false;
+    }
+
+    //! Free all the buffers of the pool
+    static void clear()
+    {
+        #pragma omp critical (field_buffer_pool)
+        freeBuffers();
+    }
+
+private:
+    static void freeBuffers()
+    {
+        for( typename std::multimap<unsigned int, T *>::iterator it = buffers_.begin() ; it != buffers_.end() ; it++ ) {
+            delete [] it->second;
+        }
+        buffers_.clear();
+    }
+
+    //! Free buffers sorted by number of elements
+    static std::multimap<unsigned int, T *> buffers_;
+    static bool collecting_;
+};
+
+template<typename T>
+std::multimap<unsigned int, T *> FieldBufferPool<T>::buffers_;
+
+template<typename T>
+bool FieldBufferPool<T>::collecting_ = false;
+
+#endif
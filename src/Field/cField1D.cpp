@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstring>
 
+#include "FieldBufferPool.h"
 #include "Params.h"
 #include "SmileiMPI.h"
 #include "Patch.h"
@@ -78,7 +79,7 @@ cField1D::~cField1D()
         }
     }
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
     }
 }
 
@@ -95,7 +96,7 @@ void cField1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[ dims_[0] ];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         cdata_[i]=0.0;
@@ -114,6 +115,24 @@ void cField1D::deallocateDataAndSetTo( Field* f )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a cField1D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void cField1D::deallocateDims()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
+    cdata_ = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0];
+}
+
 
 void cField1D::allocateDims( unsigned int dims1 )
 {
@@ -148,7 +167,7 @@ void cField1D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[ dims_[0] ];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         cdata_[i]=0.0;
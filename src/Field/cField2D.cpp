@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstring>
 
+#include "FieldBufferPool.h"
 #include "Params.h"
 #include "SmileiMPI.h"
 #include "Patch.h"
@@ -88,7 +89,7 @@ cField2D::~cField2D()
         }
     }
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
         delete [] data_2D;
     }
 }
@@ -109,7 +110,7 @@ void cField2D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0]*dims_[1] );
     
     data_2D= new complex<double> *[dims_[0]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
@@ -136,6 +137,26 @@ void cField2D::deallocateDataAndSetTo( Field* f )
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a cField2D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void cField2D::deallocateDims()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
+    cdata_ = NULL;
+    delete [] data_2D;
+    data_2D = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0]*dims_[1];
+}
+
 void cField2D::allocateDims( unsigned int dims1, unsigned int dims2 )
 {
     vector<unsigned int> dims( 2 );
@@ -171,7 +192,7 @@ void cField2D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new complex<double> *[dims_[0]];
@@ -4,6 +4,8 @@
 #include <vector>
 #include <cstring>
 
+#include "FieldBufferPool.h"
+
 using namespace std;
 
 
@@ -76,7 +78,7 @@ cField3D::~cField3D()
         }
     }
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
         for( unsigned int i=0; i<dims_[0]; i++ ) {
             delete [] data_3D[i];
         }
@@ -100,7 +102,7 @@ void cField3D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]*dims_[2]];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0]*dims_[1]*dims_[2] );
     
     data_3D= new complex<double> **[dims_[0]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
@@ -128,6 +130,29 @@ void cField3D::deallocateDataAndSetTo( Field* f )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Free the data of a cField3D, the buffer goes back to the FieldBufferPool
+// ---------------------------------------------------------------------------------------------------------------------
+void cField3D::deallocateDims()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    FieldBufferPool<complex<double>>::release( cdata_, number_of_points_ );
+    cdata_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+    // Back to the dimensions given at construction, allocateDims( mainDim, isPrimal ) can be called again
+    for( unsigned int j=0 ; j<isDual_.size() ; j++ ) {
+        dims_[j] -= isDual_[j];
+    }
+    isDual_.clear();
+    number_of_points_ = dims_[0]*dims_[1]*dims_[2];
+}
+
 void cField3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
     vector<unsigned int> dims( 3 );
@@ -164,7 +189,7 @@ void cField3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]*dims_[2]];
+    cdata_ = FieldBufferPool<complex<double>>::acquire( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!! (JD)}
     
     data_3D= new complex<double> **[dims_[0]];
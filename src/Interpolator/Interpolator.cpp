@@ -8,3 +8,70 @@
 
 using namespace std;
 
+
+void InterpolationStencils::resize( unsigned int ndim, unsigned int nnodes, unsigned int npoints )
+{
+    ndim_    = ndim;
+    nnodes_  = nnodes;
+    npoints_ = npoints;
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        for( unsigned int dual=0; dual<2; dual++ ) {
+            index_ [idim][dual].resize( idim<ndim ? npoints : 0 );
+            weight_[idim][dual].resize( idim<ndim ? npoints*nnodes : 0 );
+        }
+    }
+}
+
+// Same order of the operations as the compute() methods of the interpolators
+void InterpolationStencils::gather( Field *field, double *FieldLoc ) const
+{
+    const double *const __restrict__ f = field->data_;
+    const int n = nnodes_;
+    
+    if( ndim_ == 1 ) {
+        const int    *const __restrict__ i0 = index_ [0][field->isDual( 0 )].data();
+        const double *const __restrict__ w0 = weight_[0][field->isDual( 0 )].data();
+        for( unsigned int ip=0; ip<npoints_; ip++ ) {
+            double interp_res = 0.;
+            for( int a=0; a<n; a++ ) {
+                interp_res += w0[ip*n+a] * f[i0[ip]+a];
+            }
+            FieldLoc[ip] = interp_res;
+        }
+    } else if( ndim_ == 2 ) {
+        const int dim1 = field->dims_[1];
+        const int    *const __restrict__ i0 = index_ [0][field->isDual( 0 )].data();
+        const double *const __restrict__ w0 = weight_[0][field->isDual( 0 )].data();
+        const int    *const __restrict__ i1 = index_ [1][field->isDual( 1 )].data();
+        const double *const __restrict__ w1 = weight_[1][field->isDual( 1 )].data();
+        for( unsigned int ip=0; ip<npoints_; ip++ ) {
+            double interp_res = 0.;
+            for( int a=0; a<n; a++ ) {
+                for( int b=0; b<n; b++ ) {
+                    interp_res += w0[ip*n+a] * w1[ip*n+b] * f[( i0[ip]+a )*dim1 + i1[ip]+b];
+                }
+            }
+            FieldLoc[ip] = interp_res;
+        }
+    } else {
+        const int dim1 = field->dims_[1];
+        const int dim2 = field->dims_[2];
+        const int    *const __restrict__ i0 = index_ [0][field->isDual( 0 )].data();
+        const double *const __restrict__ w0 = weight_[0][field->isDual( 0 )].data();
+        const int    *const __restrict__ i1 = index_ [1][field->isDual( 1 )].data();
+        const double *const __restrict__ w1 = weight_[1][field->isDual( 1 )].data();
+        const int    *const __restrict__ i2 = index_ [2][field->isDual( 2 )].data();
+        const double *const __restrict__ w2 = weight_[2][field->isDual( 2 )].data();
+        for( unsigned int ip=0; ip<npoints_; ip++ ) {
+            double interp_res = 0.;
+            for( int a=0; a<n; a++ ) {
+                for( int b=0; b<n; b++ ) {
+                    for( int c=0; c<n; c++ ) {
+                        interp_res += w0[ip*n+a] * w1[ip*n+b] * w2[ip*n+c] * f[( ( i0[ip]+a )*dim1 + i1[ip]+b )*dim2 + i2[ip]+c];
+                    }
+                }
+            }
+            FieldLoc[ip] = interp_res;
+        }
+    }
+}
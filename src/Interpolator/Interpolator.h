@@ -10,6 +10,42 @@ class ElectroMagn;
 class Particles;
 
 
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class InterpolationStencils
+//! Interpolation stencils of a set of fixed points (probes), separable along each direction: for each direction,
+//! primal (0) or dual (1) grid and point, the index of the first node and the weights of the nnodes nodes
+//  --------------------------------------------------------------------------------------------------------------------
+class InterpolationStencils
+{
+public:
+    InterpolationStencils() : ndim_( 0 ), nnodes_( 0 ), npoints_( 0 ) {};
+    
+    void resize( unsigned int ndim, unsigned int nnodes, unsigned int npoints );
+    
+    //! Store the stencil of the point ipoint along the direction idim, from the index of its central node
+    //! and the weights of the nnodes nodes
+    inline void set( unsigned int idim, unsigned int dual, unsigned int ipoint, int central_index, double *weights )
+    {
+        index_[idim][dual][ipoint] = central_index - ( int )( nnodes_/2 );
+        for( unsigned int i=0; i<nnodes_; i++ ) {
+            weight_[idim][dual][ipoint*nnodes_+i] = weights[i];
+        }
+    }
+    
+    //! Interpolate a field at all points
+    void gather( Field *field, double *FieldLoc ) const;
+    
+    unsigned int size() const
+    {
+        return npoints_;
+    }
+    
+private:
+    unsigned int ndim_, nnodes_, npoints_;
+    std::vector<int> index_[3][2];
+    std::vector<double> weight_[3][2];
+};
+
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class Interpolator
 //  --------------------------------------------------------------------------------------------------------------------
@@ -24,6 +60,13 @@ public:
     virtual void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) = 0;
     virtual void oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1=NULL, double *l2=NULL, double *l3=NULL ) =0;
     
+    //! Stencils of all particles, so that fields can be interpolated at their positions by InterpolationStencils::gather
+    //! \return false if not available with this interpolator
+    virtual bool stencils( Particles &, InterpolationStencils & )
+    {
+        return false;
+    };
+    
     virtual void fieldsAndEnvelope( ElectroMagn *, Particles &, SmileiMPI *, int *, int *, int , int = 0 )
     {
         ERROR( "Envelope not implemented with this geometry and this order" );
@@ -162,6 +162,24 @@ void Interpolator1D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of fixed points (probes), interpolated as in oneField
+bool Interpolator1D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    int idx_p[1], idx_d[1];
+    double delta_p[1];
+    double coeffxp[3];
+    double coeffxd[3];
+    
+    stencils.resize( 1, 3, particles.size() );
+    for( unsigned int ipart=0 ; ipart<particles.size(); ipart++ ) {
+        double xpn = particles.position( 0, ipart )*dx_inv_;
+        coeffs( xpn, idx_p, idx_d, coeffxp, coeffxd, delta_p );
+        stencils.set( 0, 0, ipart, idx_p[0], coeffxp );
+        stencils.set( 0, 1, ipart, idx_d[0], coeffxd );
+    }
+    return true;
+}
+
 void Interpolator1D2Order::fieldsWrapper( ElectroMagn *EMfields,
                                           Particles &particles, SmileiMPI *smpi,
                                           int *istart, int *iend, int ithread, unsigned int, int )
@@ -152,6 +152,27 @@ void Interpolator2D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of fixed points (probes), interpolated as in oneField
+bool Interpolator2D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    int idx_p[2], idx_d[2];
+    double delta_p[2];
+    double coeffxp[3], coeffyp[3];
+    double coeffxd[3], coeffyd[3];
+    
+    stencils.resize( 2, 3, particles.size() );
+    for( unsigned int ipart=0 ; ipart<particles.size(); ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        coeffs( xpn, ypn, idx_p, idx_d, coeffxp, coeffyp, coeffxd, coeffyd, delta_p );
+        stencils.set( 0, 0, ipart, idx_p[0], coeffxp );
+        stencils.set( 0, 1, ipart, idx_d[0], coeffxd );
+        stencils.set( 1, 0, ipart, idx_p[1], coeffyp );
+        stencils.set( 1, 1, ipart, idx_d[1], coeffyd );
+    }
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 //! Wrapper called by the particle dynamics section
 // -----------------------------------------------------------------------------
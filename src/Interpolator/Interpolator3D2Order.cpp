@@ -160,6 +160,30 @@ void Interpolator3D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of fixed points (probes), interpolated as in oneField
+bool Interpolator3D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    int    idx_p[3], idx_d[3];
+    double delta_p[3];
+    double coeffxp[3], coeffyp[3], coeffzp[3];
+    double coeffxd[3], coeffyd[3], coeffzd[3];
+    
+    stencils.resize( 3, 3, particles.size() );
+    for( unsigned int ipart=0 ; ipart<particles.size(); ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        double zpn = particles.position( 2, ipart )*d_inv_[2];
+        coeffs( xpn, ypn, zpn, idx_p, idx_d, coeffxp, coeffyp, coeffzp, coeffxd, coeffyd, coeffzd, delta_p );
+        stencils.set( 0, 0, ipart, idx_p[0], coeffxp );
+        stencils.set( 0, 1, ipart, idx_d[0], coeffxd );
+        stencils.set( 1, 0, ipart, idx_p[1], coeffyp );
+        stencils.set( 1, 1, ipart, idx_d[1], coeffyd );
+        stencils.set( 2, 0, ipart, idx_p[2], coeffzp );
+        stencils.set( 2, 1, ipart, idx_d[2], coeffzd );
+    }
+    return true;
+}
+
 void Interpolator3D2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
     const int nparts = particles.numberOfParticles();
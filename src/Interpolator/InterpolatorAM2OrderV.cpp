@@ -26,6 +26,8 @@ InterpolatorAM2OrderV::InterpolatorAM2OrderV( Params &params, Patch *patch ) : I
     nscellr_ = params.patch_size_[1] + 1;
     oversize_[0] = params.oversize[0];
     oversize_[1] = params.oversize[1];
+    exp_mm_theta_re_.resize( nmodes_*32 );
+    exp_mm_theta_im_.resize( nmodes_*32 );
 }
 
 void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int scell, int ipart_ref )
@@ -63,7 +65,10 @@ void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
    
     int cell_nparts( ( int )iend[0]-( int )istart[0] );
 
-    std::vector<complex<double>> exp_m_theta_( vecSize), exp_mm_theta( vecSize) ;                                                          //exp(-i theta), exp(-i m theta)
+    // exp(-i theta) and exp(-i m theta) for all modes, as separate real and imaginary parts ([imode*vecSize+ipart])
+    double exp_m_theta_re[32], exp_m_theta_im[32];
+    double * __restrict__ exp_mm_theta_re = exp_mm_theta_re_.data();
+    double * __restrict__ exp_mm_theta_im = exp_mm_theta_im_.data();
 
     //Loop on groups of vecSize particles
     for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
@@ -79,9 +84,9 @@ void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
         
             int ipart2 = ipart+ivect+istart[0];
             double r = sqrt( position_y[ipart2]*position_y[ipart2] + position_z[ipart2]*position_z[ipart2] );
-            exp_m_theta_[ipart] = ( position_y[ipart2] - Icpx * position_z[ipart2] ) / r ;
-            exp_mm_theta[ipart] = 1. ;
-            eitheta_old[ipart] =  2.*std::real(exp_m_theta_[ipart]) - exp_m_theta_[ipart] ;  //exp(i theta)
+            exp_m_theta_re[ipart] =  position_y[ipart2] / r ;
+            exp_m_theta_im[ipart] = -position_z[ipart2] / r ;
+            eitheta_old[ipart] = std::complex<double>( exp_m_theta_re[ipart], -exp_m_theta_im[ipart] ) ;  //exp(i theta)
 
             // i= 0 ==> X
             //             j=0 primal
@@ -118,9 +123,18 @@ void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             coeff[1][1][0][ipart]    =  0.5 * ( delta2-delta+0.25 );
             coeff[1][1][1][ipart]    = ( 0.75 - delta2 );
             coeff[1][1][2][ipart]    =  0.5 * ( delta2+delta+0.25 );
+
+            //exp(-i m theta) for all modes
+            exp_mm_theta_re[ipart] = 1.;
+            exp_mm_theta_im[ipart] = 0.;
+            for( unsigned int imode = 1; imode < nmodes_ ; imode++ ) {
+                int k = imode*vecSize+ipart;
+                exp_mm_theta_re[k] = exp_mm_theta_re[k-vecSize]*exp_m_theta_re[ipart] - exp_mm_theta_im[k-vecSize]*exp_m_theta_im[ipart];
+                exp_mm_theta_im[k] = exp_mm_theta_re[k-vecSize]*exp_m_theta_im[ipart] + exp_mm_theta_im[k-vecSize]*exp_m_theta_re[ipart];
+            }
         }
 
-        double interp_res;
+        double interp_re, interp_im;
         double * __restrict__ coeffld = &( coeff[0][1][1][0] );
         double * __restrict__ coefflp = &( coeff[0][0][1][0] );
         double * __restrict__ coeffrp = &( coeff[1][0][1][0] );
@@ -136,8 +150,8 @@ void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             }
         }
 
-        // Local buffer to store the field components
-        std::complex<double> field_buffer[4][4];
+        // Local buffers to store the real and imaginary parts of the field components
+        double field_re[4][4], field_im[4][4];
 
         for( unsigned int imode = 0; imode < nmodes_ ; imode++ ) {
             // Static cast of the electromagnetic fields
@@ -148,162 +162,168 @@ void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &par
             cField2D * __restrict__ Br = ( static_cast<ElectroMagnAM *>( EMfields ) )->Br_m[imode];
             cField2D * __restrict__ Bt = ( static_cast<ElectroMagnAM *>( EMfields ) )->Bt_m[imode];
 
-
+            double * __restrict__ cos_m = &( exp_mm_theta_re[imode*vecSize] );
+            double * __restrict__ sin_m = &( exp_mm_theta_im[imode*vecSize] );
 
             // Field buffers for vectorization (required on A64FX)
             for( int iloc=-1 ; iloc<3 ; iloc++ ) {
                 for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                    field_buffer[iloc+1][jloc+1] = ( *El )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                    field_re[iloc+1][jloc+1] = std::real( ( *El )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                    field_im[iloc+1][jloc+1] = std::imag( ( *El )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                 }
             }
 
-            #pragma omp simd private(interp_res)
+            #pragma omp simd private(interp_re, interp_im)
             for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             
                 
                 //El(dual, primal)
-                interp_res = 0.;
+                interp_re = 0.;
+                interp_im = 0.;
                 UNROLL_S(3) 
                 for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                     UNROLL_S(3) 
                     for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                        interp_res += std::real( coeffld[ipart + iloc*32] * coeffrp[ipart + jloc*32] *
-                                      ( ( 1.-dual[0][ipart] )*field_buffer[1+iloc][1+jloc] 
-                                           + dual[0][ipart]  *field_buffer[2+iloc][1+jloc] ) 
-                                            * exp_mm_theta[ipart]) ; 
+                        double c = coeffld[ipart + iloc*32] * coeffrp[ipart + jloc*32];
+                        interp_re += c * ( ( 1.-dual[0][ipart] )*field_re[1+iloc][1+jloc] + dual[0][ipart]*field_re[2+iloc][1+jloc] );
+                        interp_im += c * ( ( 1.-dual[0][ipart] )*field_im[1+iloc][1+jloc] + dual[0][ipart]*field_im[2+iloc][1+jloc] );
                     }
                 }
-                Epart[0][ipart] += interp_res;
+                Epart[0][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
 
            for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                for( int jloc=-1 ; jloc<3 ; jloc++ ) {
-                   field_buffer[iloc+1][jloc+1] = ( *Er )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                   field_re[iloc+1][jloc+1] = std::real( ( *Er )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                   field_im[iloc+1][jloc+1] = std::imag( ( *Er )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                }
            }
                 
-           #pragma omp simd private(interp_res)
+           #pragma omp simd private(interp_re, interp_im)
            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
                //Er(primal, dual)
-               interp_res = 0.;
+               interp_re = 0.;
+               interp_im = 0.;
                UNROLL_S(3) 
                for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                    UNROLL_S(3) 
                    for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                       interp_res +=  std::real (*( coefflp+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 ) *
-                                     ( ( 1-dual[1][ipart] )*field_buffer[1+iloc][1+jloc] 
-                                         + dual[1][ipart]  *field_buffer[1+iloc][2+jloc] )
-                                           * exp_mm_theta[ipart]);
+                       double c = *( coefflp+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 );
+                       interp_re += c * ( ( 1-dual[1][ipart] )*field_re[1+iloc][1+jloc] + dual[1][ipart]*field_re[1+iloc][2+jloc] );
+                       interp_im += c * ( ( 1-dual[1][ipart] )*field_im[1+iloc][1+jloc] + dual[1][ipart]*field_im[1+iloc][2+jloc] );
                    }
                }
-               Epart[1][ipart] += interp_res;
+               Epart[1][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
                 
            for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                   field_buffer[iloc+1][jloc+1] = ( *Et )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                   field_re[iloc+1][jloc+1] = std::real( ( *Et )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                   field_im[iloc+1][jloc+1] = std::imag( ( *Et )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                }
            }
                 
-           #pragma omp simd private(interp_res)
+           #pragma omp simd private(interp_re, interp_im)
            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
                 //Et(primal, primal)
-                interp_res = 0.;
+                interp_re = 0.;
+                interp_im = 0.;
                 UNROLL_S(3) 
                 for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                     UNROLL_S(3) 
                     for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                        interp_res +=  std::real(  *( coefflp+ipart+iloc*32 ) * *( coeffrp+ipart+jloc*32 ) * 
-                                                    field_buffer[1+iloc][1+jloc]  
-                                                      * exp_mm_theta[ipart]);
+                        double c = *( coefflp+ipart+iloc*32 ) * *( coeffrp+ipart+jloc*32 );
+                        interp_re += c * field_re[1+iloc][1+jloc];
+                        interp_im += c * field_im[1+iloc][1+jloc];
                     }
                 }
-                Epart[2][ipart] += interp_res;
+                Epart[2][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
                 
            for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                for( int jloc=-1 ; jloc<3 ; jloc++ ) {
-                   field_buffer[iloc+1][jloc+1] = ( *Bl )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                   field_re[iloc+1][jloc+1] = std::real( ( *Bl )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                   field_im[iloc+1][jloc+1] = std::imag( ( *Bl )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                }
            }
 
-           #pragma omp simd private(interp_res)
+           #pragma omp simd private(interp_re, interp_im)
            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
                 //Bl(primal, dual)
-                interp_res = 0.;
+                interp_re = 0.;
+                interp_im = 0.;
                 UNROLL_S(3) 
                 for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                     UNROLL_S(3) 
                     for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                        interp_res +=  std::real(  *( coefflp+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 ) *
-                                      ( ( ( 1-dual[1][ipart] ) * field_buffer[1+iloc][1+jloc] 
-                                            + dual[1][ipart]   * field_buffer[1+iloc][2+jloc] )
-                                                )  * exp_mm_theta[ipart] );
+                        double c = *( coefflp+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 );
+                        interp_re += c * ( ( 1-dual[1][ipart] )*field_re[1+iloc][1+jloc] + dual[1][ipart]*field_re[1+iloc][2+jloc] );
+                        interp_im += c * ( ( 1-dual[1][ipart] )*field_im[1+iloc][1+jloc] + dual[1][ipart]*field_im[1+iloc][2+jloc] );
                     }
                 }
-                Bpart[0][ipart] += interp_res;
+                Bpart[0][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
                 
            for( int iloc=-1 ; iloc<3 ; iloc++ ) {
                for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                   field_buffer[iloc+1][jloc+1] = ( *Br )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                   field_re[iloc+1][jloc+1] = std::real( ( *Br )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                   field_im[iloc+1][jloc+1] = std::imag( ( *Br )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                }
            }
-           #pragma omp simd private(interp_res)
+           #pragma omp simd private(interp_re, interp_im)
            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
                 //Br(dual, primal )
-                interp_res = 0.;
+                interp_re = 0.;
+                interp_im = 0.;
                 UNROLL_S(3) 
                 for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                     UNROLL_S(3) 
                     for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                        interp_res +=  std::real(  *( coeffld+ipart+iloc*32 ) * *( coeffrp+ipart+jloc*32 ) *
-                                      ( ( ( 1-dual[0][ipart] )* field_buffer[ 1+iloc][1+jloc ] 
-                                            + dual[0][ipart]  * field_buffer[ 2+iloc][1+jloc ] )
-                                                )  * exp_mm_theta[ipart]);
+                        double c = *( coeffld+ipart+iloc*32 ) * *( coeffrp+ipart+jloc*32 );
+                        interp_re += c * ( ( 1-dual[0][ipart] )*field_re[1+iloc][1+jloc] + dual[0][ipart]*field_re[2+iloc][1+jloc] );
+                        interp_im += c * ( ( 1-dual[0][ipart] )*field_im[1+iloc][1+jloc] + dual[0][ipart]*field_im[2+iloc][1+jloc] );
                     }
                 }
-                Bpart[1][ipart] += interp_res;
+                Bpart[1][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
                 
            for( int iloc=-1 ; iloc<3 ; iloc++ ) {
                for( int jloc=-1 ; jloc<3 ; jloc++ ) {
-                   field_buffer[iloc+1][jloc+1] = ( *Bt )( idxO[0]+1+iloc, idxO[1]+1+jloc );
+                   field_re[iloc+1][jloc+1] = std::real( ( *Bt )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
+                   field_im[iloc+1][jloc+1] = std::imag( ( *Bt )( idxO[0]+1+iloc, idxO[1]+1+jloc ) );
                }
            }
-           #pragma omp simd private(interp_res)
+           #pragma omp simd private(interp_re, interp_im)
            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
                 //Bt(dual, dual)
-                interp_res = 0.;
+                interp_re = 0.;
+                interp_im = 0.;
                 UNROLL_S(3) 
                 for( int iloc=-1 ; iloc<2 ; iloc++ ) {
                     UNROLL_S(3) 
                     for( int jloc=-1 ; jloc<2 ; jloc++ ) {
-                        interp_res +=  std::real(  *( coeffld+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 ) *
-                                      ( ( 1-dual[1][ipart] ) * ( ( 1-dual[0][ipart] )*field_buffer[1+iloc][1+jloc] 
-                                                                     + dual[0][ipart]*field_buffer[2+iloc][1+jloc] )
-                                        +    dual[1][ipart]  * ( ( 1-dual[0][ipart] )*field_buffer[1+iloc][2+jloc] 
-                                                                     + dual[0][ipart]*field_buffer[2+iloc][2+jloc] )
-                                                ) * exp_mm_theta[ipart] );
+                        double c = *( coeffld+ipart+iloc*32 ) * *( coeffrd+ipart+jloc*32 );
+                        interp_re += c * ( ( 1-dual[1][ipart] ) * ( ( 1-dual[0][ipart] )*field_re[1+iloc][1+jloc] + dual[0][ipart]*field_re[2+iloc][1+jloc] )
+                                         +    dual[1][ipart]  * ( ( 1-dual[0][ipart] )*field_re[1+iloc][2+jloc] + dual[0][ipart]*field_re[2+iloc][2+jloc] ) );
+                        interp_im += c * ( ( 1-dual[1][ipart] ) * ( ( 1-dual[0][ipart] )*field_im[1+iloc][1+jloc] + dual[0][ipart]*field_im[2+iloc][1+jloc] )
+                                         +    dual[1][ipart]  * ( ( 1-dual[0][ipart] )*field_im[1+iloc][2+jloc] + dual[0][ipart]*field_im[2+iloc][2+jloc] ) );
                     }
                 }
-                Bpart[2][ipart] += interp_res;
-                exp_mm_theta[ipart] *= exp_m_theta_[ipart]; //prepare for next mode
+                Bpart[2][ipart] += interp_re*cos_m[ipart] - interp_im*sin_m[ipart];
            }
        } //end loop on modes
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             //Translate field into the cartesian y,z coordinates
-            double delta2 = std::real( exp_m_theta_[ipart] ) * Epart[1][ipart] + std::imag( exp_m_theta_[ipart] ) * Epart[2][ipart];
-            Epart[2][ipart] = -std::imag( exp_m_theta_[ipart] ) * Epart[1][ipart] + std::real( exp_m_theta_[ipart] ) * Epart[2][ipart];
+            double delta2 = exp_m_theta_re[ipart] * Epart[1][ipart] + exp_m_theta_im[ipart] * Epart[2][ipart];
+            Epart[2][ipart] = -exp_m_theta_im[ipart] * Epart[1][ipart] + exp_m_theta_re[ipart] * Epart[2][ipart];
             Epart[1][ipart] = delta2 ;
-            delta2 = std::real( exp_m_theta_[ipart] ) * Bpart[1][ipart] + std::imag( exp_m_theta_[ipart] ) * Bpart[2][ipart];
-            Bpart[2][ipart] = -std::imag( exp_m_theta_[ipart] ) * Bpart[1][ipart] + std::real( exp_m_theta_[ipart] ) * Bpart[2][ipart];
+            delta2 = exp_m_theta_re[ipart] * Bpart[1][ipart] + exp_m_theta_im[ipart] * Bpart[2][ipart];
+            Bpart[2][ipart] = -exp_m_theta_im[ipart] * Bpart[1][ipart] + exp_m_theta_re[ipart] * Bpart[2][ipart];
             Bpart[1][ipart] = delta2 ;
         }
 
 
     } //end loop on ivec
 }
-
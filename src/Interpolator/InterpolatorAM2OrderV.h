@@ -33,6 +33,9 @@ private:
     
     //! Number of modes;
     unsigned int nmodes_;
+
+    //! exp(-i m theta) of a group of particles for all modes, real and imaginary parts ([imode*32+ipart])
+    std::vector<double> exp_mm_theta_re_, exp_mm_theta_im_;
     
     
 };//END class
@@ -2,6 +2,7 @@
 #include "IonizationTables.h"
 
 #include <cmath>
+#include <limits>
 
 #include "Particles.h"
 #include "Species.h"
@@ -33,6 +34,7 @@ IonizationTunnel::IonizationTunnel( Params &params, Species *species ) : Ionizat
     alpha_tunnel.resize( atomic_number_ );
     beta_tunnel.resize( atomic_number_ );
     gamma_tunnel.resize( atomic_number_ );
+    log_gamma_tunnel.resize( atomic_number_ );
     
     for( unsigned int Z=0 ; Z<atomic_number_ ; Z++ ) {
         DEBUG( "Z : " << Z );
@@ -40,7 +42,36 @@ IonizationTunnel::IonizationTunnel( Params &params, Species *species ) : Ionizat
         alpha_tunnel[Z] = cst-1.0;
         beta_tunnel[Z]  = pow( 2, alpha_tunnel[Z] ) * ( 8.*Azimuthal_quantum_number[Z]+4.0 ) / ( cst*tgamma( cst ) ) * Potential[Z] * au_to_w0;
         gamma_tunnel[Z] = 2.0 * sqrt( 2.0*Potential[Z] * 2.0*Potential[Z] * 2.0*Potential[Z]  );
+        log_gamma_tunnel[Z] = log( gamma_tunnel[Z] );
     }
+    
+    // Field below which an ion of charge Z has a negligible probability to be ionized during one timestep.
+    // The rate increases with the field up to gamma/(3 alpha), so that the threshold is found by bisection below.
+    // It is stored squared and in code units, to be compared directly with the interpolated fields.
+    E2_threshold_.resize( atomic_number_+1 );
+    for( unsigned int Z=0 ; Z<atomic_number_ ; Z++ ) {
+        double Emax = alpha_tunnel[Z] > 0. ? gamma_tunnel[Z] / ( 3.*alpha_tunnel[Z] ) : 1e10;
+        if( rate( Z, 1./Emax ) * dt < negligible_probability ) {
+            E2_threshold_[Z] = numeric_limits<double>::infinity();
+            continue;
+        }
+        double log_Emin = log( 1e-10 ), log_Emax = log( Emax );
+        for( unsigned int i=0; i<100; i++ ) {
+            double log_E = 0.5*( log_Emin + log_Emax );
+            if( rate( Z, exp( -log_E ) ) * dt < negligible_probability ) {
+                log_Emin = log_E;
+            } else {
+                log_Emax = log_E;
+            }
+        }
+        double E = exp( log_Emin ) / EC_to_au;
+        E2_threshold_[Z] = E*E;
+    }
+    // Fully ionized atoms are never candidates
+    E2_threshold_[atomic_number_] = numeric_limits<double>::infinity();
+    
+    IonizRate_tunnel_.resize( atomic_number_ );
+    Dnom_tunnel_.resize( atomic_number_ );
 
     DEBUG( "Finished Creating the Tunnel Ionizaton class" );
     
@@ -51,9 +82,8 @@ IonizationTunnel::IonizationTunnel( Params &params, Species *species ) : Ionizat
 void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, vector<double> *Epart, Patch *patch, Projector *Proj, int ipart_ref )
 {
 
-    unsigned int Z, Zp1, newZ, k_times;
-    double TotalIonizPot, E, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
-    vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ , 0.);
+    unsigned int k_times;
+    double TotalIonizPot, invE;
     LocalFields Jion;
     double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
     
@@ -62,123 +92,97 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
     double *Ey = &( ( *Epart )[1*nparts] );
     double *Ez = &( ( *Epart )[2*nparts] );
     
-    for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
+    if( ipart_max <= ipart_min ) {
+        return;
+    }
+    unsigned int n = ipart_max - ipart_min;
+    Dnom_tunnel_.assign( atomic_number_, 0. );
     
-        // Current charge state of the ion
-        Z = ( unsigned int )( particles->charge( ipart ) );
-        
-        // If ion already fully ionized then skip
-        if( Z==atomic_number_ ) {
-            continue;
+    // First pass: flag the ions which have a non-negligible probability to be ionized
+    // (no transcendental function, vectorized)
+    candidate_.resize( n );
+    short  *const __restrict__ charge = particles->getPtrCharge();
+    double *const __restrict__ E2_threshold = &E2_threshold_[0];
+    unsigned char *const __restrict__ candidate = &candidate_[0];
+    #pragma omp simd
+    for( unsigned int i=0 ; i<n; i++ ) {
+        unsigned int ipart = ipart_min + i;
+        double E2 = Ex[ipart-ipart_ref] * Ex[ipart-ipart_ref]
+                  + Ey[ipart-ipart_ref] * Ey[ipart-ipart_ref]
+                  + Ez[ipart-ipart_ref] * Ez[ipart-ipart_ref];
+        candidate[i] = E2 >= E2_threshold[charge[ipart]];
+    }
+    
+    // Compaction of the candidates
+    ionized_.clear();
+    events_.clear();
+    for( unsigned int i=0 ; i<n; i++ ) {
+        if( candidate[i] ) {
+            ionized_.push_back( ipart_min + i );
         }
+    }
+    
+    // Second pass: Monte-Carlo draw for the candidates only
+    unsigned int n_ionized = 0;
+    for( unsigned int ic=0 ; ic<ionized_.size(); ic++ ) {
+        unsigned int ipart = ionized_[ic];
         
         // Absolute value of the electric field normalized in atomic units
-        E = EC_to_au * sqrt( (*( Ex+ipart-ipart_ref )) * (*( Ex+ipart-ipart_ref ))
-                             + (*( Ey+ipart-ipart_ref )) * (*( Ey+ipart-ipart_ref ))
-                             + (*( Ez+ipart-ipart_ref )) * (*( Ez+ipart-ipart_ref )) );
-        if( E<1e-10 ) {
+        invE = 1. / ( EC_to_au * sqrt( Ex[ipart-ipart_ref] * Ex[ipart-ipart_ref]
+                                     + Ey[ipart-ipart_ref] * Ey[ipart-ipart_ref]
+                                     + Ez[ipart-ipart_ref] * Ez[ipart-ipart_ref] ) );
+        
+        k_times = ionizationEvents( ( unsigned int )( particles->charge( ipart ) ), invE, patch->rand_->uniform(), TotalIonizPot );
+        if( k_times == 0 ) {
             continue;
         }
         
-        // --------------------------------
-        // Start of the Monte-Carlo routine
-        // --------------------------------
-        
-        invE = 1./E;
-        factorJion = factorJion_0 * invE*invE;
-        delta      = gamma_tunnel[Z]*invE;
-        ran_p = patch->rand_->uniform();
-        IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
-        
-        // Total ionization potential (used to compute the ionization current)
-        TotalIonizPot = 0.0;
-        
-        // k_times will give the nb of ionization events
-        k_times = 0;
-        Zp1=Z+1;
-        
-        if( Zp1 == atomic_number_ ) {
-            // if ionization of the last electron: single ionization
-            // -----------------------------------------------------
-            if( ran_p < 1.0 -exp( -IonizRate_tunnel[Z]*dt ) ) {
-                TotalIonizPot += Potential[Z];
-                k_times        = 1;
-            }
-            
-        } else {
-            // else : multiple ionization can occur in one time-step
-            //        partial & final ionization are decoupled (see Nuter Phys. Plasmas)
-            // -------------------------------------------------------------------------
-            
-            // initialization
-            Mult = 1.0;
-            Dnom_tunnel[0]=1.0;
-            Pint_tunnel = exp( -IonizRate_tunnel[Z]*dt ); // cummulative prob.
-            
-            //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
-            while( ( Pint_tunnel < ran_p ) and ( k_times < atomic_number_-Zp1 ) ) {
-                newZ = Zp1+k_times;
-                delta = gamma_tunnel[newZ]*invE;
-                IonizRate_tunnel[newZ] = beta_tunnel[newZ]
-                                         *                        exp( -delta*one_third+alpha_tunnel[newZ]*log( delta ) );
-                D_sum = 0.0;
-                P_sum = 0.0;
-                Mult  *= IonizRate_tunnel[Z+k_times];
-                for( unsigned int i=0; i<k_times+1; i++ ) {
-                    Dnom_tunnel[i]=Dnom_tunnel[i]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i] );
-                    D_sum += Dnom_tunnel[i];
-                    P_sum += exp( -IonizRate_tunnel[Z+i]*dt )*Dnom_tunnel[i];
-                }
-                Dnom_tunnel[k_times+1] -= D_sum;
-                P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp( -IonizRate_tunnel[newZ]*dt );
-                Pint_tunnel             = Pint_tunnel + P_sum*Mult;
-                
-                TotalIonizPot += Potential[Z+k_times];
-                k_times++;
-            }//END while
-            
-            // final ionization (of last electron)
-            if( ( ( 1.0-Pint_tunnel )>ran_p ) && ( k_times==atomic_number_-Zp1 ) ) {
-                TotalIonizPot += Potential[atomic_number_-1];
-                k_times++;
-            }
-        }//END Multiple ionization routine
-        
         // Compute ionization current
         if (patch->EMfields->Jx_ != NULL){  // For the moment ionization current is not accounted for in AM geometry
-            factorJion *= TotalIonizPot;
-            Jion.x = factorJion * *( Ex+ipart );
-            Jion.y = factorJion * *( Ey+ipart );
-            Jion.z = factorJion * *( Ez+ipart );
+            double factorJion = factorJion_0 * invE*invE * TotalIonizPot;
+            Jion.x = factorJion * Ex[ipart-ipart_ref];
+            Jion.y = factorJion * Ey[ipart-ipart_ref];
+            Jion.z = factorJion * Ez[ipart-ipart_ref];
             
-            Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
+            if( Proj->fusedIonizationCurrents() ) {
+                // Deposited later by the projection of the species currents, at the same (former) position
+                Proj->storeIonizationCurrent( ipart, Jion );
+            } else {
+                Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
+            }
         }
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
-
-        if( k_times !=0 ) {
-            new_electrons.createParticle();
-            int idNew = new_electrons.size() - 1;
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
-            
-            if( save_ion_charge_ ) {
-                ion_charge_.push_back( particles->charge( ipart ) );
-            }
-            
-            // Increase the charge of the particle
-            particles->charge( ipart ) += k_times;
+        // The ionized ions are kept in front of the list
+        ionized_[n_ionized++] = ipart;
+        events_.push_back( k_times );
+    }
+    
+    // Creation of the new electrons, all at once
+    // (variable weights are used)
+    // -----------------------------
+    if( n_ionized == 0 ) {
+        return;
+    }
+    unsigned int idNew = new_electrons.size();
+    new_electrons.createParticles( n_ionized );
+    for( unsigned int ic=0 ; ic<n_ionized; ic++, idNew++ ) {
+        unsigned int ipart = ionized_[ic];
+        for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
+            new_electrons.position( i, idNew )=particles->position( i, ipart );
         }
+        for( unsigned int i=0; i<3; i++ ) {
+            new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
+        }
+        new_electrons.weight( idNew )=double( events_[ic] )*particles->weight( ipart );
+        new_electrons.charge( idNew )=-1;
         
-    } // Loop on particles
+        if( save_ion_charge_ ) {
+            ion_charge_.push_back( particles->charge( ipart ) );
+        }
+        
+        // Increase the charge of the particle
+        particles->charge( ipart ) += events_[ic];
+    }
 }
 
 void IonizationTunnel::ionizationTunnelWithTasks( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, 
@@ -186,9 +190,8 @@ void IonizationTunnel::ionizationTunnelWithTasks( Particles *particles, unsigned
                                                   double *b_Jx, double *b_Jy, double *b_Jz, int ipart_ref )
 {
 
-    unsigned int Z, Zp1, newZ, k_times;
-    double TotalIonizPot, E, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
-    vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ );
+    unsigned int k_times;
+    double TotalIonizPot, E2, invE;
     LocalFields Jion;
     double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
     
@@ -199,92 +202,30 @@ void IonizationTunnel::ionizationTunnelWithTasks( Particles *particles, unsigned
     
     for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
     
-        // Current charge state of the ion
-        Z = ( unsigned int )( particles->charge( ipart ) );
-        
-        // If ion already fully ionized then skip
-        if( Z==atomic_number_ ) {
+        // Skip the ions with a negligible probability to be ionized (including those already fully ionized)
+        E2 = Ex[ipart-ipart_ref] * Ex[ipart-ipart_ref]
+           + Ey[ipart-ipart_ref] * Ey[ipart-ipart_ref]
+           + Ez[ipart-ipart_ref] * Ez[ipart-ipart_ref];
+        if( E2 < E2_threshold_[particles->charge( ipart )] ) {
             continue;
         }
         
         // Absolute value of the electric field normalized in atomic units
-        E = EC_to_au * sqrt( (*( Ex+ipart-ipart_ref )) * (*( Ex+ipart-ipart_ref ))
-                             + (*( Ey+ipart-ipart_ref )) * (*( Ey+ipart-ipart_ref ))
-                             + (*( Ez+ipart-ipart_ref )) * (*( Ez+ipart-ipart_ref )) );
-        if( E<1e-10 ) {
+        invE = 1. / ( EC_to_au * sqrt( E2 ) );
+        
+        // Per-task buffers for the Monte-Carlo routine
+        vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ );
+        k_times = ionizationEvents( ( unsigned int )( particles->charge( ipart ) ), invE, patch->rand_->uniform(), TotalIonizPot, IonizRate_tunnel, Dnom_tunnel );
+        if( k_times == 0 ) {
             continue;
         }
         
-        // --------------------------------
-        // Start of the Monte-Carlo routine
-        // --------------------------------
-        
-        invE = 1./E;
-        factorJion = factorJion_0 * invE*invE;
-        delta      = gamma_tunnel[Z]*invE;
-        ran_p = patch->rand_->uniform();
-        IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
-        
-        // Total ionization potential (used to compute the ionization current)
-        TotalIonizPot = 0.0;
-        
-        // k_times will give the nb of ionization events
-        k_times = 0;
-        Zp1=Z+1;
-        
-        if( Zp1 == atomic_number_ ) {
-            // if ionization of the last electron: single ionization
-            // -----------------------------------------------------
-            if( ran_p < 1.0 -exp( -IonizRate_tunnel[Z]*dt ) ) {
-                TotalIonizPot += Potential[Z];
-                k_times        = 1;
-            }
-        
-        } else {
-            // else : multiple ionization can occur in one time-step
-            //        partial & final ionization are decoupled (see Nuter Phys. Plasmas)
-            // -------------------------------------------------------------------------
-        
-            // initialization
-            Mult = 1.0;
-            Dnom_tunnel[0]=1.0;
-            Pint_tunnel = exp( -IonizRate_tunnel[Z]*dt ); // cummulative prob.
-        
-            //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
-            while( ( Pint_tunnel < ran_p ) and ( k_times < atomic_number_-Zp1 ) ) {
-                newZ = Zp1+k_times;
-                delta = gamma_tunnel[newZ]*invE;
-                IonizRate_tunnel[newZ] = beta_tunnel[newZ]
-                                         *                        exp( -delta*one_third+alpha_tunnel[newZ]*log( delta ) );
-                D_sum = 0.0;
-                P_sum = 0.0;
-                Mult  *= IonizRate_tunnel[Z+k_times];
-                for( unsigned int i=0; i<k_times+1; i++ ) {
-                    Dnom_tunnel[i]=Dnom_tunnel[i]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i] );
-                    D_sum += Dnom_tunnel[i];
-                    P_sum += exp( -IonizRate_tunnel[Z+i]*dt )*Dnom_tunnel[i];
-                }
-                Dnom_tunnel[k_times+1] -= D_sum;
-                P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp( -IonizRate_tunnel[newZ]*dt );
-                Pint_tunnel             = Pint_tunnel + P_sum*Mult;
-        
-                TotalIonizPot += Potential[Z+k_times];
-                k_times++;
-            }//END while
-        
-            // final ionization (of last electron)
-            if( ( ( 1.0-Pint_tunnel )>ran_p ) && ( k_times==atomic_number_-Zp1 ) ) {
-                TotalIonizPot += Potential[atomic_number_-1];
-                k_times++;
-            }
-        }//END Multiple ionization routine
-        
         // Compute ionization current
         if (b_Jx != NULL){  // For the moment ionization current is not accounted for in AM geometry
-            factorJion *= TotalIonizPot;
-            Jion.x = factorJion * *( Ex+ipart );
-            Jion.y = factorJion * *( Ey+ipart );
-            Jion.z = factorJion * *( Ez+ipart );
+            double factorJion = factorJion_0 * invE*invE * TotalIonizPot;
+            Jion.x = factorJion * Ex[ipart-ipart_ref];
+            Jion.y = factorJion * Ey[ipart-ipart_ref];
+            Jion.z = factorJion * Ez[ipart-ipart_ref];
         
             Proj->ionizationCurrentsForTasks( b_Jx, b_Jy, b_Jz, *particles, ipart, Jion, bin_shift );
         }
@@ -292,25 +233,88 @@ void IonizationTunnel::ionizationTunnelWithTasks( Particles *particles, unsigned
         // Creation of the new electrons
         // (variable weights are used)
         // -----------------------------
-        if( k_times !=0 ) {
-            new_electrons_per_bin[ibin].createParticle();
-            int idNew = new_electrons_per_bin[ibin].size() - 1;//cout<<"ibin "<<ibin<<"size "<<new_electrons_per_bin[ibin].size()<<"capacity "<<new_electrons_per_bin[ibin].capacity()<<"\n"<<endl;
-            for( unsigned int i=0; i<new_electrons_per_bin[ibin].dimension(); i++ ) {
-                new_electrons_per_bin[ibin].position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons_per_bin[ibin].momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons_per_bin[ibin].weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons_per_bin[ibin].charge( idNew )=-1;
-            
-            if( save_ion_charge_ ) {
-                ion_charge_per_bin_[ibin].push_back( particles->charge( ipart ) );
-            }
-            
-            // // Increase the charge of the particle
-            particles->charge( ipart ) += k_times;
+        new_electrons_per_bin[ibin].createParticle();
+        int idNew = new_electrons_per_bin[ibin].size() - 1;
+        for( unsigned int i=0; i<new_electrons_per_bin[ibin].dimension(); i++ ) {
+            new_electrons_per_bin[ibin].position( i, idNew )=particles->position( i, ipart );
+        }
+        for( unsigned int i=0; i<3; i++ ) {
+            new_electrons_per_bin[ibin].momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
+        }
+        new_electrons_per_bin[ibin].weight( idNew )=double( k_times )*particles->weight( ipart );
+        new_electrons_per_bin[ibin].charge( idNew )=-1;
+        
+        if( save_ion_charge_ ) {
+            ion_charge_per_bin_[ibin].push_back( particles->charge( ipart ) );
         }
         
+        // // Increase the charge of the particle
+        particles->charge( ipart ) += k_times;
+        
     } // Loop on particles
 }
+
+unsigned int IonizationTunnel::ionizationEvents( unsigned int Z, double invE, double ran_p, double &TotalIonizPot,
+                                                 vector<double> &IonizRate_tunnel, vector<double> &Dnom_tunnel )
+{
+    unsigned int Zp1, newZ, k_times;
+    double Mult, D_sum, P_sum, Pint_tunnel;
+    
+    // The log of the field is shared by the rates of all charge states
+    double log_invE = log( invE );
+    IonizRate_tunnel[Z] = rate( Z, invE, log_invE );
+    
+    // Total ionization potential (used to compute the ionization current)
+    TotalIonizPot = 0.0;
+    
+    // k_times will give the nb of ionization events
+    k_times = 0;
+    Zp1=Z+1;
+    
+    if( Zp1 == atomic_number_ ) {
+        // if ionization of the last electron: single ionization
+        // -----------------------------------------------------
+        if( ran_p < 1.0 -exp( -IonizRate_tunnel[Z]*dt ) ) {
+            TotalIonizPot += Potential[Z];
+            k_times        = 1;
+        }
+        
+    } else {
+        // else : multiple ionization can occur in one time-step
+        //        partial & final ionization are decoupled (see Nuter Phys. Plasmas)
+        // -------------------------------------------------------------------------
+        
+        // initialization
+        Mult = 1.0;
+        Dnom_tunnel[0]=1.0;
+        Pint_tunnel = exp( -IonizRate_tunnel[Z]*dt ); // cummulative prob.
+        
+        //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
+        while( ( Pint_tunnel < ran_p ) and ( k_times < atomic_number_-Zp1 ) ) {
+            newZ = Zp1+k_times;
+            IonizRate_tunnel[newZ] = rate( newZ, invE, log_invE );
+            D_sum = 0.0;
+            P_sum = 0.0;
+            Mult  *= IonizRate_tunnel[Z+k_times];
+            for( unsigned int i=0; i<k_times+1; i++ ) {
+                Dnom_tunnel[i]=Dnom_tunnel[i]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i] );
+                D_sum += Dnom_tunnel[i];
+                P_sum += exp( -IonizRate_tunnel[Z+i]*dt )*Dnom_tunnel[i];
+            }
+            Dnom_tunnel[k_times+1] -= D_sum;
+            P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp( -IonizRate_tunnel[newZ]*dt );
+            Pint_tunnel             = Pint_tunnel + P_sum*Mult;
+            
+            TotalIonizPot += Potential[Z+k_times];
+            k_times++;
+        }//END while
+        
+        // final ionization (of last electron)
+        if( ( ( 1.0-Pint_tunnel )>ran_p ) && ( k_times==atomic_number_-Zp1 ) ) {
+            TotalIonizPot += Potential[atomic_number_-1];
+            k_times++;
+        }
+    }//END Multiple ionization routine
+    
+    return k_times;
+}
@@ -24,12 +24,42 @@ public:
     void ionizationTunnelWithTasks( Particles *, unsigned int, unsigned int, std::vector<double> *, Patch *, Projector *, int, int, double *b_Jx, double *b_Jy, double *b_Jz, int ipart_ref = 0 ) override;
     
 private:
+    //! Monte-Carlo draw of the number of electrons released during one timestep by an ion of charge Z
+    //! in a field of inverse invE (atomic units). TotalIonizPot receives the corresponding ionization energy.
+    unsigned int ionizationEvents( unsigned int Z, double invE, double ran_p, double &TotalIonizPot,
+                                   std::vector<double> &IonizRate_tunnel, std::vector<double> &Dnom_tunnel );
+    unsigned int ionizationEvents( unsigned int Z, double invE, double ran_p, double &TotalIonizPot )
+    {
+        return ionizationEvents( Z, invE, ran_p, TotalIonizPot, IonizRate_tunnel_, Dnom_tunnel_ );
+    }
+    
+    //! Ionization rate of the charge state Z in a field of inverse invE (atomic units)
+    inline double rate( unsigned int Z, double invE, double log_invE )
+    {
+        return beta_tunnel[Z] * exp( -gamma_tunnel[Z]*invE*one_third + alpha_tunnel[Z]*( log_gamma_tunnel[Z] + log_invE ) );
+    }
+    inline double rate( unsigned int Z, double invE )
+    {
+        return rate( Z, invE, log( invE ) );
+    }
+    
     unsigned int atomic_number_;
     std::vector<double> Potential;
     std::vector<double> Azimuthal_quantum_number;
     
     double one_third;
-    std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel;
+    std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel, log_gamma_tunnel;
+    
+    //! Probability of ionization during one timestep below which an ion is not considered
+    static constexpr double negligible_probability = 1e-12;
+    //! Square of the field (code units) above which an ion of each charge state may be ionized
+    std::vector<double> E2_threshold_;
+    
+    //! Buffers of the Monte-Carlo routine
+    std::vector<double> IonizRate_tunnel_, Dnom_tunnel_;
+    //! Flags of the candidate ions, list of the ionized ions and their number of ionization events
+    std::vector<unsigned char> candidate_;
+    std::vector<unsigned int> ionized_, events_;
 };
 
 
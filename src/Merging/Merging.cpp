@@ -32,3 +32,46 @@ Merging::Merging( Species *species, Random * rand )
 Merging::~Merging()
 {
 }
+
+// -----------------------------------------------------------------------------
+//! Merge the particles of all the cells of a patch in a single pass
+// -----------------------------------------------------------------------------
+unsigned int Merging::mergeCells(
+    double mass,
+    Particles &particles,
+    std::vector <int> &mask,
+    std::vector <int> &count )
+{
+    unsigned int removed = 0;
+    for( unsigned int scell = 0 ; scell < particles.first_index.size() ; scell++ ) {
+        if( ( unsigned int )( particles.last_index[scell] - particles.first_index[scell] ) > min_particles_per_cell_ ) {
+            int count_before = count[scell];
+            ( *this )( mass, particles, mask, particles.first_index[scell], particles.last_index[scell], count[scell] );
+            removed += count_before - count[scell];
+        }
+    }
+    return removed;
+}
+
+// -----------------------------------------------------------------------------
+//! Whether at least one cell has enough particles to be merged
+// -----------------------------------------------------------------------------
+bool Merging::hasCellsToMerge( Particles &particles ) const
+{
+    for( unsigned int scell = 0 ; scell < particles.first_index.size() ; scell++ ) {
+        if( ( unsigned int )( particles.last_index[scell] - particles.first_index[scell] ) > min_particles_per_cell_ ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+//! Scratch buffers of the current thread: a patch is merged by a single
+//! thread, and the buffers are kept from one call to the next
+// -----------------------------------------------------------------------------
+MergingScratch &Merging::scratch()
+{
+    static thread_local MergingScratch scratch;
+    return scratch;
+}
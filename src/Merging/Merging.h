@@ -11,11 +11,42 @@
 #ifndef MERGING_H
 #define MERGING_H
 
+#include <vector>
+
 #include "Params.h"
 #include "Particles.h"
 #include "Species.h"
 #include "Random.h"
 
+//  ----------------------------------------------------------------------------
+//! Scratch buffers of the merging, reused from one call to the next
+//! (one instance per OpenMP thread, see Merging::scratch)
+//  ----------------------------------------------------------------------------
+struct MergingScratch
+{
+    //! Particle mask: -1 for the particles removed by the merging
+    std::vector<int> mask;
+    //! Momentum cell of each particle
+    std::vector<unsigned int> momentum_cell_index;
+    //! Particle indexes sorted by momentum cell
+    std::vector<unsigned int> sorted_particles;
+    //! Particle gamma factor
+    std::vector<double> gamma;
+    //! Number of particles and index of the first particle in each momentum cell
+    std::vector<unsigned int> particles_per_momentum_cells;
+    std::vector<unsigned int> momentum_cell_particle_index;
+
+    //! Make sure that buffer holds at least n elements (the memory is never released)
+    template<typename T>
+    static T *reserve( std::vector<T> &buffer, size_t n )
+    {
+        if( buffer.size() < n ) {
+            buffer.resize( n );
+        }
+        return buffer.data();
+    }
+};
+
 //  ----------------------------------------------------------------------------
 //! Class Merging
 //  ----------------------------------------------------------------------------
@@ -42,6 +73,24 @@ public:
         int iend,
         int & count) = 0;
 
+    //! Merge the particles of all the cells of a patch (particles.first_index
+    //! and particles.last_index), in a single pass.
+    //! The cells with too few particles are skipped.
+    //! \param mask   particle mask, -1 for the removed particles
+    //! \param count  number of particles per cell, updated
+    //! \return number of removed particles
+    unsigned int mergeCells(
+        double mass,
+        Particles &particles,
+        std::vector <int> &mask,
+        std::vector <int> &count );
+
+    //! Whether at least one cell has enough particles to be merged
+    bool hasCellsToMerge( Particles &particles ) const;
+
+    //! Scratch buffers of the current thread
+    static MergingScratch &scratch();
+
     // parameters _______________________________________________
 
 protected:
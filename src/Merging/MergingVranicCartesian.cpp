@@ -153,76 +153,60 @@ void MergingVranicCartesian::operator() (
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
 
+        // Scratch buffers of the thread, reused from one call to the next
+        MergingScratch &scratch = Merging::scratch();
+
         // Local vector to store the momentum index in the momentum discretization
-        // std::vector <unsigned int> momentum_cell_index(number_of_particles,0);
-        // unsigned int  * momentum_cell_index = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
-        unsigned int  * momentum_cell_index = new unsigned int [number_of_particles];
+        unsigned int * __restrict__ momentum_cell_index = MergingScratch::reserve( scratch.momentum_cell_index, number_of_particles );
 
         // Sorted array of particle index
-        // std::vector <unsigned int> sorted_particles(number_of_particles,0);
-        // unsigned int  * sorted_particles = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
-        unsigned int  * sorted_particles = new unsigned int [number_of_particles];
+        unsigned int * __restrict__ sorted_particles = MergingScratch::reserve( scratch.sorted_particles, number_of_particles );
 
         // Particle gamma factor
-        // std::vector <double> gamma(number_of_particles,0);
-        // double  * gamma = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
-        double  * gamma = new double [number_of_particles];
+        double * __restrict__ gamma = MergingScratch::reserve( scratch.gamma, number_of_particles );
 
         // Computation of the particle gamma factor
-        if (mass == 0) {
-            #pragma omp simd private(ipr) 
-            //aligned(gamma : 64)
-            for (ip=(unsigned int)(istart) ; ip<(unsigned int) (iend); ip++ ) {
-
-                // Local (relative) array index
-                ipr = ip - istart;
-
-                gamma[ipr] = sqrt(momentum_x[ip]*momentum_x[ip]
-                              + momentum_y[ip]*momentum_y[ip]
-                              + momentum_z[ip]*momentum_z[ip]);
+        // (the photon energy is the momentum norm)
+        const double mass2 = ( mass == 0 ) ? 0. : 1.;
+        #pragma omp simd private(ipr)
+        for (ip=(unsigned int)(istart) ; ip<(unsigned int) (iend); ip++ ) {
 
-            }
-        } else {
-            #pragma omp simd private(ipr) 
-            //aligned(gamma : 64)
-            for (ip=(unsigned int)(istart) ; ip<(unsigned int) (iend); ip++ ) {
-
-                // Local (relative) array index
-                ipr = ip - istart;
+            // Local (relative) array index
+            ipr = ip - istart;
 
-                gamma[ipr] = sqrt(1.0 + momentum_x[ip]*momentum_x[ip]
-                              + momentum_y[ip]*momentum_y[ip]
-                              + momentum_z[ip]*momentum_z[ip]);
+            gamma[ipr] = sqrt(mass2 + momentum_x[ip]*momentum_x[ip]
+                          + momentum_y[ip]*momentum_y[ip]
+                          + momentum_z[ip]*momentum_z[ip]);
 
-            }
         }
 
         // Computation of the maxima and minima for each direction
-        momentum_min[0] = momentum_x[istart];
-        momentum_max[0] = momentum_x[istart];
-
-        momentum_min[1] = momentum_y[istart];
-        momentum_max[1] = momentum_y[istart];
-
-        momentum_min[2] = momentum_z[istart];
-        momentum_max[2] = momentum_z[istart];
+        // (scalar reduction variables, so that the loop is vectorized)
+        double px_min = momentum_x[istart], px_max = momentum_x[istart];
+        double py_min = momentum_y[istart], py_max = momentum_y[istart];
+        double pz_min = momentum_z[istart], pz_max = momentum_z[istart];
 
-#if __INTEL_COMPILER > 18000
         #pragma omp simd \
-        reduction(min:momentum_min)  \
-        reduction(max:momentum_max)
-#endif
+        reduction(min:px_min,py_min,pz_min) \
+        reduction(max:px_max,py_max,pz_max)
         for (ip=(unsigned int) (istart) ; ip < (unsigned int) (iend); ip++ ) {
-            momentum_min[0] = std::min(momentum_min[0],momentum_x[ip]);
-            momentum_max[0] = std::max(momentum_max[0],momentum_x[ip]);
+            px_min = std::min(px_min,momentum_x[ip]);
+            px_max = std::max(px_max,momentum_x[ip]);
 
-            momentum_min[1] = std::min(momentum_min[1],momentum_y[ip]);
-            momentum_max[1] = std::max(momentum_max[1],momentum_y[ip]);
+            py_min = std::min(py_min,momentum_y[ip]);
+            py_max = std::max(py_max,momentum_y[ip]);
 
-            momentum_min[2] = std::min(momentum_min[2],momentum_z[ip]);
-            momentum_max[2] = std::max(momentum_max[2],momentum_z[ip]);
+            pz_min = std::min(pz_min,momentum_z[ip]);
+            pz_max = std::max(pz_max,momentum_z[ip]);
         }
 
+        momentum_min[0] = px_min;
+        momentum_max[0] = px_max;
+        momentum_min[1] = py_min;
+        momentum_max[1] = py_max;
+        momentum_min[2] = pz_min;
+        momentum_max[2] = pz_max;
+
         // ---------------------------------------------------------------------
         // debugging
         // std::cerr << " momentum_min[0]: " << momentum_min[0]
@@ -388,17 +372,13 @@ void MergingVranicCartesian::operator() (
                                     * dim[2];
 
         // Array containing the number of particles per momentum cells
-        // std::vector <unsigned int> particles_per_momentum_cells(momentum_cells,0);
-        // unsigned int  * particles_per_momentum_cells = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-        unsigned int  * particles_per_momentum_cells = new unsigned int [momentum_cells];
+        unsigned int * __restrict__ particles_per_momentum_cells = MergingScratch::reserve( scratch.particles_per_momentum_cells, momentum_cells );
         
         // Array containing the first particle index of each momentum cell
         // in the sorted particle array
-        //std::vector <unsigned int> momentum_cell_particle_index(momentum_cells,0);
-        // unsigned int  * momentum_cell_particle_index = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-        unsigned int  * momentum_cell_particle_index = new unsigned int [momentum_cells];
+        unsigned int * __restrict__ momentum_cell_particle_index = MergingScratch::reserve( scratch.momentum_cell_particle_index, momentum_cells );
         
-        // Initialization when using aligned_alloc
+        // Initialization of the reused buffers
         #pragma omp simd
         for (ic = 0 ; ic < momentum_cells ; ic++) {
             momentum_cell_particle_index[ic] = 0;
@@ -407,23 +387,27 @@ void MergingVranicCartesian::operator() (
 
         // For each particle, momentum cell indexes are computed in the
         // requested discretization.
-        // This loop can be efficiently vectorized
+        // The loop invariants are kept in scalars so that the loop is vectorized
+        const double px_ref = momentum_min[0], inv_dpx = inv_momentum_delta[0];
+        const double py_ref = momentum_min[1], inv_dpy = inv_momentum_delta[1];
+        const double pz_ref = momentum_min[2], inv_dpz = inv_momentum_delta[2];
+        const unsigned int stride_y = dim[0];
+        const unsigned int stride_z = dim[0]*dim[1];
         #pragma omp simd \
         private(ipr,mx_i,my_i,mz_i) 
-        //aligned(momentum_cell_index: 64)
         for (ip=(unsigned int) (istart) ; ip < (unsigned int) (iend); ip++ ) {
 
             // Relative particle array index
             ipr = ip - istart;
 
             // 3d indexes in the momentum discretization
-            mx_i = (unsigned int) floor( (momentum_x[ip] - momentum_min[0]) * inv_momentum_delta[0]);
-            my_i = (unsigned int) floor( (momentum_y[ip] - momentum_min[1]) * inv_momentum_delta[1]);
-            mz_i = (unsigned int) floor( (momentum_z[ip] - momentum_min[2]) * inv_momentum_delta[2]);
+            mx_i = (unsigned int) floor( (momentum_x[ip] - px_ref) * inv_dpx);
+            my_i = (unsigned int) floor( (momentum_y[ip] - py_ref) * inv_dpy);
+            mz_i = (unsigned int) floor( (momentum_z[ip] - pz_ref) * inv_dpz);
 
             // 1D Index in the momentum discretization
-            momentum_cell_index[ipr] = mz_i * dim[0]*dim[1]
-                          + my_i * dim[0] + mx_i;
+            momentum_cell_index[ipr] = mz_i * stride_z
+                          + my_i * stride_y + mx_i;
 
             // if (momentum_cell_index[ipr] >= momentum_cells) {
             // 
@@ -820,20 +804,6 @@ void MergingVranicCartesian::operator() (
                 }
             }
         }
-
-        // Free aligned arrays
-        // free(gamma);
-        // free(momentum_cell_index);
-        // free(sorted_particles);
-        // free(particles_per_momentum_cells);
-        // free(momentum_cell_particle_index);
-        
-        // Free arrays
-        delete [] gamma;
-        delete [] momentum_cell_index;
-        delete [] sorted_particles;
-        delete [] particles_per_momentum_cells;
-        delete [] momentum_cell_particle_index;
     }
 
 }
@@ -6,6 +6,7 @@
 #include "SpeciesVAdaptive.h"
 #include "SpeciesV.h"
 #include "ElectroMagn.h"
+#include "FieldBufferPool.h"
 #include "Interpolator.h"
 #include "Projector.h"
 #include "SmileiMPI.h"
@@ -257,9 +258,20 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
                 
                 mypatch->EMfields->laserDisabled();
                 mypatch->EMfields->updateGridSize( params, mypatch );
+
+                // Species densities of the new patch are allocated again at the next diagnostic step
+                if( vecPatches.lazy_species_densities_ ) {
+                    mypatch->EMfields->releaseRhoJs( mypatch->vecSpecies );
+                }
             }
         }
         
+        // The field buffers of the patches deleted below are kept for the patches created at the next shift
+        if( !params.gpu_computing ) {
+            FieldBufferPool<double>::startCollecting();
+            FieldBufferPool<std::complex<double>>::startCollecting();
+        }
+        
         //Wait for sends to be completed
         
 #ifndef _NO_MPI_TM
@@ -628,6 +640,9 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
     #pragma omp barrier
     #pragma omp master
     {
+        FieldBufferPool<double>::stopCollecting();
+        FieldBufferPool<std::complex<double>>::stopCollecting();
+        
         // for( unsigned int i=0; i<vecPatches.size(); i++ ){
         //     MESSAGE(vecPatches(i)->vecSpecies[0]->getNrjOutMW());
         // }
@@ -12,6 +12,7 @@
 #include "SmileiMPI.h"
 #include "H5.h"
 #include "LaserPropagator.h"
+#include "PoissonFFT.h"
 
 #include "pyinit.pyh"
 #include "pyprofiles.pyh"
@@ -234,7 +235,10 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
 
     restart = false;
     std::vector<std::string> _unused_restart_files;
-    if( PyTools::nComponents( "Checkpoints" )>0 && PyTools::extractV( "restart_files", _unused_restart_files, "Checkpoints" ) ) {
+    // With restart_dir, only the master knows the restart files at this point
+    if( PyTools::nComponents( "Checkpoints" )>0
+        && ( PyTools::extractV( "restart_files", _unused_restart_files, "Checkpoints" )
+             || PyTools::extract_py( "restart_dir", "Checkpoints" ) != Py_None ) ) {
         MESSAGE( 1, "Code will restart" );
         restart=true;
     }
@@ -270,13 +274,28 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         full_B_exchange = true;
     } else if( maxwell_sol == "picsar" ) {
         is_pxr = true;
+    } else if( maxwell_sol == "PSATD" ) {
+        // Native spectral solver (FFTW), on the same grids as the picsar solvers
+        is_spectral = true;
+        is_pxr = true;
+        full_B_exchange = true;
     }
 
 #ifndef _PICSAR
-    if (is_pxr) {
+    if (is_pxr && maxwell_sol != "PSATD") {
         ERROR_NAMELIST( "Smilei not linked with picsar, use make config=picsar", "https://smileipic.github.io/Smilei/install_PICSAR.html" );
     }
 #endif
+    if( maxwell_sol == "PSATD" ) {
+#ifndef _FFTW
+        ERROR_NAMELIST( "Main.maxwell_solver = \"PSATD\" requires Smilei to be compiled with FFTW (make config=fftw)",
+                        LINK_NAMELIST + std::string("#main-variables") );
+#endif
+        if( geometry != "2Dcartesian" && geometry != "3Dcartesian" ) {
+            ERROR_NAMELIST( "Main.maxwell_solver = \"PSATD\" is only available in 2Dcartesian and 3Dcartesian geometries",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+    }
 
     // interpolation order
     PyTools::extract( "interpolation_order", interpolation_order, "Main"  );
@@ -548,6 +567,22 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main"   );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main"   );
     PyTools::extract( "relativistic_poisson_max_error", relativistic_poisson_max_error, "Main"   );
+    // Algorithm used by both solvers
+    PyTools::extract( "poisson_solver", poisson_solver, "Main"   );
+    if( poisson_solver != "CG" && poisson_solver != "pipelined_PCG" && poisson_solver != "FFT" ) {
+        ERROR_NAMELIST( "Main.poisson_solver must be \"CG\", \"pipelined_PCG\" or \"FFT\"",
+                        LINK_NAMELIST + std::string("#main-variables") );
+    }
+    std::string poisson_fft_reason;
+    if( poisson_solver == "FFT" && !PoissonFFT::isAvailable( *this, poisson_fft_reason ) ) {
+        WARNING( "Main.poisson_solver = \"FFT\" changed to \"CG\": " << poisson_fft_reason );
+        poisson_solver = "CG";
+    }
+    PyTools::extract( "poisson_chebyshev_degree", poisson_chebyshev_degree, "Main"   );
+    if( poisson_chebyshev_degree < 1 ) {
+        ERROR_NAMELIST( "Main.poisson_chebyshev_degree must be at least 1",
+                        LINK_NAMELIST + std::string("#main-variables") );
+    }
 
     // Use BTIS3 interpolation method to reduce the effects of numerical Cherenkov radiation
     // This method is detailed in P.-L. Bourgeois and X. Davoine (2023) https://doi.org/10.1017/S0022377823000223
@@ -562,6 +597,7 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     }
     
     // Current filter properties
+    currentFilter_passes_per_exchange = 1;
     int nCurrentFilter = PyTools::nComponents( "CurrentFilter" );
     for( int ifilt = 0; ifilt < nCurrentFilter; ifilt++ ) {
         PyTools::extract( "model", currentFilter_model, "CurrentFilter", ifilt );
@@ -589,6 +625,11 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         } else if( currentFilter_passes.size() != nDim_field ) {
             ERROR_NAMELIST( "passes in block 'CurrentFilter' must be the same size as the number of field dimensions",  LINK_NAMELIST + std::string("#current-filtering") );
         }
+
+        PyTools::extract( "passes_per_exchange", currentFilter_passes_per_exchange, "CurrentFilter", ifilt );
+        if( currentFilter_passes_per_exchange < 1 ) {
+            ERROR_NAMELIST( "passes_per_exchange in block 'CurrentFilter' must be >= 1",  LINK_NAMELIST + std::string("#current-filtering") );
+        }
     }
 
     // Field filter properties
@@ -614,6 +655,16 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         }
     }
 
+    // Patches where E, B and J are identically zero skip the Maxwell solvers
+    PyTools::extract( "skip_quiescent_patches", skip_quiescent_patches, "Main"  );
+#ifdef SMILEI_ACCELERATOR_GPU
+    skip_quiescent_patches = false;
+#endif
+    if( skip_quiescent_patches && ( is_spectral || is_pxr || geometry == "AMcylindrical" || Friedman_filter || use_BTIS3 ) ) {
+        ERROR_NAMELIST( "Main.skip_quiescent_patches is only available with finite-difference solvers in cartesian geometries, without FieldFilter and B-TIS3",
+                        LINK_NAMELIST + std::string("#main-variables") );
+    }
+
 
     // testing the CFL condition
     //!\todo (MG) CFL cond. depends on the Maxwell solv. ==> HERE JUST DONE FOR YEE!!!
@@ -702,9 +753,33 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
 #endif
 
 
-    spectral_solver_order.resize( nDim_field, 1 );
+    // Infinite order by default with PSATD, the only order it supports
+    spectral_solver_order.resize( nDim_field, maxwell_sol == "PSATD" ? 0 : 1 );
     PyTools::extractV( "spectral_solver_order", spectral_solver_order, "Main" );
 
+    galilean_velocity.resize( 3, 0. );
+    if( maxwell_sol == "PSATD" ) {
+        for( unsigned int i=0; i<spectral_solver_order.size(); i++ ) {
+            if( spectral_solver_order[i] != 0 ) {
+                ERROR_NAMELIST( "Main.spectral_solver_order must be 0 (infinite order) with Main.maxwell_solver = \"PSATD\"",
+                                LINK_NAMELIST + std::string("#main-variables") );
+            }
+        }
+        PyTools::extractV( "galilean_velocity", galilean_velocity, "Main" );
+        if( galilean_velocity.size() != 3 ) {
+            ERROR_NAMELIST( "Main.galilean_velocity must have 3 components",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        double v2 = 0.;
+        for( unsigned int i=0; i<3; i++ ) {
+            v2 += galilean_velocity[i]*galilean_velocity[i];
+        }
+        if( v2 >= 1. ) {
+            ERROR_NAMELIST( "Main.galilean_velocity must be smaller than the speed of light",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+    }
+
     initial_rotational_cleaning = false;
     if( is_spectral && geometry == "AMcylindrical" ) {
         PyTools::extract( "initial_rotational_cleaning", initial_rotational_cleaning, "Main" );
@@ -831,6 +906,10 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             ERROR_NAMELIST( "In block `Vectorization`, parameter `initial_mode` must be `off` or `on`",  LINK_NAMELIST + std::string("#vectorization") );
         }
 
+        // Cost model calibrated at startup on the current CPU
+        adaptive_calibration_file = "";
+        PyTools::extract( "calibration_file", adaptive_calibration_file, "Vectorization"   );
+
         // get parameter "every" which describes a timestep selection
         if( ! adaptive_vecto_time_selection )
             adaptive_vecto_time_selection = new TimeSelection(
@@ -857,6 +936,16 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
 #endif
     }
 
+    PyTools::extract( "node_aware_exchange", node_aware_exchange, "Main" );
+    if( node_aware_exchange && gpu_computing ) {
+        ERROR_NAMELIST( "`node_aware_exchange` is not available with `gpu_computing`",  LINK_NAMELIST + std::string("#main-variables") );
+    }
+
+    PyTools::extract( "node_aware_mapping_tolerance", node_aware_mapping_tolerance, "Main" );
+    if( node_aware_mapping_tolerance < 0. || node_aware_mapping_tolerance > 0.5 ) {
+        ERROR_NAMELIST( "`node_aware_mapping_tolerance` must be between 0 and 0.5",  LINK_NAMELIST + std::string("#main-variables") );
+    }
+
     // In case of collisions, ensure particle sort per cell
     if( PyTools::nComponents( "Collisions" ) > 0 ) {
 
@@ -887,6 +976,20 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     // Read the "print_expected_disk_usage" parameter
     PyTools::extract( "print_expected_disk_usage", print_expected_disk_usage, "Main"   );
 
+    // Read the memory allowed for the asynchronous output of the global diagnostics
+    PyTools::extract( "async_diagnostics_buffer", async_diagnostics_buffer, "Main"   );
+    if( async_diagnostics_buffer < 0. ) {
+        ERROR_NAMELIST( "`async_diagnostics_buffer` must be positive or zero",
+                        LINK_NAMELIST + std::string("#main-variables") );
+    }
+
+    // Read the number of MPI processes per subfile
+    PyTools::extract( "subfiling", subfiling, "Main"   );
+    if( subfiling < -1 ) {
+        ERROR_NAMELIST( "`subfiling` must be -1 (one subfile per node), 0 (no subfiling) or positive",
+                        LINK_NAMELIST + std::string("#main-variables") );
+    }
+
     // Decide when necessary to keep position_old
     keep_position_old = false;
     DEBUGEXEC( keep_position_old = true );
@@ -899,6 +1002,7 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
 
     double mass, mass2=0;
     std::string merging_method;
+    std::string splitting_method;
 
     for( unsigned int ispec = 0; ispec < tot_species_number; ispec++ ) {
         PyTools::extract( "mass", mass, "Species", ispec );
@@ -922,13 +1026,24 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             cell_sorting_ = true;
 
         }
+        //Use cell sorting if split is used.
+        PyTools::extract( "splitting_method", splitting_method, "Species", ispec );
+        if (splitting_method != "none"){
+
+            if (defined_cell_sort && !cell_sorting_){
+                ERROR_NAMELIST(" Cell sorting or vectorization must be allowed in order to use particle splitting.",  LINK_NAMELIST + std::string("#particle-splitting"));
+            }
+
+            cell_sorting_ = true;
+
+        }
     }
 
     // Force adaptive vectorization in scalar mode if cell_sorting requested
     if ( cell_sorting_ ) {
 
         if( vectorization_mode == "adaptive_mixed_sort" ) {
-            ERROR_NAMELIST( "Cell sorting (required by Collision or Merging) is incompatible with the vectorization mode 'adaptive_mixed_sort'.",  LINK_NAMELIST + std::string("#vectorization") );
+            ERROR_NAMELIST( "Cell sorting (required by Collision, Merging or Splitting) is incompatible with the vectorization mode 'adaptive_mixed_sort'.",  LINK_NAMELIST + std::string("#vectorization") );
         } else if ( vectorization_mode == "off" ) {
             vectorization_mode            = "adaptive";
             has_adaptive_vectorization    = true;
@@ -1187,6 +1302,66 @@ void Params::compute()
     n_cell_per_patch = 1;
 
     multiple_decomposition = PyTools::nComponents( "MultipleDecomposition" )>0;
+    // The Fourier transforms of the PSATD solver see the transformed fields as periodic:
+    // patches are too small for the errors at their edges to remain in the ghost cells
+    if( maxwell_sol == "PSATD" && ! multiple_decomposition ) {
+        ERROR_NAMELIST( "Main.maxwell_solver = \"PSATD\" requires a MultipleDecomposition block",
+                        LINK_NAMELIST + std::string("#multiple-decomposition-of-the-domain") );
+    }
+
+    // Wide halos : E and B are computed redundantly in deeper ghost cells and exchanged less often
+    PyTools::extract( "exchange_fields_each", exchange_fields_each, "Main"  );
+    if( exchange_fields_each < 1 ) {
+        ERROR_NAMELIST( "Main.exchange_fields_each must be at least 1", LINK_NAMELIST + std::string("#main-variables") );
+    }
+    if( exchange_fields_each > 1 ) {
+        if( maxwell_sol != "Yee" || geometry == "AMcylindrical" ) {
+            ERROR_NAMELIST( "Main.exchange_fields_each > 1 is only available with the Yee solver in cartesian geometries",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        if( multiple_decomposition ) {
+            ERROR_NAMELIST( "Main.exchange_fields_each > 1 is not available with MultipleDecomposition (SDMD)",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        // The PML domains exchange E and B with the patches at every iteration
+        for( unsigned int iDim = 0 ; iDim < EM_BCs.size() ; iDim++ ) {
+            if( EM_BCs[iDim][0] == "PML" || EM_BCs[iDim][1] == "PML" ) {
+                ERROR_NAMELIST( "Main.exchange_fields_each > 1 is not available with PML boundary conditions",
+                                LINK_NAMELIST + std::string("#main-variables") );
+            }
+        }
+        // B-TIS3 interpolates the additional fields BTIS3, exchanged with B at every iteration
+        if( use_BTIS3 ) {
+            ERROR_NAMELIST( "Main.exchange_fields_each > 1 is not available with the B-TIS3 interpolation",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        // The envelope and its susceptibility are exchanged with their own ghost cells at every iteration
+        if( Laser_Envelope_model ) {
+            ERROR_NAMELIST( "Main.exchange_fields_each > 1 is not available with envelope models",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+    }
+
+    // Temporal blocking : the Maxwell steps of vacuum patches are deferred up to the next exchange of E and B
+    PyTools::extract( "temporal_blocking", temporal_blocking, "Main"  );
+#ifdef SMILEI_ACCELERATOR_GPU
+    temporal_blocking = false;
+#endif
+    if( temporal_blocking ) {
+        if( geometry != "3Dcartesian" || maxwell_sol != "Yee" || Friedman_filter ) {
+            ERROR_NAMELIST( "Main.temporal_blocking is only available with the Yee solver in 3Dcartesian geometry",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        if( exchange_fields_each < 2 ) {
+            ERROR_NAMELIST( "Main.temporal_blocking requires Main.exchange_fields_each > 1",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+        // The fields of a patch are modified, or sent to another patch, outside of the Maxwell solver
+        if( PyTools::nComponents( "MovingWindow" ) > 0 || PyTools::nComponents( "PrescribedField" ) > 0 || solve_relativistic_poisson ) {
+            ERROR_NAMELIST( "Main.temporal_blocking is not available with a moving window, prescribed fields or the relativistic Poisson solver",
+                            LINK_NAMELIST + std::string("#main-variables") );
+        }
+    }
 
     // compute number of cells & normalized lengths
     for( unsigned int i=0; i<nDim_field; i++ ) {
@@ -1214,11 +1389,21 @@ void Params::compute()
         }
         if( ! multiple_decomposition ) {
             oversize[i]  = std::max( interpolation_order, std::max( ( unsigned int )( spectral_solver_order[i]/2+1 ),custom_oversize ) ) + ( exchange_particles_each-1 );
+            // Each iteration without exchange invalidates one more cell of E and one more cell of B at the edge of the ghost region
+            oversize[i] += 2*( exchange_fields_each-1 );
+            // Each filter pass without exchange invalidates as many cells as the half-width of the filter kernel
+            if( currentFilter_passes_per_exchange > 1 ) {
+                unsigned int filter_half_width = ( currentFilter_model == "customFIR" ) ? ( currentFilter_kernelFIR.size()-1 )/2 : 1;
+                oversize[i] = std::max( oversize[i], currentFilter_passes_per_exchange * filter_half_width );
+            }
             if( currentFilter_model == "customFIR" && oversize[i] < (currentFilter_kernelFIR.size()-1)/2 ) {
                 ERROR_NAMELIST( "With the `customFIR` current filter model, the ghost cell number (oversize) = " << oversize[i] << " have to be >= " << (currentFilter_kernelFIR.size()-1)/2 << ", the (kernelFIR size - 1)/2", LINK_NAMELIST + std::string("#current-filtering")  );
             }
         } else {
             oversize[i] = interpolation_order + ( exchange_particles_each-1 );
+            if( currentFilter_passes_per_exchange > 1 ) {
+                ERROR_NAMELIST( "`passes_per_exchange` in block 'CurrentFilter' is not available with the multiple decomposition", LINK_NAMELIST + std::string("#current-filtering") );
+            }
         }
         global_size_[i] = patch_size_[i];
         patch_size_[i] /= number_of_patches[i];
@@ -1445,6 +1630,9 @@ void Params::print_init()
                 std::string strpass = (currentFilter_passes[idim] > 1 ? "passes" : "pass");
                 MESSAGE( 1, currentFilter_model << " current filtering: " << currentFilter_passes[idim] << " " << strpass << " along dimension " << idim );
             }
+            if( currentFilter_passes_per_exchange > 1 ) {
+                MESSAGE( 1, "Currents exchanged every " << currentFilter_passes_per_exchange << " passes" );
+            }
         }
     }
     if( Friedman_filter ) {
@@ -1469,6 +1657,9 @@ void Params::print_init()
     if( vectorization_mode == "adaptive_mixed_sort" || vectorization_mode == "adaptive" ) {
         MESSAGE( 1, "Default mode: " << adaptive_default_mode );
         MESSAGE( 1, "Time selection: " << adaptive_vecto_time_selection->info() );
+        if( adaptive_calibration_file != "" ) {
+            MESSAGE( 1, "Cost model calibrated on this CPU, cached in: " << adaptive_calibration_file );
+        }
     }
 
 }
@@ -1668,6 +1859,10 @@ void Params::multiple_decompose()
     for( unsigned int i=0; i<nDim_field; i++ ) {
         region_oversize[i] = std::max( region_oversize[i], region_ghost_cells );
     }
+    if( maxwell_sol == "PSATD" && region_ghost_cells < 8 ) {
+        ERROR_NAMELIST( "MultipleDecomposition.region_ghost_cells = " << region_ghost_cells << " should be at least 8 with Main.maxwell_solver = \"PSATD\"",
+                        LINK_NAMELIST + std::string("#multiple-decomposition-of-the-domain") );
+    }
     if( is_spectral && geometry == "AMcylindrical" )  {
         //Force ghost cells number in L when spectral
         region_oversize[0] = region_ghost_cells;
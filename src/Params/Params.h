@@ -170,6 +170,11 @@ public:
     //! Maxium relativistic poisson error tolerated
     double relativistic_poisson_max_error;
 
+    //! Algorithm of the (relativistic) Poisson solvers: "CG" or "pipelined_PCG"
+    std::string poisson_solver;
+    //! Degree of the Chebyshev polynomial preconditioner of the pipelined_PCG solver
+    unsigned int poisson_chebyshev_degree;
+
     //! Do we need to exchange full B (default=0 <=> only 2 components are exchanged by dimension)
     bool full_B_exchange;
     //! Do we need to exchange full A,Phi,Chi (default=0 <=> only 2 components are exchanged by dimension)
@@ -182,6 +187,8 @@ public:
     std::vector<unsigned int> currentFilter_passes;
     std::string currentFilter_model;
     std::vector<double> currentFilter_kernelFIR;
+    //! Current spatial filter: number of passes between two exchanges of the currents
+    unsigned int currentFilter_passes_per_exchange;
 
     //! is Friedman filter applied [Greenwood et al., J. Comp. Phys. 201, 665 (2004)]
     bool Friedman_filter;
@@ -263,6 +270,15 @@ public:
 
     //! frequency of exchange particles (default = 1, disabled for now, incompatible with sort)
     int exchange_particles_each;
+
+    //! frequency of the E and B exchanges between patches (default = 1), the ghost cells are widened accordingly
+    unsigned int exchange_fields_each;
+
+    //! skip the Maxwell solvers in the patches where E, B and J are identically zero
+    bool skip_quiescent_patches;
+
+    //! defer the Maxwell solvers in the patches without particles nor currents, up to the next exchange of E and B
+    bool temporal_blocking;
     
     //! frequency to apply shrinkToFit on particles structure
     int every_clean_particles_overhead;
@@ -273,6 +289,10 @@ public:
     std::vector<unsigned int> number_of_patches;
     //! Domain decomposition
     std::string patch_arrangement;
+    //! Aggregate the MPI messages of the field exchanges per MPI process, shared memory on a same node
+    bool node_aware_exchange;
+    //! Fraction of the patches of a MPI process which may be moved to reduce the surface between nodes
+    double node_aware_mapping_tolerance;
 
     //! Time selection for adaptive vectorization
     TimeSelection *adaptive_vecto_time_selection;
@@ -296,6 +316,10 @@ public:
     std::string vectorization_mode;
     //! Initial state of the patches in adaptive mode
     std::string adaptive_default_mode;
+    //! File caching the cost model of the adaptive mode calibrated on the current CPU ("" for the built-in model)
+    std::string adaptive_calibration_file;
+    //! Coefficients of the calibrated cost model (polynomials of the log of the number of particles per cell)
+    std::vector<double> adaptive_vecto_fit, adaptive_scalar_fit;
 
     //! Tells whether there is a moving window
     bool hasWindow;
@@ -346,10 +370,18 @@ public:
     bool  is_spectral;
     bool  is_pxr;
     std::vector<int> spectral_solver_order;
+    //! velocity of the currents during a timestep in the PSATD solver (Galilean-equivalent scheme)
+    std::vector<double> galilean_velocity;
 
     //! Boolean for printing the expected disk usage or not
     bool print_expected_disk_usage;
 
+    //! Memory (MB) for the asynchronous output of the global diagnostics by the MPI master (0 = synchronous)
+    double async_diagnostics_buffer;
+
+    //! Number of MPI processes per output subfile (0 = shared files, -1 = one subfile per node)
+    int subfiling;
+
     //! Random seed
     unsigned int random_seed;
     
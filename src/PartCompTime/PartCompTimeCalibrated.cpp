@@ -0,0 +1,47 @@
+#include "PartCompTimeCalibrated.h"
+
+#include <algorithm>
+
+PartCompTimeCalibrated::PartCompTimeCalibrated( const std::vector<double> &vecto_fit, const std::vector<double> &scalar_fit ) :
+    PartCompTime(),
+    vecto_fit_( vecto_fit.begin(), vecto_fit.end() ),
+    scalar_fit_( scalar_fit.begin(), scalar_fit.end() )
+{
+};
+
+constexpr float PartCompTimeCalibrated::max_particle_number;
+
+// -----------------------------------------------------------------------------
+//! Evaluate the time (simple precision) to compute all particles
+//! in the current patch with vectorized operators
+//! @param count the numer of particles per cell
+//! @param vecto_time time in vector mode
+//! @param scalar_time time in scalar mode
+// -----------------------------------------------------------------------------
+void PartCompTimeCalibrated::operator()(  const std::vector<int> &count,
+                                float &vecto_time,
+                                float &scalar_time  )
+{
+    float vecto_time_loc = 0;
+    float scalar_time_loc = 0;
+    
+    // Loop over the cells
+    for( unsigned int ic=0; ic < count.size(); ic++ ) {
+        if( count[ic] > 0 ) {
+            // Max of the fit
+            float log_particle_number = log( std::min( float( count[ic] ), max_particle_number ) );
+            // Horner evaluation of the polynomials
+            float v = 0, s = 0;
+            for( int i = vecto_fit_.size()-1; i >= 0; i-- ) {
+                v = v * log_particle_number + vecto_fit_[i];
+            }
+            for( int i = scalar_fit_.size()-1; i >= 0; i-- ) {
+                s = s * log_particle_number + scalar_fit_[i];
+            }
+            vecto_time_loc += v*count[ic];
+            scalar_time_loc += s*count[ic];
+        }
+    }
+    scalar_time = scalar_time_loc;
+    vecto_time = vecto_time_loc;
+};
@@ -0,0 +1,38 @@
+#ifndef PARTCOMPTIMECALIBRATED_H
+#define PARTCOMPTIMECALIBRATED_H
+
+#include "PartCompTime.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PartCompTimeCalibrated
+//! Cost model fitted at startup on the current CPU (see PartCompTimeCalibration)
+//  --------------------------------------------------------------------------------------------------------------------
+class PartCompTimeCalibrated final : public PartCompTime
+{
+public:
+    //! @param vecto_fit, scalar_fit coefficients of the polynomials of the log of the number of particles per cell
+    PartCompTimeCalibrated( const std::vector<double> &vecto_fit, const std::vector<double> &scalar_fit );
+    ~PartCompTimeCalibrated() override final {};
+    
+    // -------------------------------------------------------------------------
+    //! Evaluate the time (simple precision) to compute all particles
+    //! in the current patch with vectorized operators
+    //! @param count the numer of particles per cell
+    //! @param vecto_time time in vector mode
+    //! @param scalar_time time in scalar mode
+    // -------------------------------------------------------------------------
+    virtual void operator() (   const std::vector<int> &count,
+                        float &vecto_time,
+                        float &scalar_time ) override final;
+    
+    //! Maximum number of particles per cell of the fit
+    static constexpr float max_particle_number = 256.;
+    
+private:
+    
+    std::vector<float> vecto_fit_;
+    std::vector<float> scalar_fit_;
+    
+};//END class PartCompTimeCalibrated
+
+#endif
@@ -0,0 +1,292 @@
+#include "PartCompTimeCalibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <mpi.h>
+
+#include "PartCompTimeCalibrated.h"
+#include "Params.h"
+#include "SmileiMPI.h"
+#include "VectorPatch.h"
+#include "Patch.h"
+#include "Species.h"
+#include "Particles.h"
+#include "ElectroMagn.h"
+#include "Interpolator.h"
+#include "InterpolatorFactory.h"
+#include "Projector.h"
+#include "ProjectorFactory.h"
+#include "Pusher.h"
+#include "Tools.h"
+
+using namespace std;
+
+void PartCompTimeCalibration::calibrate( VectorPatch &vecPatches, Params &params, SmileiMPI *smpi )
+{
+    if( params.adaptive_calibration_file == "" ) {
+        return;
+    }
+    
+    ostringstream key( "" );
+    key << params.geometry << " " << params.interpolation_order;
+    
+    vector<double> vecto_fit( n_coefficients, 0. ), scalar_fit( n_coefficients, 0. );
+    int found = 0;
+    
+    if( smpi->isMaster() ) {
+        if( read( params.adaptive_calibration_file, key.str(), vecto_fit, scalar_fit ) ) {
+            found = 1;
+            MESSAGE( 1, "Adaptive vectorization: cost model read from " << params.adaptive_calibration_file );
+        } else {
+            // Species whose operators are timed
+            Patch *patch = vecPatches( 0 );
+            Species *species = NULL;
+            for( unsigned int ispec = 0; ispec < patch->vecSpecies.size(); ispec++ ) {
+                Species *s = patch->vecSpecies[ispec];
+                if( s->mass_ > 0 && ! s->particles->is_test && s->Push ) {
+                    species = s;
+                    break;
+                }
+            }
+            
+            if( species ) {
+                MESSAGE( 1, "Adaptive vectorization: calibrating the cost model on this CPU with species " << species->name_ );
+                
+                // Numbers of particles per cell sampled up to the maximum of the fit
+                vector<double> log_npart, vecto_time, scalar_time;
+                for( unsigned int n : { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256 } ) {
+                    log_npart  .push_back( log( ( double )n ) );
+                    vecto_time .push_back( measure( params, smpi, patch, species, true , n ) );
+                    scalar_time.push_back( measure( params, smpi, patch, species, false, n ) );
+                }
+                
+                // Times are normalized by the average scalar time, as the built-in models
+                double norm = 0.;
+                for( unsigned int i = 0; i < scalar_time.size(); i++ ) {
+                    norm += scalar_time[i];
+                }
+                norm = scalar_time.size() / norm;
+                for( unsigned int i = 0; i < scalar_time.size(); i++ ) {
+                    vecto_time [i] *= norm;
+                    scalar_time[i] *= norm;
+                }
+                
+                vecto_fit  = fit( log_npart, vecto_time  );
+                scalar_fit = fit( log_npart, scalar_time );
+                found = 1;
+                
+                write( params.adaptive_calibration_file, key.str(), vecto_fit, scalar_fit );
+                MESSAGE( 1, "Adaptive vectorization: cost model written in " << params.adaptive_calibration_file );
+            } else {
+                WARNING( "Adaptive vectorization: no species to calibrate the cost model, the built-in model is used" );
+            }
+        }
+    }
+    
+    MPI_Bcast( &found, 1, MPI_INT, 0, smpi->world() );
+    if( ! found ) {
+        return;
+    }
+    MPI_Bcast( &vecto_fit [0], n_coefficients, MPI_DOUBLE, 0, smpi->world() );
+    MPI_Bcast( &scalar_fit[0], n_coefficients, MPI_DOUBLE, 0, smpi->world() );
+    
+    // Patches created later (load balancing, moving window) use the same model
+    params.adaptive_vecto_fit  = vecto_fit;
+    params.adaptive_scalar_fit = scalar_fit;
+    for( unsigned int ipatch = 0; ipatch < vecPatches.size(); ipatch++ ) {
+        for( unsigned int ispec = 0; ispec < vecPatches( ipatch )->vecSpecies.size(); ispec++ ) {
+            Species *s = vecPatches( ipatch )->vecSpecies[ispec];
+            delete s->part_comp_time_;
+            s->part_comp_time_ = new PartCompTimeCalibrated( vecto_fit, scalar_fit );
+        }
+    }
+}
+
+
+double PartCompTimeCalibration::measure( Params &params, SmileiMPI *smpi, Patch *patch, Species *species, bool vectorized, unsigned int npart_per_cell )
+{
+    // Cells as sorted by the vectorized operators: nodes of the primal grid
+    unsigned int nDim_field = params.nDim_field;
+    unsigned int ncells = 1;
+    vector<unsigned int> dims( nDim_field );
+    for( unsigned int idim = 0; idim < nDim_field; idim++ ) {
+        dims[idim] = params.patch_size_[idim] + 1;
+        ncells *= dims[idim];
+    }
+    // Large patches are only partially filled to bound the memory used
+    const unsigned int max_particles = 1 << 18;
+    unsigned int ncells_filled = min( ncells, max( 1u, max_particles / npart_per_cell ) );
+    unsigned int npart = ncells_filled * npart_per_cell;
+    
+    Particles particles;
+    particles.initialize( npart, *species->particles );
+    particles.first_index.assign( ncells, npart );
+    particles.last_index .assign( ncells, npart );
+    
+    // Particles at rest, spread regularly in their cell (no random number to keep the patch state unchanged)
+    for( unsigned int icell = 0; icell < ncells_filled; icell++ ) {
+        particles.first_index[icell] = icell * npart_per_cell;
+        particles.last_index [icell] = ( icell + 1 ) * npart_per_cell;
+        vector<unsigned int> index( nDim_field );
+        for( int idim = nDim_field-1, rest = icell; idim >= 0; idim-- ) {
+            index[idim] = rest % dims[idim];
+            rest /= dims[idim];
+        }
+        for( unsigned int ip = 0; ip < npart_per_cell; ip++ ) {
+            unsigned int ipart = icell * npart_per_cell + ip;
+            for( unsigned int idim = 0; idim < nDim_field; idim++ ) {
+                double dx = params.cell_length[idim];
+                double xmin = patch->getDomainLocalMin( idim ), xmax = patch->getDomainLocalMax( idim );
+                double frac = fmod( ( ip + 0.5 ) * ( idim + 1 ) * 0.6180339887498949, 1. ) - 0.5;
+                double x = ( round( xmin / dx ) + index[idim] + frac ) * dx;
+                particles.position( idim, ipart ) = min( max( x, xmin + 0.01*dx ), xmax - 0.01*dx );
+            }
+            for( unsigned int idim = nDim_field; idim < params.nDim_particle; idim++ ) {
+                particles.position( idim, ipart ) = 0.;
+            }
+            for( unsigned int idim = 0; idim < 3; idim++ ) {
+                particles.momentum( idim, ipart ) = 0.;
+            }
+            particles.weight( ipart ) = 1.;
+            particles.charge( ipart ) = 1;
+        }
+    }
+    
+    Interpolator *Interp = InterpolatorFactory::create( params, patch, vectorized );
+    Projector *Proj = ProjectorFactory::create( params, patch, vectorized );
+    ElectroMagn *EMfields = patch->EMfields;
+    smpi->resizeBuffers( 0, nDim_field, npart, params.geometry == "AMcylindrical" );
+    
+    // Best of a few repetitions of the operators called as in SpeciesV and SpeciesVAdaptive
+    double best = 0.;
+    for( unsigned int irep = 0; irep < 3; irep++ ) {
+        double t0 = MPI_Wtime();
+        if( vectorized ) {
+            for( unsigned int scell = 0; scell < ncells_filled; scell++ ) {
+                Interp->fieldsWrapper( EMfields, particles, smpi, &( particles.first_index[scell] ), &( particles.last_index[scell] ), 0, scell, 0 );
+            }
+            ( *species->Push )( particles, smpi, 0, npart, 0, 0 );
+            for( unsigned int scell = 0; scell < ncells_filled; scell++ ) {
+                Proj->currentsAndDensityWrapper( EMfields, particles, smpi, particles.first_index[scell], particles.last_index[scell], 0, false, params.is_spectral, 0, scell, 0 );
+            }
+        } else {
+            int istart = 0, iend = npart;
+            Interp->fieldsWrapper( EMfields, particles, smpi, &istart, &iend, 0 );
+            ( *species->Push )( particles, smpi, 0, npart, 0, 0 );
+            Proj->currentsAndDensityWrapper( EMfields, particles, smpi, 0, npart, 0, false, params.is_spectral, 0 );
+        }
+        double t = MPI_Wtime() - t0;
+        if( irep == 0 || t < best ) {
+            best = t;
+        }
+    }
+    
+    // The currents projected by the benchmark are discarded
+    EMfields->restartRhoJ();
+    delete Interp;
+    delete Proj;
+    
+    return best / npart;
+}
+
+
+vector<double> PartCompTimeCalibration::fit( const vector<double> &x, const vector<double> &y )
+{
+    const unsigned int n = n_coefficients;
+    
+    // Normal equations
+    vector<vector<double> > A( n, vector<double>( n+1, 0. ) );
+    for( unsigned int k = 0; k < x.size(); k++ ) {
+        vector<double> xp( 2*n, 1. );
+        for( unsigned int i = 1; i < 2*n; i++ ) {
+            xp[i] = xp[i-1] * x[k];
+        }
+        for( unsigned int i = 0; i < n; i++ ) {
+            for( unsigned int j = 0; j < n; j++ ) {
+                A[i][j] += xp[i+j];
+            }
+            A[i][n] += xp[i] * y[k];
+        }
+    }
+    
+    // Gaussian elimination with partial pivoting
+    for( unsigned int i = 0; i < n; i++ ) {
+        unsigned int p = i;
+        for( unsigned int r = i+1; r < n; r++ ) {
+            if( abs( A[r][i] ) > abs( A[p][i] ) ) {
+                p = r;
+            }
+        }
+        swap( A[i], A[p] );
+        for( unsigned int r = i+1; r < n; r++ ) {
+            double f = A[r][i] / A[i][i];
+            for( unsigned int c = i; c <= n; c++ ) {
+                A[r][c] -= f * A[i][c];
+            }
+        }
+    }
+    vector<double> coefficients( n, 0. );
+    for( int i = n-1; i >= 0; i-- ) {
+        double s = A[i][n];
+        for( unsigned int c = i+1; c < n; c++ ) {
+            s -= A[i][c] * coefficients[c];
+        }
+        coefficients[i] = s / A[i][i];
+    }
+    return coefficients;
+}
+
+
+bool PartCompTimeCalibration::read( string file, string key, vector<double> &vecto_fit, vector<double> &scalar_fit )
+{
+    ifstream f( file );
+    if( ! f.is_open() ) {
+        return false;
+    }
+    string line;
+    // Skip the comment
+    getline( f, line );
+    if( ! getline( f, line ) || line != key ) {
+        WARNING( "Adaptive vectorization: " << file << " was calibrated for `" << line << "`, not `" << key << "`" );
+        return false;
+    }
+    for( vector<double> *coefficients : { &vecto_fit, &scalar_fit } ) {
+        if( ! getline( f, line ) ) {
+            return false;
+        }
+        istringstream s( line );
+        string name;
+        s >> name;
+        for( unsigned int i = 0; i < n_coefficients; i++ ) {
+            if( ! ( s >> ( *coefficients )[i] ) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+void PartCompTimeCalibration::write( string file, string key, const vector<double> &vecto_fit, const vector<double> &scalar_fit )
+{
+    ofstream f( file );
+    if( ! f.is_open() ) {
+        WARNING( "Adaptive vectorization: cannot write " << file );
+        return;
+    }
+    f << "# Smilei adaptive vectorization cost model: coefficients of polynomials of log(particles per cell)" << endl;
+    f << key << endl;
+    f.precision( 16 );
+    f << "vecto";
+    for( unsigned int i = 0; i < n_coefficients; i++ ) {
+        f << " " << vecto_fit[i];
+    }
+    f << endl << "scalar";
+    for( unsigned int i = 0; i < n_coefficients; i++ ) {
+        f << " " << scalar_fit[i];
+    }
+    f << endl;
+}
@@ -0,0 +1,41 @@
+#ifndef PARTCOMPTIMECALIBRATION_H
+#define PARTCOMPTIMECALIBRATION_H
+
+#include <string>
+#include <vector>
+
+class Params;
+class SmileiMPI;
+class VectorPatch;
+class Patch;
+class Species;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PartCompTimeCalibration
+//! Fits the cost model of the adaptive vectorization on the current CPU: the master MPI process times the scalar
+//! and vectorized operators (interpolation, push, projection) on particles distributed uniformly in one patch,
+//! for several numbers of particles per cell. The fit is cached in Params::adaptive_calibration_file.
+//  --------------------------------------------------------------------------------------------------------------------
+class PartCompTimeCalibration
+{
+public:
+    //! Read the cached fit, or calibrate, then set the cost model of all species.
+    //! Collective: must be called by all MPI processes.
+    static void calibrate( VectorPatch &vecPatches, Params &params, SmileiMPI *smpi );
+    
+private:
+    //! Number of coefficients of the fitted polynomials
+    static const unsigned int n_coefficients = 5;
+    
+    //! Time (s) to compute one particle, for npart_per_cell particles per cell
+    static double measure( Params &params, SmileiMPI *smpi, Patch *patch, Species *species, bool vectorized, unsigned int npart_per_cell );
+    
+    //! Least-square fit of a polynomial of x
+    static std::vector<double> fit( const std::vector<double> &x, const std::vector<double> &y );
+    
+    //! Read/write the fit from/to the cache file. The key identifies the geometry and order of the fit.
+    static bool read( std::string file, std::string key, std::vector<double> &vecto_fit, std::vector<double> &scalar_fit );
+    static void write( std::string file, std::string key, const std::vector<double> &vecto_fit, const std::vector<double> &scalar_fit );
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "PartCompTime3D2Order.h"
 #include "PartCompTime3D4Order.h"
 #include "PartCompTimeAM2Order.h"
+#include "PartCompTimeCalibrated.h"
 
 #include "Params.h"
 #include "Tools.h"
@@ -20,9 +21,17 @@ public:
         
         PartCompTime * part_comp_time = NULL;
         // ---------------
+        // Model calibrated on the current CPU
+        // ---------------
+        if( ! params.adaptive_vecto_fit.empty() ) {
+        
+            part_comp_time = new PartCompTimeCalibrated( params.adaptive_vecto_fit, params.adaptive_scalar_fit );
+        
+        }
+        // ---------------
         // 1Dcartesian simulation
         // ---------------
-        if( ( params.geometry == "1Dcartesian" ) && ( params.interpolation_order == 2 ) ) {
+        else if( ( params.geometry == "1Dcartesian" ) && ( params.interpolation_order == 2 ) ) {
         
             part_comp_time = new PartCompTime1D2Order();
         
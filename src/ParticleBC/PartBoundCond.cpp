@@ -271,3 +271,61 @@ PartBoundCond::PartBoundCond( Params &params, Species *species, Patch *patch )
 PartBoundCond::~PartBoundCond()
 {
 }
+
+
+void PartBoundCond::flagOutgoing( Species *species, int imin, int imax, std::vector<int> &outgoing )
+{
+    int *const cell_keys = species->particles->getPtrCellKeys();
+    const double *const position_x = species->particles->getPtrPosition( 0 );
+
+    // Vectorized pass: cell_keys temporarily holds 1 for the particles out of the patch
+    if( isAM ) {
+        const double *const position_y = species->particles->getPtrPosition( 1 );
+        const double *const position_z = species->particles->getPtrPosition( 2 );
+        const double r_min2 = y_min*y_min;
+        const double r_max2 = y_max*y_max;
+        #pragma omp simd
+        for( int ipart = imin; ipart < imax; ipart++ ) {
+            const double r2 = position_y[ipart]*position_y[ipart] + position_z[ipart]*position_z[ipart];
+            cell_keys[ipart] = ( position_x[ipart] < x_min ) | ( position_x[ipart] >= x_max )
+                             | ( r2 < r_min2 ) | ( r2 >= r_max2 );
+        }
+    } else if( nDim_particle == 1 ) {
+        #pragma omp simd
+        for( int ipart = imin; ipart < imax; ipart++ ) {
+            cell_keys[ipart] = ( position_x[ipart] < x_min ) | ( position_x[ipart] >= x_max );
+        }
+    } else if( nDim_particle == 2 ) {
+        const double *const position_y = species->particles->getPtrPosition( 1 );
+        #pragma omp simd
+        for( int ipart = imin; ipart < imax; ipart++ ) {
+            cell_keys[ipart] = ( position_x[ipart] < x_min ) | ( position_x[ipart] >= x_max )
+                             | ( position_y[ipart] < y_min ) | ( position_y[ipart] >= y_max );
+        }
+    } else {
+        const double *const position_y = species->particles->getPtrPosition( 1 );
+        const double *const position_z = species->particles->getPtrPosition( 2 );
+        #pragma omp simd
+        for( int ipart = imin; ipart < imax; ipart++ ) {
+            cell_keys[ipart] = ( position_x[ipart] < x_min ) | ( position_x[ipart] >= x_max )
+                             | ( position_y[ipart] < y_min ) | ( position_y[ipart] >= y_max )
+                             | ( position_z[ipart] < z_min ) | ( position_z[ipart] >= z_max );
+        }
+    }
+
+    // Compaction of the flagged particles, and reset of the cell keys
+    outgoing.clear();
+    for( int ipart = imin; ipart < imax; ipart++ ) {
+        if( cell_keys[ipart] ) {
+            outgoing.push_back( ipart );
+            cell_keys[ipart] = 0;
+        }
+    }
+}
+
+
+std::vector<int> &PartBoundCond::outgoingParticles()
+{
+    static thread_local std::vector<int> outgoing;
+    return outgoing;
+}
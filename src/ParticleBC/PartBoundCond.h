@@ -35,7 +35,28 @@ public:
     //! Method which applies particles boundary conditions.
     //! If the MPI process is not a border process, particles will be flagged as an exchange particle returning 0
     //! Conditions along X are applied first, then Y, then Z.
+    //! On CPU, the particles out of the patch are first flagged in a single pass over all directions, and the
+    //! conditions are only applied to them, unless they are numerous.
     inline void apply( Species *species, int imin, int imax, std::vector<double> &invgf, Random *rand, double &energy_tot )
+    {
+#if defined( SMILEI_ACCELERATOR_GPU )
+        applyToRange( species, imin, imax, invgf, rand, energy_tot );
+#else
+        std::vector<int> &outgoing = outgoingParticles();
+        flagOutgoing( species, imin, imax, outgoing );
+        if( outgoing.size() * dense_outgoing_ratio_ > ( size_t )( imax - imin ) ) {
+            // Many particles leave the patch: the range kernels are more efficient
+            applyConditions( species, imin, imax, invgf, rand, energy_tot );
+        } else {
+            for( size_t i = 0; i < outgoing.size(); i++ ) {
+                applyConditions( species, outgoing[i], outgoing[i]+1, invgf, rand, energy_tot );
+            }
+        }
+#endif
+    }
+
+    //! Apply the particles boundary conditions to all the particles of [imin, imax[
+    inline void applyToRange( Species *species, int imin, int imax, std::vector<double> &invgf, Random *rand, double &energy_tot )
     {
         if( parameters_->isGPUParticleBinningAvailable() ) {
             // EMPTY because we need the keys NOT to be cleared for the gpu particle clustering/binning.
@@ -56,6 +77,17 @@ public:
             }
         }
 
+        applyConditions( species, imin, imax, invgf, rand, energy_tot );
+    }
+
+    ////! Set the condition window if restart (patch position not read)
+    //inline void updateMvWinLimits( double x_moved ) {
+    //}
+    
+private:
+    //! Calls the conditions of all directions on the particles of [imin, imax[ (the cell keys must be reset)
+    inline void applyConditions( Species *species, int imin, int imax, std::vector<double> &invgf, Random *rand, double &energy_tot )
+    {
         double energy_change = 0.;
         ( *bc_xmin )( species, imin, imax, 0, x_min, dt_, invgf, rand, energy_change );
         energy_tot += energy_change;
@@ -75,11 +107,16 @@ public:
         }
     }
 
-    ////! Set the condition window if restart (patch position not read)
-    //inline void updateMvWinLimits( double x_moved ) {
-    //}
-    
-private:
+    //! Resets the cell keys of the particles of [imin, imax[ and lists those out of the patch,
+    //! the only ones which boundary conditions can concern
+    void flagOutgoing( Species *species, int imin, int imax, std::vector<int> &outgoing );
+
+    //! List of the particles out of the patch (one per thread, as bins may be processed concurrently)
+    static std::vector<int> &outgoingParticles();
+
+    //! Above 1 outgoing particle out of dense_outgoing_ratio_, the conditions are applied to the whole range
+    static const unsigned int dense_outgoing_ratio_ = 8;
+
     //! Min x coordinate of particles on the current processor (oversize not considered)
     double x_min;
     //! Max x coordinate of particles on the current processor (oversize not considered)
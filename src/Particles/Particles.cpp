@@ -458,6 +458,51 @@ void Particles::copyParticles( vector<size_t> indices, Particles &dest_parts, in
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Insert the particles of source, sorted by cell, at the end of each cell of the property dest.
+//! The cells are processed from the last one so that each particle is moved only once.
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void insertPerCell( vector<T> &dest, vector<T> &source, vector<int> &last_index, vector<int> &count )
+{
+    size_t end = dest.size();
+    size_t shift = source.size();
+    dest.resize( end + shift );
+    for( int icell = last_index.size()-1 ; icell >= 0 ; icell-- ) {
+        move_backward( dest.begin() + last_index[icell], dest.begin() + end, dest.begin() + end + shift );
+        end = last_index[icell];
+        shift -= count[icell];
+        copy( source.begin() + shift, source.begin() + shift + count[icell], dest.begin() + end + shift );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Insert the particles of source, sorted by cell, at the end of each cell (count[icell] in cell icell)
+//! with a single resize, instead of one insertion per cell
+//! cell keys not affected
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::insertParticlesPerCell( Particles &source, vector<int> &count )
+{
+    for( unsigned int iprop=0 ; iprop<double_prop_.size() ; iprop++ ) {
+        insertPerCell( *double_prop_[iprop], *source.double_prop_[iprop], last_index, count );
+    }
+
+    for( unsigned int iprop=0 ; iprop<short_prop_.size() ; iprop++ ) {
+        insertPerCell( *short_prop_[iprop], *source.short_prop_[iprop], last_index, count );
+    }
+
+    for( unsigned int iprop=0 ; iprop<uint64_prop_.size() ; iprop++ ) {
+        insertPerCell( *uint64_prop_[iprop], *source.uint64_prop_[iprop], last_index, count );
+    }
+
+    int shift = 0;
+    for( unsigned int icell=0 ; icell<last_index.size() ; icell++ ) {
+        first_index[icell] += shift;
+        shift += count[icell];
+        last_index[icell] += shift;
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 //! Make a new particle at the position of another
 //! cell keys not affected
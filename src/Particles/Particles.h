@@ -145,6 +145,8 @@ public:
     void copyParticles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id );
     //! Transfer particles indexed by array indices to dest_id in dest_parts
     void copyParticles( std::vector<size_t> indices, Particles &dest_parts, int dest_id );
+    //! Insert the particles of source, sorted by cell, at the end of each cell (count[icell] in cell icell)
+    void insertParticlesPerCell( Particles &source, std::vector<int> &count );
 
     //! Make a new particle at the position of another
     void makeParticleAt( Particles &source_particles, unsigned int ipart, double w, short q=0., double px=0., double py=0., double pz=0. );
@@ -512,6 +512,19 @@ void Patch::updateMPIenv( SmileiMPI *smpi )
 
 } // END updateMPIenv
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Whether no species has particles in the patch
+// ---------------------------------------------------------------------------------------------------------------------
+bool Patch::hasNoParticles()
+{
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        if( vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Clean the MPI buffers for communications
 // ---------------------------------------------------------------------------------------------------------------------
@@ -922,13 +935,11 @@ void Patch::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool devPtr )
             if (devPtr) {
                 double* sendField = smilei::tools::gpu::HostDeviceMemoryManagement::GetDevicePointer( field->sendFields_[iDim*2+iNeighbor]->data_ );
                 // Assumes a GPU compatible MPI implementation
-                MPI_Isend( sendField, field->sendFields_[iDim*2+iNeighbor]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][iNeighbor], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+                field->MPIbuff.startSend( iDim, iNeighbor, sendField, field->sendFields_[iDim*2+iNeighbor]->size(),
+                                          MPI_neighbor_[iDim][iNeighbor], tag );
             } else {
-                MPI_Isend( field->sendFields_[iDim*2+iNeighbor]->data_, field->sendFields_[iDim*2+iNeighbor]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][iNeighbor], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+                field->MPIbuff.startSend( iDim, iNeighbor, field->sendFields_[iDim*2+iNeighbor]->data_, field->sendFields_[iDim*2+iNeighbor]->size(),
+                                          MPI_neighbor_[iDim][iNeighbor], tag );
             }
         } // END of Send
 
@@ -937,13 +948,11 @@ void Patch::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool devPtr )
             if (devPtr) {
                 double* recvField = smilei::tools::gpu::HostDeviceMemoryManagement::GetDevicePointer( field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_ );
                 // Assumes a GPU compatible MPI implementation
-                MPI_Irecv( recvField, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                field->MPIbuff.startRecv( iDim, ( iNeighbor+1 )%2, recvField, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
+                                          MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag );
             } else {
-                MPI_Irecv( field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                field->MPIbuff.startRecv( iDim, ( iNeighbor+1 )%2, field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
+                                          MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag );
             }
         } // END of Recv
     } // END for iNeighbor
@@ -973,16 +982,14 @@ void Patch::initExchangeComplex( Field *field, int iDim, SmileiMPI *smpi )
 
         if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
             int tag = field->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( static_cast<cField *>(field->sendFields_[iDim*2+iNeighbor])->cdata_, 2*field->sendFields_[iDim*2+iNeighbor]->number_of_points_,
-                       MPI_DOUBLE, MPI_neighbor_[iDim][iNeighbor], tag,
-                       MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+            field->MPIbuff.startSend( iDim, iNeighbor, ( double * )static_cast<cField *>(field->sendFields_[iDim*2+iNeighbor])->cdata_, 2*field->sendFields_[iDim*2+iNeighbor]->number_of_points_,
+                                      MPI_neighbor_[iDim][iNeighbor], tag );
         } // END of Send
 
         if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
             int tag = field->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( static_cast<cField *>(field->recvFields_[iDim*2+(iNeighbor+1)%2])->cdata_, 2*field->recvFields_[iDim*2+(iNeighbor+1)%2]->number_of_points_,
-                       MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
-                       MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+            field->MPIbuff.startRecv( iDim, ( iNeighbor+1 )%2, ( double * )static_cast<cField *>(field->recvFields_[iDim*2+(iNeighbor+1)%2])->cdata_, 2*field->recvFields_[iDim*2+(iNeighbor+1)%2]->number_of_points_,
+                                      MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag );
         } // END of Recv
 
     } // END for iNeighbor
@@ -1047,13 +1054,11 @@ void Patch::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool devPtr )
                 // At initialization, we may not have everything on GPU SMILEI_GPU_ASSERT_MEMORY_IS_ON_DEVICE( field->sendFields_[iDim * 2 + iNeighbor]->data_ );
                 double* sendField = smilei::tools::gpu::HostDeviceMemoryManagement::GetDeviceOrHostPointer(field->sendFields_[iDim*2+iNeighbor]->data_);
                 // Assumes a GPU compatible MPI implementation
-                MPI_Isend( sendField, field->sendFields_[iDim*2+iNeighbor]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][iNeighbor], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+                field->MPIbuff.startSend( iDim, iNeighbor, sendField, field->sendFields_[iDim*2+iNeighbor]->size(),
+                                          MPI_neighbor_[iDim][iNeighbor], tag );
             } else {
-                MPI_Isend( field->sendFields_[iDim*2+iNeighbor]->data_, field->sendFields_[iDim*2+iNeighbor]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][iNeighbor], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+                field->MPIbuff.startSend( iDim, iNeighbor, field->sendFields_[iDim*2+iNeighbor]->data_, field->sendFields_[iDim*2+iNeighbor]->size(),
+                                          MPI_neighbor_[iDim][iNeighbor], tag );
             }
         } // END of Send
 
@@ -1063,13 +1068,11 @@ void Patch::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool devPtr )
                 // At initialization, we may not have everything on GPU SMILEI_GPU_ASSERT_MEMORY_IS_ON_DEVICE( field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_ );
                 double* recvField = smilei::tools::gpu::HostDeviceMemoryManagement::GetDeviceOrHostPointer(field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_);
                 // Assumes a GPU compatible MPI implementation
-                MPI_Irecv( recvField, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                field->MPIbuff.startRecv( iDim, ( iNeighbor+1 )%2, recvField, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
+                                          MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag );
             } else {
-                MPI_Irecv( field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
-                           MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
-                           MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                field->MPIbuff.startRecv( iDim, ( iNeighbor+1 )%2, field->recvFields_[iDim*2+(iNeighbor+1)%2]->data_, field->recvFields_[iDim*2+(iNeighbor+1)%2]->size(),
+                                          MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag );
             }
         } // END of Recv
     } // END for iNeighbor
@@ -41,6 +41,7 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class NodeAwareExchange;
 public:
     //! Constructor for Patch
     Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch );
@@ -173,6 +174,8 @@ public:
     
     //! Clean the MPI buffers for communications
     void cleanMPIBuffers( int ispec, Params &params );
+    //! Whether no species has particles in the patch
+    bool hasNoParticles();
     //! manage Idx of particles per direction,
     void copyExchParticlesToBuffers( int ispec, Params &params );
     //! init comm  nbr of particles
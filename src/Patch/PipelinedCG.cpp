@@ -0,0 +1,416 @@
+#include "PipelinedCG.h"
+
+#include <complex>
+
+#include "cField.h"
+#include "ElectroMagn.h"
+#include "Patch.h"
+#include "SmileiMPI.h"
+#include "SyncVectorPatch.h"
+#include "VectorPatch.h"
+#include "Tools.h"
+
+using namespace std;
+
+// Bounds of the spectrum targeted by the Chebyshev polynomial :
+//     the eigenvalues of D^-1 A are in ]0,2] (Gershgorin, the operators are diagonally dominant),
+//     the lower part of the spectrum is left to the conjugate gradient, as for Chebyshev smoothers
+static const double lambda_max = 2.;
+static const double lambda_min = lambda_max/30.;
+
+// Number of iterations between two replacements of the recursive residuals by the true ones
+static const unsigned int replacement_period = 50;
+
+static inline double realPart( double a )
+{
+    return a;
+}
+
+static inline double realPart( complex<double> a )
+{
+    return a.real();
+}
+
+static inline double realProduct( double a, double b )
+{
+    return a*b;
+}
+
+static inline double realProduct( complex<double> a, complex<double> b )
+{
+    return a.real()*b.real() + a.imag()*b.imag();
+}
+
+template<> Field *&PipelinedCG<double, Field>::phi( ElectroMagn *EMfields )
+{
+    return EMfields->phi_;
+}
+template<> Field *&PipelinedCG<double, Field>::r( ElectroMagn *EMfields )
+{
+    return EMfields->r_;
+}
+template<> Field *&PipelinedCG<double, Field>::p( ElectroMagn *EMfields )
+{
+    return EMfields->p_;
+}
+template<> Field *&PipelinedCG<double, Field>::Ap( ElectroMagn *EMfields )
+{
+    return EMfields->Ap_;
+}
+template<> double *PipelinedCG<double, Field>::data( Field *field )
+{
+    return field->data_;
+}
+
+template<> cField *&PipelinedCG<complex<double>, cField>::phi( ElectroMagn *EMfields )
+{
+    return EMfields->phi_AM_;
+}
+template<> cField *&PipelinedCG<complex<double>, cField>::r( ElectroMagn *EMfields )
+{
+    return EMfields->r_AM_;
+}
+template<> cField *&PipelinedCG<complex<double>, cField>::p( ElectroMagn *EMfields )
+{
+    return EMfields->p_AM_;
+}
+template<> cField *&PipelinedCG<complex<double>, cField>::Ap( ElectroMagn *EMfields )
+{
+    return EMfields->Ap_AM_;
+}
+template<> complex<double> *PipelinedCG<complex<double>, cField>::data( cField *field )
+{
+    return field->cdata_;
+}
+
+
+template<typename T, typename F>
+PipelinedCG<T, F>::PipelinedCG( VectorPatch &vecPatches, SmileiMPI *smpi, unsigned int chebyshev_degree,
+                                std::function<void( unsigned int ipatch )> applyOperator ) :
+    vecPatches_( vecPatches ),
+    smpi_( smpi ),
+    chebyshev_degree_( chebyshev_degree ),
+    applyOperator_( applyOperator )
+{
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches_( ipatch )->EMfields;
+        x_.push_back( phi( EMfields ) );
+        r_.push_back( r( EMfields ) );
+        p_.push_back( p( EMfields ) );
+    }
+    u_ = newVector();
+    w_ = newVector();
+    m_ = newVector();
+    n_ = newVector();
+    z_ = newVector();
+    q_ = newVector();
+    s_ = newVector();
+    inv_diag_ = newVector();
+    d_ = newVector();
+    res_ = newVector();
+    b_ = newVector();
+
+    computeDiagonal();
+}
+
+
+template<typename T, typename F>
+PipelinedCG<T, F>::~PipelinedCG()
+{
+    deleteVector( u_ );
+    deleteVector( w_ );
+    deleteVector( m_ );
+    deleteVector( n_ );
+    deleteVector( z_ );
+    deleteVector( q_ );
+    deleteVector( s_ );
+    deleteVector( inv_diag_ );
+    deleteVector( d_ );
+    deleteVector( res_ );
+    deleteVector( b_ );
+}
+
+
+template<typename T, typename F>
+vector<F *> PipelinedCG<T, F>::newVector()
+{
+    vector<F *> fields( r_.size() );
+    for( unsigned int ipatch=0 ; ipatch<r_.size() ; ipatch++ ) {
+        fields[ipatch] = static_cast<F *>( r_[ipatch]->clone() );
+        T *f = data( fields[ipatch] );
+        for( unsigned int i=0 ; i<fields[ipatch]->number_of_points_ ; i++ ) {
+            f[i] = 0.;
+        }
+    }
+    return fields;
+}
+
+
+template<typename T, typename F>
+void PipelinedCG<T, F>::deleteVector( vector<F *> &fields )
+{
+    for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+        delete fields[ipatch];
+    }
+    fields.clear();
+}
+
+
+template<typename T, typename F>
+void PipelinedCG<T, F>::exchange( vector<F *> &fields )
+{
+    vector<Field *> list( fields.begin(), fields.end() );
+    SyncVectorPatch::exchangeAlongAllDirectionsNoOMP<T, F>( list, vecPatches_, smpi_ );
+    SyncVectorPatch::finalizeExchangeAlongAllDirectionsNoOMP( list, vecPatches_ );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply the operator of the geometry to any vector, by pointing p_ and Ap_ of ElectroMagn to in and out
+// The nodes not computed by the operator (ghost cells at the boundaries, Dirichlet borders) are set to 0
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T, typename F>
+void PipelinedCG<T, F>::applyA( vector<F *> &in, vector<F *> &out )
+{
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches_( ipatch )->EMfields;
+        T *o = data( out[ipatch] );
+        for( unsigned int i=0 ; i<out[ipatch]->number_of_points_ ; i++ ) {
+            o[i] = 0.;
+        }
+        F *p_save  = p( EMfields );
+        F *Ap_save = Ap( EMfields );
+        p( EMfields )  = in[ipatch];
+        Ap( EMfields ) = out[ipatch];
+        applyOperator_( ipatch );
+        p( EMfields )  = p_save;
+        Ap( EMfields ) = Ap_save;
+    }
+    exchange( out );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Probe the diagonal of the operator with indicator vectors : the stencils are star-shaped, so that the nodes of
+// color (i+2j+3k)%(2*ndim+1) do not see each other. Nodes where the operator is not computed are masked.
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T, typename F>
+void PipelinedCG<T, F>::computeDiagonal()
+{
+    unsigned int ndim = r_[0]->dims_.size();
+    unsigned int ncolors = 2*ndim+1;
+    for( unsigned int icolor=0 ; icolor<ncolors ; icolor++ ) {
+        for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+            vector<unsigned int> n( 3, 1 );
+            for( unsigned int idim=0 ; idim<ndim ; idim++ ) {
+                n[idim] = r_[ipatch]->dims_[idim];
+            }
+            T *e = data( d_[ipatch] );
+            for( unsigned int i=0 ; i<n[0] ; i++ ) {
+                for( unsigned int j=0 ; j<n[1] ; j++ ) {
+                    for( unsigned int k=0 ; k<n[2] ; k++ ) {
+                        e[( i*n[1]+j )*n[2]+k] = ( ( i+2*j+3*k )%ncolors == icolor ) ? 1. : 0.;
+                    }
+                }
+            }
+
+            ElectroMagn *EMfields = vecPatches_( ipatch )->EMfields;
+            T *o = data( res_[ipatch] );
+            for( unsigned int i=0 ; i<res_[ipatch]->number_of_points_ ; i++ ) {
+                o[i] = 0.;
+            }
+            F *p_save  = p( EMfields );
+            F *Ap_save = Ap( EMfields );
+            p( EMfields )  = d_[ipatch];
+            Ap( EMfields ) = res_[ipatch];
+            applyOperator_( ipatch );
+            p( EMfields )  = p_save;
+            Ap( EMfields ) = Ap_save;
+
+            T *inv_diag = data( inv_diag_[ipatch] );
+            for( unsigned int i=0 ; i<inv_diag_[ipatch]->number_of_points_ ; i++ ) {
+                if( e[i] != T( 0. ) ) {
+                    inv_diag[i] = ( o[i] != T( 0. ) ) ? T( 1. )/o[i] : T( 0. );
+                }
+            }
+        }
+    }
+    // Ghost cells of the patches take the value of their owner
+    exchange( inv_diag_ );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Chebyshev acceleration of the Jacobi iteration for A out = in (Saad, Iterative methods for sparse linear systems,
+// algorithm 12.1), started from out = 0. The result is a fixed polynomial of A applied to in, symmetric and of the
+// same sign as A^-1 : it can be used as a conjugate gradient preconditioner.
+// tmp is used as work vector.
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T, typename F>
+void PipelinedCG<T, F>::applyM( vector<F *> &in, vector<F *> &out, vector<F *> &tmp )
+{
+    double theta = 0.5*( lambda_max+lambda_min );
+    double delta = 0.5*( lambda_max-lambda_min );
+    double sigma = theta/delta;
+    double rho_old = 1./sigma;
+
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        T *v        = data( in[ipatch] );
+        T *inv_diag = data( inv_diag_[ipatch] );
+        T *res      = data( res_[ipatch] );
+        T *d        = data( d_[ipatch] );
+        T *o        = data( out[ipatch] );
+        for( unsigned int i=0 ; i<in[ipatch]->number_of_points_ ; i++ ) {
+            res[i] = realPart( inv_diag[i] )*v[i];
+            d[i]   = res[i]/theta;
+            o[i]   = d[i];
+        }
+    }
+
+    for( unsigned int k=1 ; k<chebyshev_degree_ ; k++ ) {
+        applyA( d_, tmp );
+        double rho = 1./( 2.*sigma-rho_old );
+        for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+            T *inv_diag = data( inv_diag_[ipatch] );
+            T *Ad       = data( tmp[ipatch] );
+            T *res      = data( res_[ipatch] );
+            T *d        = data( d_[ipatch] );
+            T *o        = data( out[ipatch] );
+            for( unsigned int i=0 ; i<out[ipatch]->number_of_points_ ; i++ ) {
+                res[i] -= realPart( inv_diag[i] )*Ad[i];
+                d[i]    = rho*rho_old*d[i] + ( 2.*rho/delta )*res[i];
+                o[i]   += d[i];
+            }
+        }
+        rho_old = rho;
+    }
+}
+
+
+template<typename T, typename F>
+double PipelinedCG<T, F>::localDot( vector<F *> &a, vector<F *> &b )
+{
+    double sum = 0.;
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches_( ipatch )->EMfields;
+        vector<unsigned int> n( 3, 1 ), imin( 3, 0 ), imax( 3, 0 );
+        for( unsigned int idim=0 ; idim<a[ipatch]->dims_.size() ; idim++ ) {
+            n[idim]    = a[ipatch]->dims_[idim];
+            imin[idim] = EMfields->index_min_p_[idim];
+            imax[idim] = EMfields->index_max_p_[idim];
+        }
+        T *pa = data( a[ipatch] );
+        T *pb = data( b[ipatch] );
+        for( unsigned int i=imin[0] ; i<=imax[0] ; i++ ) {
+            for( unsigned int j=imin[1] ; j<=imax[1] ; j++ ) {
+                for( unsigned int k=imin[2] ; k<=imax[2] ; k++ ) {
+                    unsigned int idx = ( i*n[1]+j )*n[2]+k;
+                    sum += realProduct( pa[idx], pb[idx] );
+                }
+            }
+        }
+    }
+    return sum;
+}
+
+
+template<typename T, typename F>
+void PipelinedCG<T, F>::xpby( vector<F *> &x, double beta, vector<F *> &y )
+{
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        T *px = data( x[ipatch] );
+        T *py = data( y[ipatch] );
+        for( unsigned int i=0 ; i<y[ipatch]->number_of_points_ ; i++ ) {
+            py[i] = px[i] + beta*py[i];
+        }
+    }
+}
+
+
+template<typename T, typename F>
+void PipelinedCG<T, F>::axpy( double alpha, vector<F *> &x, vector<F *> &y )
+{
+    for( unsigned int ipatch=0 ; ipatch<vecPatches_.size() ; ipatch++ ) {
+        T *px = data( x[ipatch] );
+        T *py = data( y[ipatch] );
+        for( unsigned int i=0 ; i<y[ipatch]->number_of_points_ ; i++ ) {
+            py[i] += alpha*px[i];
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pipelined preconditioned conjugate gradient : one reduction per iteration, overlapped with m = M w and n = A m
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T, typename F>
+unsigned int PipelinedCG<T, F>::solve( unsigned int iteration_max, double error_max, std::function<double( double )> control, double &ctrl )
+{
+    // b = r, u = M r, w = A u
+    axpy( 1., r_, b_ );
+    applyM( r_, u_, n_ );
+    applyA( u_, w_ );
+
+    unsigned int iteration = 0;
+    double alpha = 0., gamma_old = 0.;
+    double local[3], global[3];
+    MPI_Request request;
+    while( true ) {
+        // gamma = (r,u), delta = (w,u), and (r,r) for the control parameter
+        local[0] = localDot( r_, u_ );
+        local[1] = localDot( w_, u_ );
+        local[2] = localDot( r_, r_ );
+        MPI_Iallreduce( local, global, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &request );
+
+        // m = M w, n = A m while the scalar products are summed
+        applyM( w_, m_, n_ );
+        applyA( m_, n_ );
+
+        MPI_Wait( &request, MPI_STATUS_IGNORE );
+        ctrl = control( global[2] );
+        if( ctrl <= error_max || iteration >= iteration_max ) {
+            break;
+        }
+        iteration++;
+        if( smpi_->isMaster() ) {
+            DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl );
+        }
+
+        double gamma = global[0];
+        double delta = global[1];
+        double beta  = 0.;
+        if( iteration > 1 ) {
+            beta  = gamma/gamma_old;
+            alpha = gamma/( delta - beta*gamma/alpha );
+        } else {
+            alpha = gamma/delta;
+        }
+        gamma_old = gamma;
+
+        xpby( n_, beta, z_ );
+        xpby( m_, beta, q_ );
+        xpby( w_, beta, s_ );
+        xpby( u_, beta, p_ );
+        axpy(  alpha, p_, x_ );
+        if( iteration%replacement_period == 0 ) {
+            // r = b - A x, u = M r, w = A u, s = A p, q = M s, z = A q (m and n are free until the next iteration)
+            applyA( x_, r_ );
+            xpby( b_, -1., r_ );
+            applyM( r_, u_, n_ );
+            applyA( u_, w_ );
+            applyA( p_, s_ );
+            applyM( s_, q_, n_ );
+            applyA( q_, z_ );
+        } else {
+            axpy( -alpha, s_, r_ );
+            axpy( -alpha, q_, u_ );
+            axpy( -alpha, z_, w_ );
+        }
+    }
+
+    return iteration;
+}
+
+
+template class PipelinedCG<double, Field>;
+template class PipelinedCG<complex<double>, cField>;
@@ -0,0 +1,78 @@
+#ifndef PIPELINEDCG_H
+#define PIPELINEDCG_H
+
+#include <functional>
+#include <vector>
+
+class Field;
+class ElectroMagn;
+class VectorPatch;
+class SmileiMPI;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PipelinedCG
+//! Pipelined preconditioned conjugate gradient (Ghysels & Vanroose, Parallel Computing 40, 2014) for the Poisson
+//! problems solved at initialization, on the fields phi_, r_ and p_ of ElectroMagn (phi_AM_, r_AM_, p_AM_ in AM)
+//!     - the three scalar products of an iteration are summed in a single non-blocking MPI_Iallreduce, which is
+//!       overlapped with the preconditioner and the operator applications (and their halo exchanges)
+//!     - the preconditioner is a Chebyshev polynomial of the Jacobi scaled operator D^-1 A, its degree is
+//!       poisson_chebyshev_degree (1 = Jacobi only). The diagonal D is probed with the operator itself.
+//!     - the recurrences of the pipelined algorithm drift from the true residual b - A phi : they are replaced
+//!       periodically (Cools et al., SIAM J. Sci. Comput. 40, 2018)
+//! T is double (F=Field) or std::complex<double> (F=cField). The operator is real and symmetric in both cases.
+//  --------------------------------------------------------------------------------------------------------------------
+template<typename T, typename F>
+class PipelinedCG
+{
+public:
+    //! \param applyOperator computes Ap_ (Ap_AM_) from p_ (p_AM_) in the patch ipatch, without exchange
+    PipelinedCG( VectorPatch &vecPatches, SmileiMPI *smpi, unsigned int chebyshev_degree,
+                 std::function<void( unsigned int ipatch )> applyOperator );
+    ~PipelinedCG();
+
+    //! Solve starting from phi=0 and r=b (as set by initPoisson), phi holds the solution on return
+    //! \param control computes the control parameter from the global squared norm of the residual
+    //! \param ctrl last value of the control parameter
+    //! \return the number of iterations done
+    unsigned int solve( unsigned int iteration_max, double error_max, std::function<double( double )> control, double &ctrl );
+
+private:
+    //! Access to the fields used by the geometry kernels
+    F *&phi( ElectroMagn *EMfields );
+    F *&r( ElectroMagn *EMfields );
+    F *&p( ElectroMagn *EMfields );
+    F *&Ap( ElectroMagn *EMfields );
+    T *data( F *field );
+
+    //! out = A in, exchanged
+    void applyA( std::vector<F *> &in, std::vector<F *> &out );
+    //! out = M in, with the Chebyshev polynomial preconditioner (tmp is a work vector)
+    void applyM( std::vector<F *> &in, std::vector<F *> &out, std::vector<F *> &tmp );
+    //! Probe the diagonal of A, exchanged
+    void computeDiagonal();
+
+    //! Sum on the real nodes (index_min_p_ to index_max_p_) of the real part of conj(a).b
+    double localDot( std::vector<F *> &a, std::vector<F *> &b );
+    //! y = x + beta*y
+    void xpby( std::vector<F *> &x, double beta, std::vector<F *> &y );
+    //! y += alpha*x
+    void axpy( double alpha, std::vector<F *> &x, std::vector<F *> &y );
+
+    void exchange( std::vector<F *> &fields );
+    std::vector<F *> newVector();
+    void deleteVector( std::vector<F *> &fields );
+
+    VectorPatch &vecPatches_;
+    SmileiMPI *smpi_;
+    unsigned int chebyshev_degree_;
+    std::function<void( unsigned int ipatch )> applyOperator_;
+
+    //! Vectors of the pipelined algorithm, one field per patch (x, r and p are phi_, r_ and p_)
+    std::vector<F *> x_, r_, u_, w_, m_, n_, z_, q_, s_, p_;
+    //! Right hand side, for the residual replacement
+    std::vector<F *> b_;
+    //! Inverse of the diagonal of A, and work vectors of the Chebyshev polynomial
+    std::vector<F *> inv_diag_, d_, res_;
+};
+
+#endif
@@ -0,0 +1,380 @@
+#include "PoissonFFT.h"
+
+#include <cmath>
+
+#ifdef _FFTW
+#include <fftw3-mpi.h>
+#endif
+
+#include "DomainDecomposition.h"
+#include "ElectroMagn.h"
+#include "Field.h"
+#include "Params.h"
+#include "Patch.h"
+#include "SmileiMPI.h"
+#include "VectorPatch.h"
+#include "Tools.h"
+
+using namespace std;
+
+// Number of points per direction used to average the Green function on the cell where it is singular
+static const unsigned int green_subsampling = 8;
+
+bool PoissonFFT::isAvailable( Params &params, string &reason )
+{
+#ifndef _FFTW
+    reason = "Smilei was not compiled with FFTW (make config=fftw)";
+    return false;
+#endif
+    if( params.geometry == "AMcylindrical" ) {
+        reason = "it is not available in AMcylindrical geometry";
+        return false;
+    }
+    unsigned int nperiodic = 0;
+    for( unsigned int iDim=0; iDim<params.nDim_field; iDim++ ) {
+        if( params.EM_BCs[iDim][0] == "periodic" ) {
+            nperiodic++;
+        }
+    }
+    if( nperiodic != 0 && nperiodic != params.nDim_field ) {
+        reason = "EM_boundary_conditions must be periodic along all directions, or along none of them";
+        return false;
+    }
+    return true;
+}
+
+PoissonFFT::PoissonFFT( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi ) :
+    params_( params ),
+    vecPatches_( vecPatches ),
+    smpi_( smpi ),
+    local_n0_( 0 ),
+    local_0_start_( 0 ),
+    alloc_local_( 0 ),
+    data_( NULL ),
+    green_( NULL )
+{
+    ndim_ = params.nDim_field;
+    periodic_ = ( params.EM_BCs[0][0] == "periodic" );
+
+    // Periodic : one period of the real nodes
+    // Open     : the real nodes and the ghost cells of the boundary patches, doubled for the Hockney method
+    n_.resize( 3, 1 );
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        if( periodic_ ) {
+            n_[iDim] = params.global_size_[iDim];
+        } else {
+            n_[iDim] = 2*( params.global_size_[iDim] + 1 + 2*params.oversize[iDim] );
+        }
+    }
+
+#ifdef _FFTW
+    static bool fftw_mpi_initialized = false;
+    if( !fftw_mpi_initialized ) {
+        fftw_mpi_init();
+        fftw_mpi_initialized = true;
+    }
+    alloc_local_ = fftw_mpi_local_size( 3, &n_[0], MPI_COMM_WORLD, &local_n0_, &local_0_start_ );
+    data_ = reinterpret_cast<complex<double> *>( fftw_alloc_complex( max( alloc_local_, ( ptrdiff_t )1 ) ) );
+    if( !periodic_ ) {
+        green_ = reinterpret_cast<complex<double> *>( fftw_alloc_complex( max( alloc_local_, ( ptrdiff_t )1 ) ) );
+    }
+#else
+    ERROR( "The FFT Poisson solver requires Smilei to be compiled with FFTW (make config=fftw)" );
+#endif
+
+    // Slabs of all MPI ranks, and owner of each index along x
+    int nranks = smpi_->getSize();
+    long long local[2] = { ( long long )local_n0_, ( long long )local_0_start_ };
+    vector<long long> all( 2*nranks );
+    MPI_Allgather( local, 2, MPI_LONG_LONG, &all[0], 2, MPI_LONG_LONG, MPI_COMM_WORLD );
+    all_n0_.resize( nranks );
+    all_0_start_.resize( nranks );
+    slab_owner_.assign( n_[0], -1 );
+    for( int irank=0; irank<nranks; irank++ ) {
+        all_n0_[irank]      = all[2*irank];
+        all_0_start_[irank] = all[2*irank+1];
+        for( ptrdiff_t i0=all_0_start_[irank]; i0<all_0_start_[irank]+all_n0_[irank]; i0++ ) {
+            slab_owner_[i0] = irank;
+        }
+    }
+}
+
+PoissonFFT::~PoissonFFT()
+{
+#ifdef _FFTW
+    if( data_ ) {
+        fftw_free( data_ );
+    }
+    if( green_ ) {
+        fftw_free( green_ );
+    }
+#endif
+}
+
+void PoissonFFT::patchNodes( vector<unsigned int> Pcoordinates, bool owned_only, vector<vector<pair<unsigned int, ptrdiff_t> > > &nodes )
+{
+    nodes.resize( 3 );
+    for( unsigned int iDim=0; iDim<3; iDim++ ) {
+        nodes[iDim].clear();
+        if( iDim >= ndim_ ) {
+            nodes[iDim].push_back( make_pair( 0, 0 ) );
+            continue;
+        }
+        unsigned int patch_size = params_.patch_size_[iDim];
+        unsigned int oversize   = params_.oversize[iDim];
+        unsigned int dim_prim   = patch_size + 1 + 2*oversize;
+        unsigned int P = Pcoordinates[iDim];
+
+        // Each node of the FFT grid is owned by a single patch, the last real node of a patch is owned by the next one
+        unsigned int imin = 0, imax = dim_prim;
+        if( owned_only ) {
+            imin = oversize;
+            imax = oversize + patch_size;
+            if( !periodic_ && P == 0 ) {
+                imin = 0;
+            }
+            if( !periodic_ && P == params_.number_of_patches[iDim]-1 ) {
+                imax = dim_prim;
+            }
+        }
+        for( unsigned int i=imin; i<imax; i++ ) {
+            ptrdiff_t index;
+            if( periodic_ ) {
+                ptrdiff_t N = n_[iDim];
+                index = ( ( ( ptrdiff_t )( P*patch_size + i ) - ( ptrdiff_t )oversize ) % N + N ) % N;
+            } else {
+                index = P*patch_size + i;
+            }
+            nodes[iDim].push_back( make_pair( i, index ) );
+        }
+    }
+}
+
+void PoissonFFT::gather()
+{
+    int nranks = smpi_->getSize();
+    int rank = smpi_->getRank();
+    vector<vector<pair<unsigned int, ptrdiff_t> > > nodes;
+
+    // Pack the owned nodes of the local patches, by destination slab
+    vector<vector<double> > send( nranks );
+    for( unsigned int ipatch=0; ipatch<vecPatches_.size(); ipatch++ ) {
+        Field *r = vecPatches_( ipatch )->EMfields->r_;
+        unsigned int dim1 = r->dims_.size()>1 ? r->dims_[1] : 1;
+        unsigned int dim2 = r->dims_.size()>2 ? r->dims_[2] : 1;
+        patchNodes( vecPatches_( ipatch )->Pcoordinates, true, nodes );
+        for( auto &n0 : nodes[0] ) {
+            vector<double> &buffer = send[slab_owner_[n0.second]];
+            for( auto &n1 : nodes[1] ) {
+                for( auto &n2 : nodes[2] ) {
+                    buffer.push_back( r->data_[( n0.first*dim1 + n1.first )*dim2 + n2.first] );
+                }
+            }
+        }
+    }
+
+    vector<double> recv;
+    vector<int> rdispls;
+    alltoall( send, recv, rdispls );
+
+    // Unpack in the slab, in the order of the patches of each MPI rank
+    for( ptrdiff_t i=0; i<alloc_local_; i++ ) {
+        data_[i] = 0.;
+    }
+    for( unsigned int hindex=0; hindex<params_.tot_number_of_patches; hindex++ ) {
+        int &position = rdispls[smpi_->hrank( hindex )];
+        patchNodes( vecPatches_.domain_decomposition_->getDomainCoordinates( hindex ), true, nodes );
+        for( auto &n0 : nodes[0] ) {
+            if( slab_owner_[n0.second] != rank ) {
+                continue;
+            }
+            for( auto &n1 : nodes[1] ) {
+                for( auto &n2 : nodes[2] ) {
+                    data_[( ( n0.second-local_0_start_ )*n_[1] + n1.second )*n_[2] + n2.second] = recv[position++];
+                }
+            }
+        }
+    }
+}
+
+void PoissonFFT::scatter()
+{
+    int nranks = smpi_->getSize();
+    int rank = smpi_->getRank();
+    vector<vector<pair<unsigned int, ptrdiff_t> > > nodes;
+
+    // Pack all the nodes (ghost cells included) of all patches found in the local slab, by destination MPI rank
+    vector<vector<double> > send( nranks );
+    for( unsigned int hindex=0; hindex<params_.tot_number_of_patches; hindex++ ) {
+        vector<double> &buffer = send[smpi_->hrank( hindex )];
+        patchNodes( vecPatches_.domain_decomposition_->getDomainCoordinates( hindex ), false, nodes );
+        for( auto &n0 : nodes[0] ) {
+            if( slab_owner_[n0.second] != rank ) {
+                continue;
+            }
+            for( auto &n1 : nodes[1] ) {
+                for( auto &n2 : nodes[2] ) {
+                    buffer.push_back( data_[( ( n0.second-local_0_start_ )*n_[1] + n1.second )*n_[2] + n2.second].real() );
+                }
+            }
+        }
+    }
+
+    vector<double> recv;
+    vector<int> rdispls;
+    alltoall( send, recv, rdispls );
+
+    // Unpack in the local patches
+    for( unsigned int ipatch=0; ipatch<vecPatches_.size(); ipatch++ ) {
+        Field *phi = vecPatches_( ipatch )->EMfields->phi_;
+        unsigned int dim1 = phi->dims_.size()>1 ? phi->dims_[1] : 1;
+        unsigned int dim2 = phi->dims_.size()>2 ? phi->dims_[2] : 1;
+        patchNodes( vecPatches_( ipatch )->Pcoordinates, false, nodes );
+        for( auto &n0 : nodes[0] ) {
+            int &position = rdispls[slab_owner_[n0.second]];
+            for( auto &n1 : nodes[1] ) {
+                for( auto &n2 : nodes[2] ) {
+                    phi->data_[( n0.first*dim1 + n1.first )*dim2 + n2.first] = recv[position++];
+                }
+            }
+        }
+    }
+}
+
+void PoissonFFT::alltoall( vector<vector<double> > &send, vector<double> &recv, vector<int> &rdispls )
+{
+    int nranks = smpi_->getSize();
+    vector<int> scounts( nranks ), sdispls( nranks, 0 ), rcounts( nranks );
+    rdispls.assign( nranks, 0 );
+    for( int irank=0; irank<nranks; irank++ ) {
+        scounts[irank] = send[irank].size();
+    }
+    MPI_Alltoall( &scounts[0], 1, MPI_INT, &rcounts[0], 1, MPI_INT, MPI_COMM_WORLD );
+
+    vector<double> buffer;
+    for( int irank=0; irank<nranks; irank++ ) {
+        if( irank>0 ) {
+            sdispls[irank] = sdispls[irank-1] + scounts[irank-1];
+            rdispls[irank] = rdispls[irank-1] + rcounts[irank-1];
+        }
+        buffer.insert( buffer.end(), send[irank].begin(), send[irank].end() );
+        vector<double>().swap( send[irank] );
+    }
+    recv.resize( rdispls[nranks-1] + rcounts[nranks-1] );
+    MPI_Alltoallv( buffer.data(), &scounts[0], &sdispls[0], MPI_DOUBLE,
+                   recv.data(), &rcounts[0], &rdispls[0], MPI_DOUBLE, MPI_COMM_WORLD );
+}
+
+double PoissonFFT::green( vector<ptrdiff_t> &shift, double gamma )
+{
+    // Free space Green function of -Laplacian, at the distance R
+    auto G = [this]( double R ) {
+        if( ndim_ == 3 ) {
+            return 1./( 4.*M_PI*R );
+        } else if( ndim_ == 2 ) {
+            return -log( R )/( 2.*M_PI );
+        } else {
+            return -0.5*R;
+        }
+    };
+
+    // The x direction is stretched by gamma, and the Green function multiplied by gamma
+    vector<double> length( ndim_ );
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        length[iDim] = params_.cell_length[iDim] * ( iDim==0 ? gamma : 1. );
+    }
+
+    bool origin = true;
+    double R2 = 0.;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        origin = origin && ( shift[iDim] == 0 );
+        R2 += pow( shift[iDim]*length[iDim], 2 );
+    }
+    if( !origin ) {
+        return gamma * G( sqrt( R2 ) );
+    }
+
+    // Average on the cell at the origin, where the Green function is singular
+    unsigned int npoints = 1;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        npoints *= green_subsampling;
+    }
+    double sum = 0.;
+    for( unsigned int ipoint=0; ipoint<npoints; ipoint++ ) {
+        unsigned int index = ipoint;
+        R2 = 0.;
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+            double x = ( ( index%green_subsampling ) + 0.5 )/green_subsampling - 0.5;
+            index /= green_subsampling;
+            R2 += pow( x*length[iDim], 2 );
+        }
+        sum += G( sqrt( R2 ) );
+    }
+    return gamma * sum/npoints;
+}
+
+void PoissonFFT::transform( complex<double> *data, bool forward )
+{
+#ifdef _FFTW
+    fftw_plan plan = fftw_mpi_plan_dft( 3, &n_[0], reinterpret_cast<fftw_complex *>( data ), reinterpret_cast<fftw_complex *>( data ),
+                                        MPI_COMM_WORLD, forward ? FFTW_FORWARD : FFTW_BACKWARD, FFTW_ESTIMATE );
+    fftw_execute( plan );
+    fftw_destroy_plan( plan );
+#else
+    SMILEI_UNUSED( data );
+    SMILEI_UNUSED( forward );
+#endif
+}
+
+void PoissonFFT::solve( double gamma )
+{
+    gather();
+    transform( data_, true );
+
+    double ntotal = ( double )n_[0] * ( double )n_[1] * ( double )n_[2];
+    ptrdiff_t k[3];
+
+    if( periodic_ ) {
+        // Eigenvalues of the operator of compute_Ap : - sum 4/dx^2 sin^2(pi k/N), the x term divided by gamma^2
+        for( ptrdiff_t l0=0; l0<local_n0_; l0++ ) {
+            k[0] = local_0_start_ + l0;
+            for( k[1]=0; k[1]<n_[1]; k[1]++ ) {
+                for( k[2]=0; k[2]<n_[2]; k[2]++ ) {
+                    double lambda = 0.;
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+                        double s = sin( M_PI*k[iDim]/n_[iDim] )/params_.cell_length[iDim];
+                        lambda -= 4.*s*s / ( iDim==0 ? gamma*gamma : 1. );
+                    }
+                    complex<double> &d = data_[( l0*n_[1] + k[1] )*n_[2] + k[2]];
+                    // The mode k=0 is the uniform neutralizing background
+                    d = ( lambda == 0. ) ? 0. : d/( lambda*ntotal );
+                }
+            }
+        }
+    } else {
+        // phi = G * rho = - G * r, convolved on the doubled grid
+        double cell_volume = 1.;
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+            cell_volume *= params_.cell_length[iDim];
+        }
+        vector<ptrdiff_t> shift( 3 );
+        for( ptrdiff_t l0=0; l0<local_n0_; l0++ ) {
+            k[0] = local_0_start_ + l0;
+            for( k[1]=0; k[1]<n_[1]; k[1]++ ) {
+                for( k[2]=0; k[2]<n_[2]; k[2]++ ) {
+                    for( unsigned int iDim=0; iDim<3; iDim++ ) {
+                        shift[iDim] = ( k[iDim] <= n_[iDim]/2 ) ? k[iDim] : k[iDim] - n_[iDim];
+                    }
+                    green_[( l0*n_[1] + k[1] )*n_[2] + k[2]] = green( shift, gamma );
+                }
+            }
+        }
+        transform( green_, true );
+        for( ptrdiff_t i=0; i<local_n0_*n_[1]*n_[2]; i++ ) {
+            data_[i] *= -green_[i] * cell_volume/ntotal;
+        }
+    }
+
+    transform( data_, false );
+    scatter();
+}
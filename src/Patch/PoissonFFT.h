@@ -0,0 +1,72 @@
+#ifndef POISSONFFT_H
+#define POISSONFFT_H
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Params;
+class VectorPatch;
+class SmileiMPI;
+class Field;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PoissonFFT
+//! Direct solver of the Poisson problems solved at initialization in cartesian geometries, with distributed FFTs (FFTW)
+//!     - the right hand side r_ set by initPoisson is redistributed from the patches to slabs along x, transformed,
+//!       and the potential is redistributed back to phi_ on all the nodes of the patches (ghost cells included)
+//!     - periodic boundaries along all directions: the discrete operator of compute_Ap is diagonal in Fourier space
+//!     - no periodic boundary: open boundaries with the method of Hockney, the charge is convolved with the free
+//!       space Green function on a grid doubled along each direction
+//! The relativistic Poisson problem is solved with the x derivative scaled by 1/gamma^2.
+//  --------------------------------------------------------------------------------------------------------------------
+class PoissonFFT
+{
+public:
+    //! Check if the geometry, the boundary conditions and the build allow the FFT solver
+    //! \param reason why it is not allowed
+    static bool isAvailable( Params &params, std::string &reason );
+
+    PoissonFFT( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
+    ~PoissonFFT();
+
+    //! Solve from r_ (-rho, as set by initPoisson), phi_ holds the solution on return
+    //! \param gamma mean Lorentz factor of the relativistic Poisson problem (1 for the Poisson problem)
+    void solve( double gamma );
+
+private:
+    //! Local indices of the nodes of the patch at coordinates Pcoordinates along each direction, with their
+    //! index on the FFT grid. owned_only selects the nodes which the patch contributes to the right hand side.
+    void patchNodes( std::vector<unsigned int> Pcoordinates, bool owned_only, std::vector<std::vector<std::pair<unsigned int, ptrdiff_t> > > &nodes );
+    //! r_ of the patches to data_
+    void gather();
+    //! data_ to phi_ of the patches
+    void scatter();
+    //! Exchange the buffers packed for each MPI rank, rdispls is the position of the data of each MPI rank in recv
+    void alltoall( std::vector<std::vector<double> > &send, std::vector<double> &recv, std::vector<int> &rdispls );
+    //! Free space Green function of the relativistic Poisson problem, averaged on the cell at the origin
+    double green( std::vector<ptrdiff_t> &shift, double gamma );
+    void transform( std::complex<double> *data, bool forward );
+
+    Params &params_;
+    VectorPatch &vecPatches_;
+    SmileiMPI *smpi_;
+
+    unsigned int ndim_;
+    //! Periodic boundaries along all directions, else open boundaries along all directions
+    bool periodic_;
+    //! Size of the FFT grid (3 directions, 1 for the unused ones)
+    std::vector<ptrdiff_t> n_;
+    //! Slab of the FFT grid along x local to this MPI rank, and for all MPI ranks
+    ptrdiff_t local_n0_, local_0_start_, alloc_local_;
+    std::vector<ptrdiff_t> all_n0_, all_0_start_;
+    //! MPI rank owning the slab which contains each index along x
+    std::vector<int> slab_owner_;
+
+    std::complex<double> *data_;
+    //! Fourier transform of the Green function (open boundaries)
+    std::complex<double> *green_;
+};
+
+#endif
@@ -379,6 +379,8 @@ public :
     static void finalizeexchangeE( Params &params, VectorPatch &vecPatches );
     static void exchangeB( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeexchangeB( Params &params, VectorPatch &vecPatches );
+    //! Exchange all components of E and B, synchronized per direction (wide halos, Main.exchange_fields_each)
+    static void exchangeEB( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void exchangeBmBTIS3( Params &params, VectorPatch &vecPatches, int imode, SmileiMPI *smpi );
     static void finalizeexchangeBmBTIS3( Params &params, VectorPatch &vecPatches, int imode );
     static void exchangeBmBTIS3( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
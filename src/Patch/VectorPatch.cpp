@@ -15,12 +15,15 @@
 #include "ElectroMagnBC2D_PML.h"
 #include "ElectroMagnBC3D_PML.h"
 #include "ElectroMagnBCAM_PML.h"
+#include "FieldBufferPool.h"
 
 #include "Laser.h"
 #include "LaserEnvelope.h"
 #include "Particles.h"
 #include "PatchesFactory.h"
 #include "PeekAtSpecies.h"
+#include "PipelinedCG.h"
+#include "PoissonFFT.h"
 #include "SimWindow.h"
 #include "SolverFactory.h"
 #include "Species.h"
@@ -39,12 +42,19 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    async_writer_ = NULL;
+    node_aware_exchange_ = false;
+    lazy_species_densities_ = false;
 }
 
 
 VectorPatch::VectorPatch( Params &params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    async_writer_ = NULL;
+    node_aware_exchange_ = params.node_aware_exchange;
+    // Species densities are kept on device with GPUs, and projected at each iteration with spectral solvers
+    lazy_species_densities_ = !params.gpu_computing && !params.is_spectral;
 }
 
 
@@ -97,6 +107,15 @@ void VectorPatch::close( SmileiMPI *smpiData )
     }
 
     patches_.clear();
+
+    // Buffers kept by the moving window
+    FieldBufferPool<double>::clear();
+    FieldBufferPool<std::complex<double>>::clear();
+
+    for( unsigned int iDim=0 ; iDim<3 ; iDim++ ) {
+        B_exchange_[iDim].clear();
+        densities_exchange_[iDim].clear();
+    }
 }
 
 void VectorPatch::createDiags( Params &params, SmileiMPI *smpi, OpenPMDparams &openPMD, RadiationTables * radiation_tables_ )
@@ -121,6 +140,14 @@ void VectorPatch::createDiags( Params &params, SmileiMPI *smpi, OpenPMDparams &o
         names.push_back( localDiags[i]->name() );
     }
 
+    // The MPI master may write the global diags in the background
+    if( params.async_diagnostics_buffer > 0. && smpi->isMaster() ) {
+        async_writer_ = new AsyncWriter( ( size_t )( params.async_diagnostics_buffer * 1024. * 1024. ) );
+        for( unsigned int i=0; i<globalDiags.size(); i++ ) {
+            globalDiags[i]->async_writer_ = async_writer_;
+        }
+    }
+
     // Delete all unused fields
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
         if( params.geometry!="AMcylindrical" ) {
@@ -336,6 +363,7 @@ void VectorPatch::dynamics( Params &params,
     {
         diag_flag = ( needsRhoJsNow( itime ) || params.is_spectral );
     }
+    allocateSpeciesDensities();
 
     timers.particles.restart();
     ostringstream t;
@@ -411,6 +439,7 @@ void VectorPatch::projectionForDiags( Params &params,
 
     #pragma omp single
     diag_flag = needsRhoJsNow( itime );
+    allocateSpeciesDensities();
 
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
@@ -517,6 +546,30 @@ void VectorPatch::mergeParticles(Params &params, double time_dual,Timers &timers
 
 }
 
+
+//! Perform the particles splitting on all patches
+void VectorPatch::splitParticles(Params &params, double time_dual,Timers &timers, int itime )
+{
+    timers.particleSplitting.restart();
+
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
+            // Check if the particle splitting is activated for this species
+            if (species( ipatch, ispec )->has_splitting_) {
+
+                // Check the time selection
+                if( species( ipatch, ispec )->splitting_time_selection_->theTimeIsNow( itime ) ) {
+                    species( ipatch, ispec )->splitParticles( time_dual, localDiags );
+                }
+            }
+        }
+    }
+
+    timers.particleSplitting.update( params.printNow( itime ) );
+
+}
+
 //! Clean MPI buffers and resize particle arrays to save memory
 void VectorPatch::cleanParticlesOverhead(Params &params, Timers &timers, int itime )
 {
@@ -986,7 +1039,8 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
 
     // Current filter in intermediate space
     if (params.currentFilter_passes.size() > 0){
-        for( unsigned int ipassfilter=0 ; ipassfilter<*std::max_element(std::begin(params.currentFilter_passes), std::end(params.currentFilter_passes)) ; ipassfilter++ ) {
+        const unsigned int npassfilter = *std::max_element(std::begin(params.currentFilter_passes), std::end(params.currentFilter_passes));
+        for( unsigned int ipassfilter=0 ; ipassfilter<npassfilter ; ipassfilter++ ) {
             #pragma omp for schedule(static)
             for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
                 // Current spatial filtering
@@ -997,6 +1051,10 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
                     ( *this )( ipatch )->EMfields->customFIRCurrentFilter(ipassfilter, params.currentFilter_passes, params.currentFilter_kernelFIR);
                 }
             }
+            // The ghost cells are deep enough for several passes between exchanges (see Params::oversize)
+            if( ( ipassfilter+1 ) % params.currentFilter_passes_per_exchange != 0 && ipassfilter+1 < npassfilter ) {
+                continue;
+            }
             if (params.geometry != "AMcylindrical"){
                 if (params.currentFilter_model=="customFIR"){
                     SyncVectorPatch::exchangeSynchronizedPerDirection<double,Field>( listJx_, *this, smpi );
@@ -1023,20 +1081,63 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         }
     }
 
+    // With temporal blocking, the Maxwell steps of the patches without particles nor currents are deferred
+    // and advanced at once, as long as neither the exchanges, the load balancing nor the diagnostics need the fields.
+    // The ghost cells remain valid because the deferred steps are the same as those computed in between two exchanges.
+    bool defer = params.temporal_blocking
+                 && ! wideHaloExchangeIsNeeded( params, itime )
+                 && ( unsigned int )itime < params.n_time
+                 && ! ( params.has_load_balancing && params.load_balancing_time_selection->theTimeIsNow( itime ) )
+                 && ! diagsReadFieldsNow( itime );
+
     #pragma omp for schedule(static)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        if( params.skip_quiescent_patches ) {
+            // Without particles, and with E, B and J identically zero (ghost cells included),
+            // E and B remain zero: saving B in B_m and solving Maxwell are useless.
+            // A patch already quiescent at the previous step may only receive non-zero values in the layers
+            // along its edges (exchanges, sums of currents, boundary conditions), unless it has antennas
+            ElectroMagn *EMfields = ( *this )( ipatch )->EMfields;
+            bool borders_only = EMfields->quiescent_ && EMfields->antennas.empty();
+            EMfields->quiescent_ = ( *this )( ipatch )->hasNoParticles() && EMfields->fieldsAreZero( borders_only );
+            if( EMfields->quiescent_ ) {
+                // The deferred steps would leave the fields zero
+                EMfields->deferred_steps_ = 0;
+                continue;
+            }
+        }
+        if( params.temporal_blocking ) {
+            // Patches along the domain boundaries need E and B at every step for the boundary conditions.
+            // A patch already deferred at the previous step may only receive currents in the layers along its edges
+            ElectroMagn *EMfields = ( *this )( ipatch )->EMfields;
+            if( defer && ! ( *this )( ipatch )->isAnyBoundary()
+                && ( *this )( ipatch )->hasNoParticles() && EMfields->antennas.empty()
+                && EMfields->fieldsAreZero( EMfields->deferred_steps_ > 0, true ) ) {
+                EMfields->deferred_steps_++;
+                continue;
+            }
+            EMfields->applyDeferredSteps( false );
+        }
         if( !params.is_spectral ) {
             // Saving magnetic fields (to compute centered fields used in the particle pusher)
             // Stores B at time n in B_m.
             ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
         }
-        // Computes Ex_, Ey_, Ez_ on all points.
-        // E is already synchronized because J has been synchronized before.
-        ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        if( ( *this )( ipatch )->EMfields->MaxwellSolver_ ) {
+            // Computes E on all points and B at time n+1 on interior points, in a single sweep.
+            ( *( *this )( ipatch )->EMfields->MaxwellSolver_ )( ( *this )( ipatch )->EMfields );
+        } else {
+            // Computes Ex_, Ey_, Ez_ on all points.
+            // E is already synchronized because J has been synchronized before.
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        }
     }
 
     #pragma omp for schedule(static)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        if( ( *this )( ipatch )->EMfields->MaxwellSolver_ || ( *this )( ipatch )->EMfields->quiescent_ ) {
+            continue;
+        }
         // Computes Bx_, By_, Bz_ at time n+1 on interior points.
         ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
     }
@@ -1047,7 +1148,11 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
     timers.syncField.restart();
     if( params.geometry != "AMcylindrical" ) {
         if( params.is_spectral ) SyncVectorPatch::exchangeE( params, ( *this ), smpi );
-        SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+        if( params.exchange_fields_each == 1 ) {
+            SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+        } else if( wideHaloExchangeIsNeeded( params, itime ) ) {
+            SyncVectorPatch::exchangeEB( params, ( *this ), smpi );
+        }
     } else {
         for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->El_.size() ; imode++ ) {
             if( params.is_spectral ) SyncVectorPatch::exchangeE( params, ( *this ), imode, smpi );
@@ -1102,6 +1207,16 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
 
 } // END solveMaxwell
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// With wide halos, the ghost cells of E and B are valid during exchange_fields_each iterations after an exchange.
+// Patches created or received since the last iteration have no valid ghost cells, exchange immediately.
+// ---------------------------------------------------------------------------------------------------------------------
+bool VectorPatch::wideHaloExchangeIsNeeded( Params &params, int itime )
+{
+    return ( itime % params.exchange_fields_each == 0 ) || ( ( unsigned int )itime == lastIterationPatchesMoved+1 );
+}
+
 void VectorPatch::solveEnvelope( Params &params, SimWindow *simWindow, int, double time_dual, Timers &timers, SmileiMPI *smpi )
 {
 
@@ -1163,7 +1278,7 @@ void VectorPatch::finalizeSyncAndBCFields( Params &params, SmileiMPI *smpi, SimW
         double time_dual, Timers &timers, int itime )
 {
     if ( (!params.multiple_decomposition) && ( itime!=0 ) && ( time_dual > params.time_fields_frozen ) ) { // multiple_decomposition = true -> is_spectral = true
-        if( params.geometry != "AMcylindrical" ) {
+        if( params.geometry != "AMcylindrical" && params.exchange_fields_each == 1 ) {
             timers.syncField.restart();
             SyncVectorPatch::finalizeexchangeB( params, ( *this ) );
             timers.syncField.update( params.printNow( itime ) );
@@ -1183,6 +1298,10 @@ void VectorPatch::finalizeSyncAndBCFields( Params &params, SmileiMPI *smpi, SimW
 
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            // Particles entering a patch interpolate E and B at the next step: its deferred steps are applied now
+            if( ( *this )( ipatch )->EMfields->deferred_steps_ > 0 && ! ( *this )( ipatch )->hasNoParticles() ) {
+                ( *this )( ipatch )->EMfields->applyDeferredSteps( true );
+            }
             // Computes B at time n using B and B_m.
             if( !params.is_spectral ) {
                 ( *this )( ipatch )->EMfields->centerMagneticFields();
@@ -1245,6 +1364,15 @@ void VectorPatch::initAllDiags( Params &params, SmileiMPI *smpi )
 
 void VectorPatch::closeAllDiags( SmileiMPI *smpi )
 {
+    // Complete the background writes
+    if( async_writer_ ) {
+        delete async_writer_;
+        async_writer_ = NULL;
+        for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+            globalDiags[idiag]->async_writer_ = NULL;
+        }
+    }
+
     // MPI master closes all global diags
     if( smpi->isMaster() )
         for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
@@ -1478,7 +1606,13 @@ void VectorPatch::runAllDiags( Params &/*params*/, SmileiMPI *smpi, unsigned int
 // #endif
 
         #pragma omp single
-        localDiags[idiag]->theTimeIsNow_ = localDiags[idiag]->prepare( itime );
+        {
+            localDiags[idiag]->theTimeIsNow_ = localDiags[idiag]->prepare( itime );
+            // HDF5 must not be used concurrently by the background writes
+            if( localDiags[idiag]->theTimeIsNow_ ) {
+                waitDiagsOutput();
+            }
+        }
         // All MPI run their stuff and write out
         if( localDiags[idiag]->theTimeIsNow_ ) {
             localDiags[idiag]->run( smpi, *this, itime, simWindow, timers );
@@ -1496,6 +1630,9 @@ void VectorPatch::runAllDiags( Params &/*params*/, SmileiMPI *smpi, unsigned int
         #pragma omp for
         for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
             ( *this )( ipatch )->EMfields->restartRhoJs();
+            if( lazy_species_densities_ && !needsRhoJsNow( itime+1 ) ) {
+                ( *this )( ipatch )->EMfields->releaseRhoJs( ( *this )( ipatch )->vecSpecies );
+            }
 
 #if defined (SMILEI_ACCELERATOR_GPU)
             // Delete species current and rho grids from device 
@@ -1608,7 +1745,13 @@ void VectorPatch::runAllDiagsTasks( Params &, SmileiMPI *smpi, unsigned int itim
         diag_timers_[globalDiags.size()+idiag]->restart();
 
         #pragma omp single
-        localDiags[idiag]->theTimeIsNow_ = localDiags[idiag]->prepare( itime );
+        {
+            localDiags[idiag]->theTimeIsNow_ = localDiags[idiag]->prepare( itime );
+            // HDF5 must not be used concurrently by the background writes
+            if( localDiags[idiag]->theTimeIsNow_ ) {
+                waitDiagsOutput();
+            }
+        }
         #pragma omp barrier
         // All MPI run their stuff and write out
         if( localDiags[idiag]->theTimeIsNow_ ) {
@@ -1626,6 +1769,9 @@ void VectorPatch::runAllDiagsTasks( Params &, SmileiMPI *smpi, unsigned int itim
         #pragma omp for
         for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
             ( *this )( ipatch )->EMfields->restartRhoJs();
+            if( lazy_species_densities_ && !needsRhoJsNow( itime+1 ) ) {
+                ( *this )( ipatch )->EMfields->releaseRhoJs( ( *this )( ipatch )->vecSpecies );
+            }
         }
     }
     timers.diags.update();
@@ -1705,6 +1851,20 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     if( smpi->isMaster() ) {
         DEBUG( "Starting iterative loop for CG method" );
     }
+    if( params.poisson_solver == "pipelined_PCG" ) {
+        PipelinedCG<double, Field> pcg( *this, smpi, params.poisson_chebyshev_degree, [this]( unsigned int ipatch ) {
+            ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
+        } );
+        // Returns converged or at iteration_max : the CG loop below is skipped
+        iteration = pcg.solve( iteration_max, error_max, [nx_p2_global]( double r_dot_r ) {
+            return r_dot_r / ( double )( nx_p2_global );
+        }, ctrl );
+    } else if( params.poisson_solver == "FFT" ) {
+        PoissonFFT fft( params, *this, smpi );
+        fft.solve( 1. );
+        // Direct solve : the CG loop below is skipped
+        ctrl = 0.;
+    }
     while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
         iteration++;
         if( smpi->isMaster() ) {
@@ -1764,7 +1924,11 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     // --------------------------------
     // Status of the solver convergence
     // --------------------------------
-    if( iteration_max>0 && iteration == iteration_max ) {
+    if( params.poisson_solver == "FFT" ) {
+        if( smpi->isMaster() ) {
+            MESSAGE( 1, "Poisson equation solved with FFTs" );
+        }
+    } else if( iteration_max>0 && iteration == iteration_max ) {
         if( smpi->isMaster() )
             WARNING( "Poisson solver did not converge: reached maximum iteration number: " << iteration
                      << ", relative err is ctrl = " << 1.0e14*ctrl << " x 1e-14" );
@@ -1994,6 +2158,16 @@ void VectorPatch::solvePoissonAM( Params &params, SmileiMPI *smpi )
         }
 
         iteration = 0;//MESSAGE("Initial error parameter (must be 1) : "<<ctrl);
+        if( params.poisson_solver == "pipelined_PCG" ) {
+            PipelinedCG<complex<double>, cField> pcg( *this, smpi, params.poisson_chebyshev_degree, [this, imode]( unsigned int ipatch ) {
+                ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( ( *this )( ipatch )->EMfields );
+                emAM->compute_Ap_Poisson_AM( ( *this )( ipatch ), imode );
+            } );
+            // Returns converged or at iteration_max : the CG loop below is skipped
+            iteration = pcg.solve( iteration_max, error_max, [norm2_source_term]( double r_dot_r ) {
+                return sqrt( std::abs( r_dot_r ) )/norm2_source_term;
+            }, ctrl );
+        }
         while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
             iteration++;
 
@@ -2312,6 +2486,20 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     if( smpi->isMaster() ) {
         DEBUG( "Starting iterative loop for CG method" );
     }
+    if( params.poisson_solver == "pipelined_PCG" ) {
+        PipelinedCG<double, Field> pcg( *this, smpi, params.poisson_chebyshev_degree, [this, gamma_mean]( unsigned int ipatch ) {
+            ( *this )( ipatch )->EMfields->compute_Ap_relativistic_Poisson( ( *this )( ipatch ), gamma_mean );
+        } );
+        // Returns converged or at iteration_max : the CG loop below is skipped
+        iteration = pcg.solve( iteration_max, error_max, [norm2_source_term]( double r_dot_r ) {
+            return sqrt( r_dot_r )/norm2_source_term;
+        }, ctrl );
+    } else if( params.poisson_solver == "FFT" ) {
+        PoissonFFT fft( params, *this, smpi );
+        fft.solve( gamma_mean );
+        // Direct solve : the CG loop below is skipped
+        ctrl = 0.;
+    }
     while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
         iteration++;
 
@@ -2374,7 +2562,11 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     // --------------------------------
     // Status of the solver convergence
     // --------------------------------
-    if( iteration_max>0 && iteration == iteration_max ) {
+    if( params.poisson_solver == "FFT" ) {
+        if( smpi->isMaster() ) {
+            MESSAGE( 1, "Relativistic Poisson equation solved with FFTs" );
+        }
+    } else if( iteration_max>0 && iteration == iteration_max ) {
         if( smpi->isMaster() )
             WARNING( "Relativistic Poisson solver did not converge: reached maximum iteration number: " << iteration
                      << ", relative err is ctrl = " << 1.0e22*ctrl << "x 1.e-22" );
@@ -2740,6 +2932,16 @@ void VectorPatch::solveRelativisticPoissonAM( Params &params, SmileiMPI *smpi, d
         }
 
         iteration = 0;//MESSAGE("Initial error parameter (must be 1) : "<<ctrl);
+        if( params.poisson_solver == "pipelined_PCG" ) {
+            PipelinedCG<complex<double>, cField> pcg( *this, smpi, params.poisson_chebyshev_degree, [this, imode, gamma_mean]( unsigned int ipatch ) {
+                ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( ( *this )( ipatch )->EMfields );
+                emAM->compute_Ap_relativistic_Poisson_AM( ( *this )( ipatch ), gamma_mean, imode );
+            } );
+            // Returns converged or at iteration_max : the CG loop below is skipped
+            iteration = pcg.solve( iteration_max, error_max, [norm2_source_term]( double r_dot_r ) {
+                return sqrt( std::abs( r_dot_r ) )/norm2_source_term;
+            }, ctrl );
+        }
         while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
             iteration++;
 
@@ -3206,6 +3408,10 @@ void VectorPatch::exchangePatches( SmileiMPI *smpi, Params &params )
     this->setRefHindex() ;
     updateFieldList( smpi ) ;
 
+    // The buffers kept by the moving window were sized for the former patches
+    FieldBufferPool<double>::clear();
+    FieldBufferPool<std::complex<double>>::clear();
+
 } // END exchangePatches
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -3271,6 +3477,12 @@ void VectorPatch::updateFieldList( SmileiMPI *smpi )
     MPIyIdx.clear();
     MPIzIdx.clear();
 
+    // The patch distribution changed, aggregated messages must be rebuilt
+    for( unsigned int iDim=0 ; iDim<3 ; iDim++ ) {
+        B_exchange_[iDim].invalidate();
+        densities_exchange_[iDim].invalidate();
+    }
+
     if( !dynamic_cast<ElectroMagnAM *>( patches_[0]->EMfields ) ) {
 
         listJx_.resize( size() ) ;
@@ -4110,6 +4322,20 @@ void VectorPatch::allocateField( unsigned int ifield, Params &params )
 }
 
 
+// For all patches, allocate the species densities released by ElectroMagn::releaseRhoJs
+// Must be called by all threads once diag_flag is set
+void VectorPatch::allocateSpeciesDensities()
+{
+    if( !lazy_species_densities_ || !diag_flag ) {
+        return;
+    }
+    #pragma omp for schedule(static)
+    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        ( *this )( ipatch )->EMfields->allocateRhoJs();
+    }
+}
+
+
 // For each patch, apply external fields
 void VectorPatch::applyExternalFields()
 {
@@ -4536,6 +4762,7 @@ void VectorPatch::ponderomotiveUpdatePositionAndCurrents( Params &params,
 
     #pragma omp single
     diag_flag = needsRhoJsNow( itime );
+    allocateSpeciesDensities();
 
     timers.particles.restart();
 
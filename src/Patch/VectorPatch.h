@@ -14,6 +14,7 @@
 #include "Checkpoint.h"
 #include "OpenPMDparams.h"
 #include "SmileiMPI.h"
+#include "NodeAwareExchange.h"
 #include "SimWindow.h"
 #include "Timers.h"
 #include "RadiationTables.h"
@@ -50,6 +51,17 @@ public :
     //! Vector of local diagnostics (diagnostics which can partly be computed locally)
     std::vector<Diagnostic *> localDiags;
     
+    //! Background writer of the global diagnostics (MPI master only, NULL if synchronous)
+    AsyncWriter *async_writer_;
+    
+    //! Wait for the background writes of the global diagnostics, before any other use of HDF5
+    inline void waitDiagsOutput()
+    {
+        if( async_writer_ ) {
+            async_writer_->wait();
+        }
+    }
+    
     //! Some vector operations extended to VectorPatch
     inline void resize( int npatches )
     {
@@ -102,6 +114,21 @@ public :
             
         return false;
     }
+    
+    //! Whether some diagnostic may read E and B at this timestep
+    bool diagsReadFieldsNow( int timestep )
+    {
+        for( unsigned int i=0; i<globalDiags.size(); i++ )
+            if( globalDiags[i]->readsFields( timestep ) ) {
+                return true;
+            }
+        for( unsigned int i=0; i<localDiags.size(); i++ )
+            if( localDiags[i]->readsFields( timestep ) ) {
+                return true;
+            }
+            
+        return false;
+    }
 
 #  ifdef _PARTEVENTTRACING  
     // Write Output for Particle Event Tracing diagnostic - this method must be called inside a pragma omp single construct
@@ -167,6 +194,9 @@ public :
     //! Particle merging
     void mergeParticles( Params &params, double time_dual, Timers &timers, int itime );
 
+    //! Particle splitting
+    void splitParticles( Params &params, double time_dual, Timers &timers, int itime );
+
     //! Clean MPI buffers and resize particle arrays to save memory
     void cleanParticlesOverhead(Params &params, Timers &timers, int itime );
                               
@@ -220,6 +250,8 @@ public :
     //! For all patch, update E and B (Ampere, Faraday, boundary conditions, exchange B and center B)
     void solveMaxwell( Params &params, SimWindow *simWindow, int itime, double time_dual,
                        Timers &timers, SmileiMPI *smpi );
+    //! With Main.exchange_fields_each > 1, true if E and B must be exchanged at iteration itime
+    bool wideHaloExchangeIsNeeded( Params &params, int itime );
                        
     //! For all patch, update envelope field A (envelope equation, boundary contitions, exchange A)
     void solveEnvelope( Params &params, SimWindow *simWindow, int itime, double time_dual, Timers &timers, SmileiMPI *smpi );
@@ -267,6 +299,9 @@ public :
     //! For all patches, allocate a field if not allocated
     void allocateField( unsigned int ifield, Params &params );
     
+    //! For all patches, allocate the species densities released in empty patches, if they are projected now
+    void allocateSpeciesDensities();
+    
     //! For each patch, apply external fields
     void applyExternalFields();
     
@@ -358,6 +393,17 @@ public :
     
     std::vector<Field *> B2_localz;
     std::vector<Field *> B2_MPIz;
+
+    //! If true, B_MPI* and densitiesMPI* are exchanged with one message per MPI process (Main.node_aware_exchange)
+    bool node_aware_exchange_;
+    //! Aggregated exchanges of B_MPIx, B1_MPIy and B2_MPIz
+    NodeAwareExchange B_exchange_[3];
+    //! Aggregated sums of densitiesMPIx, densitiesMPIy and densitiesMPIz
+    NodeAwareExchange densities_exchange_[3];
+    
+    //! If true, the species densities (Jx_s, rho_s ...) are allocated only in the patches which contain particles of
+    //! the species, or when they are projected for diagnostics
+    bool lazy_species_densities_;
     
     std::vector<Field *> listJx_;
     std::vector<Field *> listJy_;
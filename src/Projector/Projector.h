@@ -1,7 +1,9 @@
 #ifndef PROJECTOR_H
 #define PROJECTOR_H
 
+#include <algorithm>
 #include <complex>
+#include <vector>
 
 #include "Params.h"
 #include "Field.h"
@@ -45,6 +47,36 @@ public:
     //! Project global current densities if Ionization in Species::dynamics,
     virtual void ionizationCurrentsForTasks( double *, double *, double *, Particles &, int, LocalFields, int ) {};
 
+    //! Whether the ionization currents can be deposited by currentsAndDensityWrapper, together with the currents
+    //! of the species, instead of a separate call to ionizationCurrents
+    virtual bool fusesIonizationCurrents()
+    {
+        return false;
+    }
+
+    //! Called before the ionization of each timestep: the ionization currents are fused with the projection of the
+    //! species currents if this projection happens after the push (see Species::dynamics)
+    void prepareIonizationCurrents( bool projected )
+    {
+        fused_ionization_currents_ = projected && fusesIonizationCurrents();
+        ionized_particles_.clear();
+        ionization_currents_.clear();
+    }
+
+    //! Whether the ionization currents are stored with storeIonizationCurrent during this timestep
+    bool fusedIonizationCurrents() const
+    {
+        return fused_ionization_currents_;
+    }
+
+    //! Store the ionization current of particle ipart, to be deposited by currentsAndDensityWrapper
+    //! (the particles must be stored in increasing order)
+    void storeIonizationCurrent( unsigned int ipart, LocalFields Jion )
+    {
+        ionized_particles_.push_back( ipart );
+        ionization_currents_.push_back( Jion );
+    }
+
     //!Wrapper
     virtual void currentsAndDensityWrapper( ElectroMagn *, Particles &, SmileiMPI *, int, int, int, bool, bool, int, int = 0, int = 0 ) = 0;
 
@@ -67,6 +99,32 @@ public:
     
 protected:
     double inv_cell_volume;
+
+    //! 2nd order shapes, on 3 nodes, of a particle at a distance delta of the primal node ip: on the primal grid (Sp)
+    //! and on the dual grid (Sd), around the dual node id
+    static inline void quadraticShapes( double delta, int ip_m_id, double *Sp, double *Sd )
+    {
+        double delta2 = delta*delta;
+        Sp[0] = 0.5 * ( delta2-delta+0.25 );
+        Sp[1] = ( 0.75-delta2 );
+        Sp[2] = 0.5 * ( delta2+delta+0.25 );
+        delta += ( double )ip_m_id + 0.5;
+        delta2 = delta*delta;
+        Sd[0] = 0.5 * ( delta2-delta+0.25 );
+        Sd[1] = ( 0.75-delta2 );
+        Sd[2] = 0.5 * ( delta2+delta+0.25 );
+    }
+
+    //! Index, in ionized_particles_, of the first stored particle with an index >= ipart
+    size_t firstIonizedParticle( unsigned int ipart ) const
+    {
+        return std::lower_bound( ionized_particles_.begin(), ionized_particles_.end(), ipart ) - ionized_particles_.begin();
+    }
+
+    bool fused_ionization_currents_ = false;
+    //! Particles ionized during the timestep (sorted) and their ionization current, when fused with the projection
+    std::vector<unsigned int> ionized_particles_;
+    std::vector<LocalFields> ionization_currents_;
 };
 
 #endif
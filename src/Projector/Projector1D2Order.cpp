@@ -309,11 +309,41 @@ void Projector1D2Order::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Par
     
 } // END Project global current densities (ionize)
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities (ionize), fused with the projection of the species currents:
+//! the particle was ionized at its former position, already located by the interpolator (iold, deltaold)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2Order::ionizationCurrents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int ipart, LocalFields Jion, int *iold, double *deltaold )
+{
+    double Sp[3], Sd[3];
+    
+    // weighted currents
+    double weight = inv_cell_volume * particles.weight( ipart );
+    double Jx_ion = Jion.x * weight;
+    double Jy_ion = Jion.y * weight;
+    double Jz_ion = Jion.z * weight;
+    
+    // Primal and dual shapes: the central dual node is ip+1 if the particle is beyond the primal node ip
+    int ip = *iold;
+    int id = ip + ( *deltaold >= 0. ? 1 : 0 );
+    quadraticShapes( *deltaold, ip-id, Sp, Sd );
+    
+    for( unsigned int i=0 ; i<3 ; i++ ) {
+        Jx[id+i-1] += Sd[i] * Jx_ion;
+        Jy[ip+i-1] += Sp[i] * Jy_ion;
+        Jz[ip+i-1] += Sp[i] * Jz_ion;
+    }
+    
+} // END Project global current densities (ionize), fused
+
 void Projector1D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
     std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    // Ionization currents of this range of particles, if fused with the projection (see Projector::storeIonizationCurrent)
+    size_t iion = firstIonizedParticle( istart );
     
     double *Jx  =  &( *EMfields->Jx_ )( 0 );
     double *Jy  =  &( *EMfields->Jy_ )( 0 );
@@ -325,10 +355,16 @@ void Projector1D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
         if( !is_spectral ) {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
                 currents( Jx, Jy, Jz, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                    ionizationCurrents( Jx, Jy, Jz, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+                }
             }
         } else {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
                 currentsAndDensity( Jx, Jy, Jz, rho, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                    ionizationCurrents( Jx, Jy, Jz, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+                }
             }
         }
         // Otherwise, the projection may apply to the species-specific arrays
@@ -339,6 +375,9 @@ void Projector1D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
         double *b_rhos = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
         for( int ipart=istart ; ipart<iend; ipart++ ) {
             currentsAndDensity( b_Jxs, b_Jys, b_Jzs, b_rhos, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+            if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                ionizationCurrents( b_Jxs, b_Jys, b_Jzs, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+            }
         }
     }
 }
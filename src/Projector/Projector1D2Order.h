@@ -22,6 +22,14 @@ public:
 
     //! Project global current densities if Ionization in Species::dynamics,
     void ionizationCurrentsForTasks( double *b_Jx, double *b_Jy, double *b_Jz, Particles &particles, int ipart, LocalFields Jion, int bin_shift ) override final;
+
+    //! The ionization currents are deposited by currentsAndDensityWrapper
+    bool fusesIonizationCurrents() override final
+    {
+        return true;
+    }
+    //! Project global current densities if Ionization, at the former position of the particle (fused projection)
+    inline void ionizationCurrents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int ipart, LocalFields Jion, int *iold, double *deltaold );
     
     //!Wrapper
     void currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int icell = 0, int ipart_ref = 0 ) override final;
@@ -492,6 +492,47 @@ void Projector2D2Order::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Par
 } // END Project global current densities (ionize)
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities (ionize), fused with the projection of the species currents:
+//! the particle was ionized at its former position, already located by the interpolator (iold, deltaold)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D2Order::ionizationCurrents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int ipart, LocalFields Jion, int *iold, double *deltaold )
+{
+    int nparts = particles.size();
+    double Sxp[3], Sxd[3], Syp[3], Syd[3];
+    
+    // weighted currents
+    double weight = inv_cell_volume * particles.weight( ipart );
+    double Jx_ion = Jion.x * weight;
+    double Jy_ion = Jion.y * weight;
+    double Jz_ion = Jion.z * weight;
+    
+    // Primal and dual shapes: the central dual node is ip+1 if the particle is beyond the primal node ip
+    int ip = iold[0*nparts];
+    int id = ip + ( deltaold[0*nparts] >= 0. ? 1 : 0 );
+    quadraticShapes( deltaold[0*nparts], ip-id, Sxp, Sxd );
+    int jp = iold[1*nparts];
+    int jd = jp + ( deltaold[1*nparts] >= 0. ? 1 : 0 );
+    quadraticShapes( deltaold[1*nparts], jp-jd, Syp, Syd );
+    
+    for( unsigned int i=0 ; i<3 ; i++ ) {
+        int iploc=ip+i-1;
+        int idloc=id+i-1;
+        for( unsigned int j=0 ; j<3 ; j++ ) {
+            int jploc=jp+j-1;
+            int jdloc=jd+j-1;
+            // Jx^(d,p)
+            Jx[idloc*nprimy+jploc]           += Jx_ion * Sxd[i]*Syp[j];
+            // Jy^(p,d)
+            Jy[iploc*( nprimy+pxr )+jdloc]   += Jy_ion * Sxp[i]*Syd[j];
+            // Jz^(p,p)
+            Jz[iploc*nprimy+jploc]           += Jz_ion * Sxp[i]*Syp[j];
+        }
+    }//i
+    
+} // END Project global current densities (ionize), fused
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
@@ -500,6 +541,8 @@ void Projector2D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
     std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    // Ionization currents of this range of particles, if fused with the projection (see Projector::storeIonizationCurrent)
+    size_t iion = firstIonizedParticle( istart );
     Jx_  =  &( *EMfields->Jx_ )( 0 );
     Jy_  =  &( *EMfields->Jy_ )( 0 );
     Jz_  =  &( *EMfields->Jz_ )( 0 );
@@ -512,10 +555,16 @@ void Projector2D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
                 // cerr << ipart << endl;
                 // cerr << ( *iold )[ipart] << endl;
                 currents( Jx_, Jy_, Jz_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                    ionizationCurrents( Jx_, Jy_, Jz_, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+                }
             }
         } else {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
                 currentsAndDensity( Jx_, Jy_, Jz_, rho_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                    ionizationCurrents( Jx_, Jy_, Jz_, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+                }
             }
         }
         // Otherwise, the projection may apply to the species-specific arrays
@@ -526,6 +575,9 @@ void Projector2D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
         double *b_rho = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
         for( int ipart=istart ; ipart<iend; ipart++ ) {
             currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+            if( iion < ionized_particles_.size() && ionized_particles_[iion] == ( unsigned int )ipart ) {
+                ionizationCurrents( b_Jx, b_Jy, b_Jz, particles, ipart, ionization_currents_[iion++], &( *iold )[ipart], &( *delta )[ipart] );
+            }
         }
     }
 }
@@ -565,6 +565,9 @@ void Projector2D2OrderV::currents( double * __restrict__ Jx,
 
     } // end vectors
 
+    // Ionization currents of the particles of the cell, if fused with the projection
+    ionizationCurrents( bJx, bJy, bJz, particles, istart, iend, deltaold, buffer_size, ipart_ref );
+
     int iloc0 = (ipom2-bin_shift)*nprimy+jpom2;
     int iloc = iloc0;
     for( unsigned int i=1 ; i<5 ; i++ ) {
@@ -614,6 +617,47 @@ void Projector2D2OrderV::currents( double * __restrict__ Jx,
 } // END Project vectorized
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Add the ionization currents of the particles [istart, iend[ of a cell to the local buffers of the projection
+//! (see Projector::storeIonizationCurrent): the particles were ionized at their former position, located relative to
+//! the node of the cell, which is the center (2,2) of the buffers
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D2OrderV::ionizationCurrents( double *bJx, double *bJy, double *bJz, Particles &particles, unsigned int istart, unsigned int iend, double *deltaold, unsigned int buffer_size, int ipart_ref )
+{
+    int vecSize = 8;
+    double Sxp[3], Sxd[3], Syp[3], Syd[3];
+
+    for( size_t iion = firstIonizedParticle( istart ); iion < ionized_particles_.size() && ionized_particles_[iion] < iend; iion++ ) {
+        unsigned int ipart = ionized_particles_[iion];
+
+        // weighted currents
+        double weight = inv_cell_volume * particles.weight( ipart );
+        double Jx_ion = ionization_currents_[iion].x * weight;
+        double Jy_ion = ionization_currents_[iion].y * weight;
+        double Jz_ion = ionization_currents_[iion].z * weight;
+
+        // Shift of the central dual node: 1 if the particle is beyond the node of the cell
+        double deltax = deltaold[ipart-ipart_ref];
+        double deltay = deltaold[ipart-ipart_ref+buffer_size];
+        int id = deltax >= 0. ? 1 : 0;
+        int jd = deltay >= 0. ? 1 : 0;
+        quadraticShapes( deltax, -id, Sxp, Sxd );
+        quadraticShapes( deltay, -jd, Syp, Syd );
+
+        for( unsigned int i=0 ; i<3 ; i++ ) {
+            for( unsigned int j=0 ; j<3 ; j++ ) {
+                // Jx^(d,p)
+                bJx[( ( id+i+1 )*5+j+1 )*vecSize] += Jx_ion * Sxd[i]*Syp[j];
+                // Jy^(p,d)
+                bJy[( ( i+1 )*5+jd+j+1 )*vecSize] += Jy_ion * Sxp[i]*Syd[j];
+                // Jz^(p,p)
+                bJz[( ( i+1 )*5+j+1 )*vecSize]    += Jz_ion * Sxp[i]*Syp[j];
+            }
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
@@ -45,6 +45,14 @@ public:
     //! Project global current densities if Ionization in Species::dynamics,
     void ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion ) override final;
 
+    //! The ionization currents are deposited by currentsAndDensityWrapper
+    bool fusesIonizationCurrents() override final
+    {
+        return true;
+    }
+    //! Add the ionization currents of the particles of a cell to the local buffers of currents (fused projection)
+    void ionizationCurrents( double *bJx, double *bJy, double *bJz, Particles &particles, unsigned int istart, unsigned int iend, double *deltaold, unsigned int buffer_size, int ipart_ref );
+
     //!Wrapper
     void currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int icell,  int ipart_ref ) override final;
     
@@ -592,6 +592,9 @@ void Projector3D2OrderV::currents( double * __restrict__ Jx,
 
     } // END ivect
 
+    // Ionization currents of the particles of the cell, if fused with the projection
+    ionizationCurrents( bJx, bJy, bJz, particles, istart, iend, deltaold, buffer_size, ipart_ref );
+
     int iglobal0 = (ipom2-bin_shift)*nyz+jpom2*nprimz+kpom2;
 
     int iglobal  = iglobal0;
@@ -649,6 +652,52 @@ void Projector3D2OrderV::currents( double * __restrict__ Jx,
 } // END Project vectorized
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Add the ionization currents of the particles [istart, iend[ of a cell to the local buffers of the projection
+//! (see Projector::storeIonizationCurrent): the particles were ionized at their former position, located relative to
+//! the node of the cell, which is the center (2,2,2) of the buffers
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D2OrderV::ionizationCurrents( double *bJx, double *bJy, double *bJz, Particles &particles, unsigned int istart, unsigned int iend, double *deltaold, unsigned int buffer_size, int ipart_ref )
+{
+    int vecSize = 8;
+    double Sxp[3], Sxd[3], Syp[3], Syd[3], Szp[3], Szd[3];
+
+    for( size_t iion = firstIonizedParticle( istart ); iion < ionized_particles_.size() && ionized_particles_[iion] < iend; iion++ ) {
+        unsigned int ipart = ionized_particles_[iion];
+
+        // weighted currents
+        double weight = inv_cell_volume * particles.weight( ipart );
+        double Jx_ion = ionization_currents_[iion].x * weight;
+        double Jy_ion = ionization_currents_[iion].y * weight;
+        double Jz_ion = ionization_currents_[iion].z * weight;
+
+        // Shift of the central dual node: 1 if the particle is beyond the node of the cell
+        double deltax = deltaold[ipart-ipart_ref];
+        double deltay = deltaold[ipart-ipart_ref+buffer_size];
+        double deltaz = deltaold[ipart-ipart_ref+2*buffer_size];
+        int id = deltax >= 0. ? 1 : 0;
+        int jd = deltay >= 0. ? 1 : 0;
+        int kd = deltaz >= 0. ? 1 : 0;
+        quadraticShapes( deltax, -id, Sxp, Sxd );
+        quadraticShapes( deltay, -jd, Syp, Syd );
+        quadraticShapes( deltaz, -kd, Szp, Szd );
+
+        for( unsigned int i=0 ; i<3 ; i++ ) {
+            for( unsigned int j=0 ; j<3 ; j++ ) {
+                for( unsigned int k=0 ; k<3 ; k++ ) {
+                    // Jx^(d,p,p)
+                    bJx[( ( id+i+1 )*25+( j+1 )*5+k+1 )*vecSize] += Jx_ion * Sxd[i]*Syp[j]*Szp[k];
+                    // Jy^(p,d,p)
+                    bJy[( ( i+1 )*25+( jd+j+1 )*5+k+1 )*vecSize] += Jy_ion * Sxp[i]*Syd[j]*Szp[k];
+                    // Jz^(p,p,d)
+                    bJz[( ( i+1 )*25+( j+1 )*5+kd+k+1 )*vecSize] += Jz_ion * Sxp[i]*Syp[j]*Szd[k];
+                }
+            }
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
@@ -42,6 +42,14 @@ public:
     
     //! Project global current densities if Ionization in SpeciesV::dynamics,
     void ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion ) override final;
+
+    //! The ionization currents are deposited by currentsAndDensityWrapper
+    bool fusesIonizationCurrents() override final
+    {
+        return true;
+    }
+    //! Add the ionization currents of the particles of a cell to the local buffers of currents (fused projection)
+    void ionizationCurrents( double *bJx, double *bJy, double *bJz, Particles &particles, unsigned int istart, unsigned int iend, double *deltaold, unsigned int buffer_size, int ipart_ref );
     
     //! Project global current densities if Ionization in SpeciesV::dynamics,
     void ionizationCurrentsForTasks( double *b_Jx, double *b_Jy, double *b_Jz, Particles &particles, int ipart, LocalFields Jion, int bin_shift ) override final;
@@ -83,7 +83,9 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
     int vecSize = 8;
     int bsize = 5*5*vecSize*Nmode_;
 
-    std::complex<double> brho[bsize] __attribute__( ( aligned( 64 ) ) );
+    // Real and imaginary parts of the modes are deposited in separate buffers
+    double brho_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double brho_im[bsize] __attribute__( ( aligned( 64 ) ) );
 
     double Sl0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
     double Sr0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
@@ -91,6 +93,12 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
     double DSr[40] __attribute__( ( aligned( 64 ) ) );
     double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
     double r_bar[8] __attribute__( ( aligned( 64 ) ) );
+    // Powers of exp(i theta) for all modes (mode 1 is always needed)
+    int nfactors = vecSize*max( Nmode_, 2u );
+    double e_bar_re[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_bar_im[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_delta_re[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_delta_im[nfactors] __attribute__( ( aligned( 64 ) ) );
     complex<double> * __restrict__ rho;
 
     double *invR_local = &(invR_[jpom2]);
@@ -105,7 +113,8 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
 
     #pragma omp simd
     for( unsigned int j=0; j<200*Nmode_; j++ ) {
-        brho[j] = 0.;
+        brho_re[j] = 0.;
+        brho_im[j] = 0.;
     }
 
     // Closest multiple of 8 higher or equal than npart = iend-istart.
@@ -115,17 +124,16 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
 
         int np_computed = min( cell_nparts-ivect, vecSize );
         int istart0 = ( int )istart + ivect;
-        complex<double> e_bar[8], e_delta_m1[8];
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            compute_distances( position_x, position_y, position_z, cell_keys, npart_total, ipart, istart0, ipart_ref, deltaold, array_eitheta_old, iold, Sl0_buff_vect, Sr0_buff_vect, DSl, DSr, r_bar, e_bar, e_delta_m1 );
+            compute_distances( position_x, position_y, position_z, cell_keys, npart_total, ipart, istart0, ipart_ref, deltaold, array_eitheta_old, iold, Sl0_buff_vect, Sr0_buff_vect, DSl, DSr, r_bar, e_bar_re, e_bar_im, e_delta_re, e_delta_im );
             charge_weight[ipart] = inv_cell_volume * ( double )( charge[istart0+ipart] )*weight[istart0+ipart];
         }
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            computeRho( ipart, charge_weight, DSl, DSr, Sl0_buff_vect, Sr0_buff_vect, brho, invR_local, e_bar);
+            computeRho( ipart, charge_weight, DSl, DSr, Sl0_buff_vect, Sr0_buff_vect, brho_re, brho_im, invR_local, e_bar_re, e_bar_im );
         }
     }
 
@@ -139,13 +147,14 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
         for( unsigned int i=0 ; i<5 ; i++ ) {
             #pragma omp simd
             for( unsigned int j=0 ; j<5 ; j++ ) {
-                complex<double> tmprho( 0. );
+                double tmprho_re( 0. ), tmprho_im( 0. );
                 int ilocal = ( i*5+j )*vecSize;
                 UNROLL(8)
                 for( int ipart=0 ; ipart<8; ipart++ ) {
-                    tmprho += brho [200*imode + ilocal+ipart];
+                    tmprho_re += brho_re [200*imode + ilocal+ipart];
+                    tmprho_im += brho_im [200*imode + ilocal+ipart];
                 }
-                rho[iloc+j] += tmprho;
+                rho[iloc+j] += complex<double>( tmprho_re, tmprho_im );
             }
             iloc += nprimr_;
         }
@@ -470,9 +479,13 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
     int vecSize = 8;
     int bsize = 5*5*vecSize*Nmode_;
 
-    std::complex<double> bJl[bsize] __attribute__( ( aligned( 64 ) ) );
-    std::complex<double> bJr[bsize] __attribute__( ( aligned( 64 ) ) );
-    std::complex<double> bJt[bsize] __attribute__( ( aligned( 64 ) ) );
+    // Real and imaginary parts of the modes are deposited in separate buffers
+    double bJl_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJl_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJr_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJr_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJt_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJt_im[bsize] __attribute__( ( aligned( 64 ) ) );
 
     double Sl0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
     double Sr0_buff_vect[32] __attribute__( ( aligned( 64 ) ) );
@@ -480,6 +493,12 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
     double DSr[40] __attribute__( ( aligned( 64 ) ) );
     double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
     double r_bar[8] __attribute__( ( aligned( 64 ) ) );
+    // Powers of exp(i theta_bar) and exp(i delta_theta/2) for all modes (mode 1 is always needed by Jt)
+    int nfactors = vecSize*max( Nmode_, 2u );
+    double e_bar_re[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_bar_im[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_delta_re[nfactors] __attribute__( ( aligned( 64 ) ) );
+    double e_delta_im[nfactors] __attribute__( ( aligned( 64 ) ) );
     complex<double> * __restrict__ Jl;
     complex<double> * __restrict__ Jr;
     complex<double> * __restrict__ Jt;
@@ -499,9 +518,12 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
 
     #pragma omp simd
     for( unsigned int j=0; j<200*Nmode_; j++ ) {
-        bJl[j] = 0.;
-        bJr[j] = 0.;
-        bJt[j] = 0.;
+        bJl_re[j] = 0.;
+        bJl_im[j] = 0.;
+        bJr_re[j] = 0.;
+        bJr_im[j] = 0.;
+        bJt_re[j] = 0.;
+        bJt_im[j] = 0.;
     }
 
     // Closest multiple of 8 higher or equal than npart = iend-istart.
@@ -511,27 +533,26 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
 
         int np_computed = min( cell_nparts-ivect, vecSize );
         int istart0 = ( int )istart + ivect;
-        complex<double> e_bar[8], e_delta_m1[8];
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            compute_distances( position_x, position_y, position_z, cell_keys, npart_total, ipart, istart0, ipart_ref, deltaold, array_eitheta_old, iold, Sl0_buff_vect, Sr0_buff_vect, DSl, DSr, r_bar, e_bar, e_delta_m1 );
+            compute_distances( position_x, position_y, position_z, cell_keys, npart_total, ipart, istart0, ipart_ref, deltaold, array_eitheta_old, iold, Sl0_buff_vect, Sr0_buff_vect, DSl, DSr, r_bar, e_bar_re, e_bar_im, e_delta_re, e_delta_im );
             charge_weight[ipart] = inv_cell_volume * ( double )( charge[istart0+ipart] )*weight[istart0+ipart];
         }
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            computeJl( ipart, charge_weight, DSl, DSr, Sr0_buff_vect, bJl, dl_ov_dt_, invR_local, e_bar);
+            computeJl( ipart, charge_weight, DSl, DSr, Sr0_buff_vect, bJl_re, bJl_im, dl_ov_dt_, invR_local, e_bar_re, e_bar_im );
         }
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            computeJr( ipart, charge_weight, DSl, DSr, Sl0_buff_vect, bJr, one_ov_dt, invRd_local, e_bar, jpom2);
+            computeJr( ipart, charge_weight, DSl, DSr, Sl0_buff_vect, bJr_re, bJr_im, one_ov_dt, invRd_local, e_bar_re, e_bar_im, jpom2 );
         }
 
         #pragma omp simd
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
-            computeJt( ipart, &momentum_y[istart0], &momentum_z[istart0], charge_weight, &invgf[istart0-ipart_ref], DSl, DSr, Sl0_buff_vect, Sr0_buff_vect, bJt, invR_local, r_bar, e_bar, e_delta_m1, one_ov_dt);
+            computeJt( ipart, &momentum_y[istart0], &momentum_z[istart0], charge_weight, &invgf[istart0-ipart_ref], DSl, DSr, Sl0_buff_vect, Sr0_buff_vect, bJt_re, bJt_im, invR_local, r_bar, e_bar_re, e_bar_im, e_delta_re, e_delta_im, one_ov_dt );
         }
     } //End ivect
 
@@ -550,13 +571,14 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
             iloc += nprimr_;
             #pragma omp simd
             for( unsigned int j=0 ; j<5 ; j++ ) {
-                complex<double> tmpJl( 0. );
+                double tmpJl_re( 0. ), tmpJl_im( 0. );
                 int ilocal = ( i*5+j )*vecSize;
                 UNROLL(8)
                 for( int ipart=0 ; ipart<8; ipart++ ) {
-                    tmpJl += bJl [200*imode + ilocal+ipart];
+                    tmpJl_re += bJl_re [200*imode + ilocal+ipart];
+                    tmpJl_im += bJl_im [200*imode + ilocal+ipart];
                 }
-                Jl[iloc+j] += tmpJl;
+                Jl[iloc+j] += complex<double>( tmpJl_re, tmpJl_im );
             }
         }
     }
@@ -575,13 +597,14 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
         for( unsigned int i=0 ; i<5 ; i++ ) {
             #pragma omp simd
             for( unsigned int j=0 ; j<4 ; j++ ) {
-                complex<double> tmpJr( 0. );
+                double tmpJr_re( 0. ), tmpJr_im( 0. );
                 int ilocal = ( i*5+j+1 )*vecSize;
                 UNROLL(8)
                 for( int ipart=0 ; ipart<8; ipart++ ) {
-                    tmpJr += bJr [200*imode + ilocal+ipart];
+                    tmpJr_re += bJr_re [200*imode + ilocal+ipart];
+                    tmpJr_im += bJr_im [200*imode + ilocal+ipart];
                 }
-                Jr[iloc+j] += tmpJr;
+                Jr[iloc+j] += complex<double>( tmpJr_re, tmpJr_im );
             }
             iloc += nprimr_+1;
         }
@@ -599,13 +622,14 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
         for( unsigned int i=0 ; i<5 ; i++ ) {
             #pragma omp simd
             for( unsigned int j=0 ; j<5 ; j++ ) {
-                complex<double> tmpJt( 0. );
+                double tmpJt_re( 0. ), tmpJt_im( 0. );
                 int ilocal = ( i*5+j )*vecSize;
                 UNROLL(8)
                 for( int ipart=0 ; ipart<8; ipart++ ) {
-                    tmpJt += bJt [200*imode + ilocal+ipart];
+                    tmpJt_re += bJt_re [200*imode + ilocal+ipart];
+                    tmpJt_im += bJt_im [200*imode + ilocal+ipart];
                 }
-                Jt[iloc+j] += tmpJt;
+                Jt[iloc+j] += complex<double>( tmpJt_re, tmpJt_im );
             }
             iloc += nprimr_;
         }
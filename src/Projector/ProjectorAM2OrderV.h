@@ -56,7 +56,7 @@ private:
                                                                    int npart_total, int ipart, int istart, int ipart_ref,
                                                                    double *deltaold, std::complex<double> *array_eitheta_old, int *iold,
                                                                    double *Sl0, double *Sr0, double *DSl, double *DSr,
-                                                                   double *r_bar, std::complex<double> *e_bar, std::complex<double> *e_delta_m1)
+                                                                   double *r_bar, double *e_bar_re, double *e_bar_im, double *e_delta_re, double *e_delta_im)
     {
 
         int ipo = iold[0];
@@ -119,17 +119,38 @@ private:
 
         r_bar[ipart] = ((jpo + j_domain_begin_ + deltaold[istart+ipart-ipart_ref+npart_total])*dr + rp) * 0.5; // r at t = t0 - dt/2
         std::complex<double> eitheta = ( position_y[istart+ipart] + Icpx * position_z[istart+ipart] ) / rp ; //exp(i theta)
-        e_delta_m1[ipart] = std::sqrt(eitheta * (2.*std::real(array_eitheta_old[istart+ipart-ipart_ref]) - array_eitheta_old[istart+ipart-ipart_ref]));
-        e_bar[ipart] = array_eitheta_old[istart+ipart-ipart_ref] * e_delta_m1[ipart];
+        std::complex<double> e_delta_m1 = std::sqrt(eitheta * (2.*std::real(array_eitheta_old[istart+ipart-ipart_ref]) - array_eitheta_old[istart+ipart-ipart_ref]));
+        std::complex<double> e_bar_m1 = array_eitheta_old[istart+ipart-ipart_ref] * e_delta_m1;
+
+        // Powers m of e_bar and e_delta for all modes, stored as separate real and imaginary parts ([imode*vecSize+ipart])
+        // so that the deposition is done in real arithmetic. Mode 1 is always computed: Jt of mode 0 needs it.
+        double e_bar_m1_re = std::real( e_bar_m1 );
+        double e_bar_m1_im = std::imag( e_bar_m1 );
+        double e_delta_m1_re = std::real( e_delta_m1 );
+        double e_delta_m1_im = std::imag( e_delta_m1 );
+        e_bar_re  [ipart] = 1.;
+        e_bar_im  [ipart] = 0.;
+        e_delta_re[ipart] = 1.;
+        e_delta_im[ipart] = 0.;
+        e_bar_re  [vecSize+ipart] = e_bar_m1_re;
+        e_bar_im  [vecSize+ipart] = e_bar_m1_im;
+        e_delta_re[vecSize+ipart] = e_delta_m1_re;
+        e_delta_im[vecSize+ipart] = e_delta_m1_im;
+        for( unsigned int imode=2; imode<Nmode_; imode++ ) {
+            int k = imode*vecSize+ipart;
+            e_bar_re  [k] = e_bar_re  [k-vecSize]*e_bar_m1_re   - e_bar_im  [k-vecSize]*e_bar_m1_im;
+            e_bar_im  [k] = e_bar_re  [k-vecSize]*e_bar_m1_im   + e_bar_im  [k-vecSize]*e_bar_m1_re;
+            e_delta_re[k] = e_delta_re[k-vecSize]*e_delta_m1_re - e_delta_im[k-vecSize]*e_delta_m1_im;
+            e_delta_im[k] = e_delta_re[k-vecSize]*e_delta_m1_im + e_delta_im[k-vecSize]*e_delta_m1_re;
+        }
 
     }
 
-    inline void __attribute__((always_inline)) computeJl( int ipart, double *charge_weight, double *DSl, double *DSr, double *Sr0, std::complex<double> *bJ, double, double *invR_local, std::complex<double> *e_bar )
+    inline void __attribute__((always_inline)) computeJl( int ipart, double *charge_weight, double *DSl, double *DSr, double *Sr0, double *bJ_re, double *bJ_im, double, double *invR_local, double *e_bar_re, double *e_bar_im )
     {
 
         int vecSize = 8;
         double sum[5];
-        std::complex<double> C_m =2.;
         double crl_p = charge_weight[ipart]*dl_ov_dt_;
         
         sum[0] = 0.;
@@ -142,41 +163,43 @@ private:
         double tmp = crl_p * ( 0.5*DSr[ipart] ) * invR_local[0] ;
         UNROLL_S(4)
         for( unsigned int i=1 ; i<5 ; i++ ) {
-            bJ [( i*5 )*vecSize+ipart] += sum[i] * tmp;
+            bJ_re [( i*5 )*vecSize+ipart] += sum[i] * tmp;
         }
         UNROLL_S(4)
         for ( unsigned int j=1; j<5 ; j++ ) {
             tmp =  crl_p * ( Sr0[(j-1)*vecSize+ipart] + 0.5*DSr[j*vecSize+ipart] ) * invR_local[j];
             UNROLL_S(4)
             for( unsigned int i=1 ; i<5 ; i++ ) {
-                bJ [(i*5+j )*vecSize+ipart] += sum[i] * tmp;
+                bJ_re [(i*5+j )*vecSize+ipart] += sum[i] * tmp;
             }
         }
-        //mode > 0
+        //mode > 0, C_m = 2 e_bar^m
         for (unsigned int imode=1; imode<Nmode_; imode++){ 
-            C_m *= e_bar[ipart];
+            double C_m_re = 2.*e_bar_re[imode*vecSize+ipart];
+            double C_m_im = 2.*e_bar_im[imode*vecSize+ipart];
             tmp = crl_p * ( 0.5*DSr[ipart] ) * invR_local[0] ;
             UNROLL_S(4)
             for( unsigned int i=1 ; i<5 ; i++ ) {
-                bJ [200*imode + (i*5 )*vecSize+ipart] += sum[i] * tmp * C_m;
+                bJ_re [200*imode + (i*5 )*vecSize+ipart] += sum[i] * tmp * C_m_re;
+                bJ_im [200*imode + (i*5 )*vecSize+ipart] += sum[i] * tmp * C_m_im;
             }
             UNROLL_S(4)
             for ( unsigned int j=1; j<5 ; j++ ) {
                 tmp =  crl_p * ( Sr0[(j-1)*vecSize+ipart] + 0.5*DSr[j*vecSize+ipart] ) * invR_local[j];
                 UNROLL_S(4)
                 for( unsigned int i=1 ; i<5 ; i++ ) {
-                    bJ [200*imode + (i*5+j )*vecSize+ipart] += sum[i] * tmp * C_m;
+                    bJ_re [200*imode + (i*5+j )*vecSize+ipart] += sum[i] * tmp * C_m_re;
+                    bJ_im [200*imode + (i*5+j )*vecSize+ipart] += sum[i] * tmp * C_m_im;
                 }
             }
         }
     }
 
-    inline void __attribute__((always_inline)) computeJr( int ipart, double *charge_weight, double *DSl, double *DSr, double *Sl0, std::complex<double> *bJ, double one_ov_dt, double *invRd_local, std::complex<double> *e_bar, int jpo )
+    inline void __attribute__((always_inline)) computeJr( int ipart, double *charge_weight, double *DSl, double *DSr, double *Sl0, double *bJ_re, double *bJ_im, double one_ov_dt, double *invRd_local, double *e_bar_re, double *e_bar_im, int jpo )
     {
 
         int vecSize = 8;
         double sum[5];
-        std::complex<double> C_m =2.;
         double crr_p = charge_weight[ipart]*one_ov_dt;
         
         sum[4] = 0.;
@@ -189,31 +212,34 @@ private:
         double tmp = 0.5*DSl[ipart];
         UNROLL_S(4)
         for( unsigned int j=0 ; j<4 ; j++ ) {
-            bJ [( j+1 )*vecSize+ipart] += sum[j] * tmp;
+            bJ_re [( j+1 )*vecSize+ipart] += sum[j] * tmp;
         }
         UNROLL_S(4)
         for ( unsigned int i=1; i<5 ; i++ ) {
             tmp = Sl0[(i-1)*vecSize + ipart] + 0.5*DSl[i*vecSize + ipart];
             UNROLL_S(4)
             for( unsigned int j=0 ; j<4 ; j++ ) {
-                bJ [(i*5+j+1 )*vecSize + ipart] += sum[j] * tmp;
+                bJ_re [(i*5+j+1 )*vecSize + ipart] += sum[j] * tmp;
             }
         }
 
-        //mode > 0
+        //mode > 0, C_m = 2 e_bar^m
         for (unsigned int imode=1; imode<Nmode_; imode++){ 
-            C_m *= e_bar[ipart];
+            double C_m_re = 2.*e_bar_re[imode*vecSize+ipart];
+            double C_m_im = 2.*e_bar_im[imode*vecSize+ipart];
             tmp = 0.5*DSl[ipart];
             UNROLL_S(4)
             for( unsigned int j=0 ; j<4 ; j++ ) {
-                bJ [200*imode + ( j+1 )*vecSize+ipart] += sum[j] * tmp * C_m;
+                bJ_re [200*imode + ( j+1 )*vecSize+ipart] += sum[j] * tmp * C_m_re;
+                bJ_im [200*imode + ( j+1 )*vecSize+ipart] += sum[j] * tmp * C_m_im;
             }
             UNROLL_S(4)
             for ( unsigned int i=1; i<5 ; i++ ) {
                 tmp = Sl0[(i-1)*vecSize + ipart] + 0.5*DSl[i*vecSize + ipart];
                 UNROLL_S(4)
                 for( unsigned int j=0 ; j<4 ; j++ ) {
-                    bJ [200*imode + (i*5+j+1 )*vecSize + ipart] += sum[j] * tmp * C_m;
+                    bJ_re [200*imode + (i*5+j+1 )*vecSize + ipart] += sum[j] * tmp * C_m_re;
+                    bJ_im [200*imode + (i*5+j+1 )*vecSize + ipart] += sum[j] * tmp * C_m_im;
                 }
             }
         }
@@ -225,7 +251,8 @@ private:
                                                                    double *charge_weight,
                                                                    double *invgf,
                                                                    double *DSl, double *DSr, double *Sl0_buff_vect, double *Sr0_buff_vect,
-                                                                   std::complex<double> *bJ, double *invR_local, double *r_bar, std::complex<double> *e_bar_m1, std::complex<double> *e_delta_m1, 
+                                                                   double *bJ_re, double *bJ_im, double *invR_local, double *r_bar,
+                                                                   double *e_bar_re, double *e_bar_im, double *e_delta_re, double *e_delta_im,
                                                                    double one_ov_dt)
     {
 
@@ -252,28 +279,40 @@ private:
         Sr0_buff_vect[1*vecSize + ipart] *= invR_local[2];
         Sr0_buff_vect[2*vecSize + ipart] *= invR_local[3];
 
-        //mode 0
-        std::complex<double> crt_p= charge_weight[ipart]*( momentum_z[ipart]* real(e_bar_m1[ipart]) - momentum_y[ipart]*imag(e_bar_m1[ipart]) ) * invgf[ipart];
-        std::complex<double> e_delta = 0.5;
-        std::complex<double> e_bar = 1.;
-
-
+        // bJ -= crt_p * ( S1*(e_delta-1) - S0*(conj(e_delta)-1) ), written in real arithmetic:
+        // with e_delta-1 = ed_re + i ed_im, the bracket is (S1-S0)*ed_re + i (S1+S0)*ed_im
         for (unsigned int imode=0; imode<Nmode_; imode++){ 
-            if (imode > 0){
-                e_delta *= e_delta_m1[ipart];
-                e_bar *= e_bar_m1[ipart];
-                crt_p = charge_weight[ipart]*Icpx*e_bar * one_ov_dt * 2. * r_bar[ipart] /( double )imode ;
+            double crt_re, crt_im, ed_re, ed_im;
+            if (imode == 0){
+                //mode 0: crt_p is real and e_delta = 0.5
+                crt_re = charge_weight[ipart]*( momentum_z[ipart]* e_bar_re[vecSize+ipart] - momentum_y[ipart]*e_bar_im[vecSize+ipart] ) * invgf[ipart];
+                crt_im = 0.;
+                ed_re = -0.5;
+                ed_im = 0.;
+            } else {
+                //crt_p = i e_bar^m * charge_weight * 2 r_bar / (m dt)
+                double crt = charge_weight[ipart] * one_ov_dt * 2. * r_bar[ipart] /( double )imode ;
+                crt_re = -crt * e_bar_im[imode*vecSize+ipart];
+                crt_im =  crt * e_bar_re[imode*vecSize+ipart];
+                ed_re = e_delta_re[imode*vecSize+ipart] - 1.;
+                ed_im = e_delta_im[imode*vecSize+ipart];
             }
 
             //j=0 case
             UNROLL_S(5)
             for( unsigned int i=0 ; i<5 ; i++ ) {
-                bJ [200*imode + (i*5 )*vecSize + ipart] -= crt_p*(Sr1[0]*Sl1[i]*( e_delta-1. ) );
+                double t_re = Sr1[0]*Sl1[i]*ed_re;
+                double t_im = Sr1[0]*Sl1[i]*ed_im;
+                bJ_re [200*imode + (i*5 )*vecSize + ipart] -= crt_re*t_re - crt_im*t_im;
+                bJ_im [200*imode + (i*5 )*vecSize + ipart] -= crt_re*t_im + crt_im*t_re;
             }
             //i=0 case
             UNROLL_S(4)
             for( unsigned int j=1 ; j<5 ; j++ ) {
-                bJ [200*imode + (j)*vecSize + ipart] -= crt_p*(Sr1[j]*Sl1[0]*( e_delta-1. ) );
+                double t_re = Sr1[j]*Sl1[0]*ed_re;
+                double t_im = Sr1[j]*Sl1[0]*ed_im;
+                bJ_re [200*imode + (j)*vecSize + ipart] -= crt_re*t_re - crt_im*t_im;
+                bJ_im [200*imode + (j)*vecSize + ipart] -= crt_re*t_im + crt_im*t_re;
             }
 
 
@@ -281,18 +320,21 @@ private:
             for( unsigned int i=1 ; i<5 ; i++ ) {
                 UNROLL_S(4)
                 for ( unsigned int j=1; j<5 ; j++ ) {
-                    bJ [200*imode + (i*5+j )*vecSize + ipart] -= crt_p*(Sr1[j]*Sl1[i]*( e_delta-1. ) - Sr0_buff_vect[(j-1)*vecSize + ipart]*Sl0_buff_vect[(i-1)*vecSize + ipart]*(std::conj(e_delta) - 1.));
+                    double S1 = Sr1[j]*Sl1[i];
+                    double S0 = Sr0_buff_vect[(j-1)*vecSize + ipart]*Sl0_buff_vect[(i-1)*vecSize + ipart];
+                    double t_re = ( S1 - S0 )*ed_re;
+                    double t_im = ( S1 + S0 )*ed_im;
+                    bJ_re [200*imode + (i*5+j )*vecSize + ipart] -= crt_re*t_re - crt_im*t_im;
+                    bJ_im [200*imode + (i*5+j )*vecSize + ipart] -= crt_re*t_im + crt_im*t_re;
                 }
             }
-
-            if (imode == 0) e_delta = 1. ; //Restore e_delta correct initial value.
        }
     }
 
     inline void __attribute__((always_inline)) computeRho( int ipart, 
                                                                    double *charge_weight,
                                                                    double *DSl, double *DSr, double *Sl0_buff_vect, double *Sr0_buff_vect,
-                                                                   std::complex<double> *brho, double *invR_local, std::complex<double> *e_bar_m1) 
+                                                                   double *brho_re, double *brho_im, double *invR_local, double *e_bar_re, double *e_bar_im) 
     {
 
         int vecSize = 8;
@@ -319,20 +361,26 @@ private:
         Sr0_buff_vect[2*vecSize + ipart] *= invR_local[3];
 
         //mode 0
-        std::complex<double> C_m = 1.;
-        std::complex<double> e_bar = 1.;
-
-        for (unsigned int imode=0; imode<Nmode_; imode++){ 
-            if (imode > 0){
-                e_bar *= e_bar_m1[ipart];
-                C_m = 2. * e_bar;
+        UNROLL_S(5)
+        for( unsigned int i=0 ; i<5 ; i++ ) {
+            UNROLL_S(5)
+            for ( unsigned int j=0; j<5 ; j++ ) {
+                brho_re [(i*5+j )*vecSize + ipart] += charge_weight[ipart]*(Sr1[j]*Sl1[i]);
             }
+        }
+
+        //mode > 0, C_m = 2 e_bar^m
+        for (unsigned int imode=1; imode<Nmode_; imode++){ 
+            double C_m_re = 2.*e_bar_re[imode*vecSize+ipart];
+            double C_m_im = 2.*e_bar_im[imode*vecSize+ipart];
 
             UNROLL_S(5)
             for( unsigned int i=0 ; i<5 ; i++ ) {
                 UNROLL_S(5)
                 for ( unsigned int j=0; j<5 ; j++ ) {
-                    brho [200*imode + (i*5+j )*vecSize + ipart] += C_m * charge_weight[ipart]*(Sr1[j]*Sl1[i]);
+                    double rho = charge_weight[ipart]*(Sr1[j]*Sl1[i]);
+                    brho_re [200*imode + (i*5+j )*vecSize + ipart] += C_m_re * rho;
+                    brho_im [200*imode + (i*5+j )*vecSize + ipart] += C_m_im * rho;
                 }
             }
        }
@@ -52,25 +52,27 @@ def _smilei_check():
     if len(Checkpoints)==1 and Checkpoints.restart_dir:
         if len(Checkpoints.restart_files) == 0 :
             Checkpoints.restart = True
-            pattern = Checkpoints.restart_dir + os.sep + "checkpoints" + os.sep
-            if Checkpoints.file_grouping:
-                pattern += "*"+ os.sep
-            pattern += "dump-*-*.h5"
-            # pick those file that match the mpi rank
-            files = filter(lambda a: smilei_mpi_rank==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), glob(pattern))
-            
-            if Checkpoints.restart_number is not None:
-                # pick those file that match the restart_number
-                files = filter(lambda a: Checkpoints.restart_number==int(search(r'dump-([0-9]*)-[0-9]*.h5$',a).groups()[-1]), files)
-            
-            Checkpoints.restart_files = list(files)
-            
-            if len(Checkpoints.restart_files) == 0:
-                raise Exception(
-                "ERROR in the namelist: cannot find valid restart files for processor "+str(smilei_mpi_rank) +
-                "\n\t\trestart_dir = '" + Checkpoints.restart_dir +
-                "'\n\t\trestart_number = " + str(Checkpoints.restart_number) +
-                "\n\t\tmatching pattern: '" + pattern + "'" )
+            # only the master looks for the files, then sends them to the other MPI processes
+            if smilei_mpi_rank == 0:
+                pattern = Checkpoints.restart_dir + os.sep + "checkpoints" + os.sep
+                if Checkpoints.file_grouping:
+                    pattern += "*"+ os.sep
+                pattern += "dump-*-*.h5"
+                # keep the files of all MPI processes: the number of processes may differ from the previous run
+                files = glob(pattern)
+                
+                if Checkpoints.restart_number is not None:
+                    # pick those file that match the restart_number
+                    files = filter(lambda a: Checkpoints.restart_number==int(search(r'dump-([0-9]*)-[0-9]*.h5$',a).groups()[-1]), files)
+                
+                Checkpoints.restart_files = list(files)
+                
+                if len(Checkpoints.restart_files) == 0:
+                    raise Exception(
+                    "ERROR in the namelist: cannot find valid restart files" +
+                    "\n\t\trestart_dir = '" + Checkpoints.restart_dir +
+                    "'\n\t\trestart_number = " + str(Checkpoints.restart_number) +
+                    "\n\t\tmatching pattern: '" + pattern + "'" )
             
         else :
             raise Exception("restart_dir and restart_files are both not empty")
@@ -167,8 +167,13 @@ class Main(SmileiSingleton):
     interpolation_order = 2
     interpolator = "momentum-conserving"
     custom_oversize = 2
+    exchange_fields_each = 1
+    skip_quiescent_patches = False
+    temporal_blocking = False
     number_of_patches = None
     patch_arrangement = "hilbertian"
+    node_aware_exchange = False
+    node_aware_mapping_tolerance = 0.
     cluster_width = -1
     every_clean_particles_overhead = 100
     timestep = None
@@ -181,6 +186,7 @@ class Main(SmileiSingleton):
     
     # PXR tuning
     spectral_solver_order = []
+    galilean_velocity = [0., 0., 0.]
     initial_rotational_cleaning = False
 
     # Poisson tuning
@@ -192,6 +198,10 @@ class Main(SmileiSingleton):
     solve_relativistic_poisson = False
     relativistic_poisson_max_iteration = 50000
     relativistic_poisson_max_error = 1.e-22
+
+    # Poisson algorithm
+    poisson_solver = "CG"
+    poisson_chebyshev_degree = 4
     
     # BTIS3 interpolator
     use_BTIS3_interpolation = False
@@ -222,6 +232,8 @@ class Main(SmileiSingleton):
     print_every = None
     random_seed = None
     print_expected_disk_usage = True
+    async_diagnostics_buffer = 0.
+    subfiling = 0
 
     terminal_mode = True
 
@@ -344,6 +356,7 @@ class Vectorization(SmileiSingleton):
     mode                = "off"
     reconfigure_every   = 20
     initial_mode        = "off"
+    calibration_file    = ""
 
 
 class MovingWindow(SmileiSingleton):
@@ -373,6 +386,7 @@ class CurrentFilter(SmileiSingleton):
     model = "binomial"
     passes = [0]
     kernelFIR = [0.25,0.5,0.25]
+    passes_per_exchange = 1
 
 class FieldFilter(SmileiSingleton):
     """Fields filtering parameters"""
@@ -421,6 +435,14 @@ class Species(SmileiComponent):
     merge_discretization_scale = "linear"
     merge_min_momentum = 1e-5
 
+    # Particle splitting species Parameters
+    splitting_method = "none"
+    split_every = 0
+    split_target_particles_per_cell = 4
+    split_min_weight = 0.
+    split_max_new_particles = 10000
+    split_displacement = 0.
+
     time_frozen = 0.0
     radiating = False
     relativistic_field_initialization = False
@@ -511,6 +533,9 @@ class DiagProbe(SmileiComponent):
     fields = []
     flush_every = 1
     time_integral = False
+    time_average = 1
+    time_reduction = "average"
+    frequencies = []
     datatype = "double"
 
 class DiagParticleBinning(SmileiComponent):
@@ -552,6 +577,7 @@ class DiagScalar(SmileiComponent):
     every = None
     precision = 10
     vars = []
+    flush_every = 1
 
 class DiagFields(SmileiComponent):
     """Field diagnostic"""
@@ -559,6 +585,8 @@ class DiagFields(SmileiComponent):
     every = None
     fields = []
     time_average = 1
+    time_reduction = "average"
+    frequencies = []
     subgrid = None
     flush_every = 1
     datatype = "double"
@@ -571,6 +599,7 @@ class DiagTrackParticles(SmileiComponent):
     flush_every = 1
     filter = None
     attributes = ["x", "y", "z", "px", "py", "pz", "w"]
+    sort_by_id = False
 
 class DiagNewParticles(SmileiComponent):
     """Track diagnostic"""
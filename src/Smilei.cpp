@@ -37,6 +37,7 @@
 #include "DoubleGrids.h"
 #include "DoubleGridsAM.h"
 #include "Timers.h"
+#include "PartCompTimeCalibration.h"
 
 using namespace std;
 
@@ -258,6 +259,7 @@ int main( int argc, char *argv[] )
 
         // Patch reconfiguration for the adaptive vectorization
         if( params.has_adaptive_vectorization ) {
+            PartCompTimeCalibration::calibrate( vecPatches, params, &smpi );
             vecPatches.configuration( params, timers, 0 );
         }
 
@@ -339,6 +341,7 @@ int main( int argc, char *argv[] )
 
         // Patch reconfiguration
         if( params.has_adaptive_vectorization ) {
+            PartCompTimeCalibration::calibrate( vecPatches, params, &smpi );
             vecPatches.configuration( params, timers, 0 );
         }
 
@@ -530,8 +533,11 @@ int main( int argc, char *argv[] )
             // Sum densities
             vecPatches.sumDensities( params, time_dual, timers, itime, simWindow, &smpi );
 
-            // apply currents from antennas
-            vecPatches.applyAntennas( time_dual );
+            // apply currents from antennas (on the region with multiple decomposition,
+            // as overlapping patches would add them several times when summed on the region)
+            if( !params.multiple_decomposition ) {
+                vecPatches.applyAntennas( time_dual );
+            }
 
         } //End omp parallel region
 
@@ -576,6 +582,8 @@ int main( int argc, char *argv[] )
                     }
                 timers.syncDens.update( params.printNow( itime ) );
 
+                // apply currents from antennas
+                region.vecPatch_.applyAntennas( time_dual );
 
                 // apply external time fields if requested
                 if( region.vecPatch_(0)->EMfields->prescribedFields.size() ) {
@@ -611,6 +619,8 @@ int main( int argc, char *argv[] )
                                 SyncVectorPatch::sumRhoJ( params, vecPatches, imode, &smpi );
                             }
                         }
+                        // currents from antennas, for diagnostics
+                        vecPatches.applyAntennas( time_dual );
                     }
                 }
                 else {
@@ -639,6 +649,9 @@ int main( int argc, char *argv[] )
             // Particle merging
             vecPatches.mergeParticles(params, time_dual,timers, itime );
 
+            // Particle splitting
+            vecPatches.splitParticles(params, time_dual,timers, itime );
+
             // Particle injection from the boundaries
             vecPatches.injectParticlesFromBoundaries(params, timers, itime );
 
@@ -14,6 +14,21 @@ AsyncMPIbuffers::AsyncMPIbuffers()
 
 AsyncMPIbuffers::~AsyncMPIbuffers()
 {
+    int finalized;
+    MPI_Finalized( &finalized );
+    if( finalized ) {
+        return;
+    }
+    for( unsigned int iDim=0 ; iDim<persistent_send_.size() ; iDim++ ) {
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( persistent_send_[iDim][iNeighbor].request != MPI_REQUEST_NULL ) {
+                MPI_Request_free( &( persistent_send_[iDim][iNeighbor].request ) );
+            }
+            if( persistent_recv_[iDim][iNeighbor].request != MPI_REQUEST_NULL ) {
+                MPI_Request_free( &( persistent_recv_[iDim][iNeighbor].request ) );
+            }
+        }
+    }
 }
 
 
@@ -32,6 +47,14 @@ void AsyncMPIbuffers::allocate( unsigned int ndims )
         send_tags_[iDim].resize( 2, MPI_PROC_NULL );
         recv_tags_[iDim].resize( 2, MPI_PROC_NULL );
     }
+    
+    PersistentRequest none = { MPI_REQUEST_NULL, NULL, 0, MPI_PROC_NULL, -1 };
+    persistent_send_.resize( ndims );
+    persistent_recv_.resize( ndims );
+    for( unsigned int iDim = 0 ; iDim < ndims ; iDim++ ) {
+        persistent_send_[iDim].resize( 2, none );
+        persistent_recv_[iDim].resize( 2, none );
+    }
 }
 
 void AsyncMPIbuffers::defineTags( Patch *patch, SmileiMPI *smpi, int tag )
@@ -60,6 +83,40 @@ void AsyncMPIbuffers::defineTags( Patch *patch, SmileiMPI *smpi, int tag )
 }
 
 
+void AsyncMPIbuffers::startSend( int iDim, int iNeighbor, double *buffer, int size, int rank, int tag )
+{
+    start( persistent_send_[iDim][iNeighbor], srequest[iDim][iNeighbor], true, buffer, size, rank, tag );
+}
+
+void AsyncMPIbuffers::startRecv( int iDim, int iNeighbor, double *buffer, int size, int rank, int tag )
+{
+    start( persistent_recv_[iDim][iNeighbor], rrequest[iDim][iNeighbor], false, buffer, size, rank, tag );
+}
+
+// The neighborhood of a patch only changes with load balancing and moving window, between these events the same
+// persistent request is restarted. request may have been overwritten by a non persistent communication.
+void AsyncMPIbuffers::start( PersistentRequest &persistent, MPI_Request &request, bool send, double *buffer, int size, int rank, int tag )
+{
+    if( persistent.request == MPI_REQUEST_NULL || persistent.request != request
+        || persistent.buffer != buffer || persistent.size != size || persistent.rank != rank || persistent.tag != tag ) {
+        if( persistent.request != MPI_REQUEST_NULL ) {
+            MPI_Request_free( &( persistent.request ) );
+        }
+        if( send ) {
+            MPI_Send_init( buffer, size, MPI_DOUBLE, rank, tag, MPI_COMM_WORLD, &( persistent.request ) );
+        } else {
+            MPI_Recv_init( buffer, size, MPI_DOUBLE, rank, tag, MPI_COMM_WORLD, &( persistent.request ) );
+        }
+        persistent.buffer = buffer;
+        persistent.size   = size;
+        persistent.rank   = rank;
+        persistent.tag    = tag;
+    }
+    request = persistent.request;
+    MPI_Start( &request );
+}
+
+
 SpeciesMPIbuffers::SpeciesMPIbuffers()
 {
 }
@@ -30,6 +30,24 @@ public:
     
     std::vector< std::vector<int> > send_tags_, recv_tags_;
     
+    //! Start the send of buffer to rank along (iDim, iNeighbor) through a persistent request stored in srequest
+    //! The request is built at the first call and rebuilt only if the buffer, the destination or the tag changed
+    void startSend( int iDim, int iNeighbor, double *buffer, int size, int rank, int tag );
+    //! Start the reception of buffer from rank along (iDim, iNeighbor) through a persistent request stored in rrequest
+    void startRecv( int iDim, int iNeighbor, double *buffer, int size, int rank, int tag );
+    
+private:
+    //! A persistent request and the arguments it has been built with
+    struct PersistentRequest {
+        MPI_Request request;
+        double *buffer;
+        int size;
+        int rank;
+        int tag;
+    };
+    std::vector< std::vector<PersistentRequest> > persistent_send_, persistent_recv_;
+    
+    void start( PersistentRequest &persistent, MPI_Request &request, bool send, double *buffer, int size, int rank, int tag );
 };
 
 class SpeciesMPIbuffers : public AsyncMPIbuffers
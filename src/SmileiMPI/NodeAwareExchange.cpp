@@ -0,0 +1,294 @@
+#include "NodeAwareExchange.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Field.h"
+#include "Patch.h"
+#include "SmileiMPI.h"
+#include "VectorPatch.h"
+#include "Tools.h"
+
+using namespace std;
+
+NodeAwareExchange::NodeAwareExchange() :
+    planned_( false ),
+    iDim_( 0 ),
+    smpi_( NULL ),
+    comm_( MPI_COMM_NULL ),
+    use_shared_memory_( false ),
+    window_( MPI_WIN_NULL ),
+    window_size_( 0 ),
+    segment_( NULL )
+{
+}
+
+
+NodeAwareExchange::~NodeAwareExchange()
+{
+}
+
+
+void NodeAwareExchange::freeRequests()
+{
+    for( unsigned int ireq = 0 ; ireq < requests_.size() ; ireq++ ) {
+        MPI_Request_free( &requests_[ireq] );
+    }
+    requests_.clear();
+}
+
+
+void NodeAwareExchange::clear()
+{
+    freeRequests();
+    if( window_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( window_ );
+        MPI_Win_free( &window_ );
+        window_size_ = 0;
+        segment_ = NULL;
+    }
+    if( comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &comm_ );
+    }
+    planned_ = false;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Build the communication plan
+//     - entries are sorted by (MPI process, direction, component, hindex of the sending patch) so that the sender and
+//       the receiver pack/unpack the sub-fields in the same order without exchanging any metadata
+//     - the shared memory window is reallocated if one of the processes of the node needs a larger segment
+//     - the offsets of the on-node messages in the segment of the senders are sent once to the receivers
+// ---------------------------------------------------------------------------------------------------------------------
+void NodeAwareExchange::buildPlan( vector<Field *> &fields, vector<int> &patch_index, VectorPatch &vecPatches, int iDim, SmileiMPI *smpi )
+{
+    smpi_ = smpi;
+    iDim_ = iDim;
+    use_shared_memory_ = ( smpi->getNodeSize() > 1 );
+    if( comm_ == MPI_COMM_NULL ) {
+        MPI_Comm_dup( smpi->world(), &comm_ );
+    }
+
+    send_entries_.clear();
+    recv_entries_.clear();
+    unsigned int npatch = patch_index.size();
+    for( unsigned int ifield = 0 ; ifield < fields.size() ; ifield++ ) {
+        Patch *patch = vecPatches( patch_index[ifield%npatch] );
+        int icomp = ifield / npatch;
+        for( int iNeighbor = 0 ; iNeighbor < 2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                Entry entry = { patch->MPI_neighbor_[iDim][iNeighbor], iNeighbor, icomp,
+                                patch->hindex, fields[ifield], ( unsigned int )( iDim*2+iNeighbor ) };
+                send_entries_.push_back( entry );
+            }
+            if( patch->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+                Entry entry = { patch->MPI_neighbor_[iDim][( iNeighbor+1 )%2], iNeighbor, icomp,
+                                ( unsigned int )patch->neighbor_[iDim][( iNeighbor+1 )%2], fields[ifield], ( unsigned int )( iDim*2+( iNeighbor+1 )%2 ) };
+                recv_entries_.push_back( entry );
+            }
+        }
+    }
+
+    groupEntries( send_entries_, send_messages_, true, smpi );
+    groupEntries( recv_entries_, recv_messages_, false, smpi );
+
+    // Offsets in the local buffers and in the local shared segment
+    MPI_Aint send_size = 0, segment_size = 0, recv_size = 0;
+    for( unsigned int imsg = 0 ; imsg < send_messages_.size() ; imsg++ ) {
+        Message &message = send_messages_[imsg];
+        if( message.node_rank >= 0 ) {
+            message.offset = segment_size;
+            segment_size += message.size;
+        } else {
+            message.offset = send_size;
+            send_size += message.size;
+        }
+    }
+    for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+        Message &message = recv_messages_[imsg];
+        if( message.node_rank < 0 ) {
+            message.offset = recv_size;
+            recv_size += message.size;
+        }
+    }
+    send_buffer_.resize( send_size );
+    recv_buffer_.resize( recv_size );
+
+    // Off-node messages : persistent requests, valid until the next plan
+    freeRequests();
+    for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+        Message &message = recv_messages_[imsg];
+        if( message.node_rank < 0 ) {
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Recv_init( &recv_buffer_[message.offset], message.size, MPI_DOUBLE, message.rank, 0, comm_, &requests_.back() );
+        }
+    }
+    for( unsigned int imsg = 0 ; imsg < send_messages_.size() ; imsg++ ) {
+        Message &message = send_messages_[imsg];
+        if( message.node_rank < 0 ) {
+            requests_.push_back( MPI_REQUEST_NULL );
+            MPI_Send_init( &send_buffer_[message.offset], message.size, MPI_DOUBLE, message.rank, 0, comm_, &requests_.back() );
+        }
+    }
+
+    if( use_shared_memory_ ) {
+        // Collective over the node : reallocate if any segment is too small
+        int grow = ( segment_size > window_size_ ) ? 1 : 0;
+        MPI_Allreduce( MPI_IN_PLACE, &grow, 1, MPI_INT, MPI_MAX, smpi->node_comm_ );
+        if( grow ) {
+            if( window_ != MPI_WIN_NULL ) {
+                MPI_Win_unlock_all( window_ );
+                MPI_Win_free( &window_ );
+            }
+            // Margin to absorb the fluctuations of the patch distribution
+            window_size_ = max( window_size_, segment_size + segment_size/4 );
+            MPI_Win_allocate_shared( window_size_*sizeof( double ), sizeof( double ), MPI_INFO_NULL,
+                                     smpi->node_comm_, &segment_, &window_ );
+            MPI_Win_lock_all( MPI_MODE_NOCHECK, window_ );
+        }
+
+        // Tell the on-node receivers where their message is
+        vector<MPI_Request> requests;
+        for( unsigned int imsg = 0 ; imsg < send_messages_.size() ; imsg++ ) {
+            Message &message = send_messages_[imsg];
+            if( message.node_rank >= 0 ) {
+                requests.push_back( MPI_REQUEST_NULL );
+                MPI_Isend( &message.offset, 1, MPI_AINT, message.rank, 1, comm_, &requests.back() );
+            }
+        }
+        for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+            Message &message = recv_messages_[imsg];
+            if( message.node_rank >= 0 ) {
+                requests.push_back( MPI_REQUEST_NULL );
+                MPI_Irecv( &message.offset, 1, MPI_AINT, message.rank, 1, comm_, &requests.back() );
+            }
+        }
+        if( requests.size() > 0 ) {
+            MPI_Waitall( requests.size(), &requests[0], MPI_STATUSES_IGNORE );
+        }
+        for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+            Message &message = recv_messages_[imsg];
+            if( message.node_rank >= 0 ) {
+                MPI_Aint size;
+                int disp_unit;
+                MPI_Win_shared_query( window_, message.node_rank, &size, &disp_unit, &message.peer_segment );
+            }
+        }
+    }
+
+    planned_ = true;
+}
+
+
+void NodeAwareExchange::groupEntries( vector<Entry> &entries, vector<Message> &messages, bool send, SmileiMPI *smpi )
+{
+    sort( entries.begin(), entries.end(), []( const Entry &a, const Entry &b ) {
+        if( a.rank      != b.rank ) return a.rank      < b.rank;
+        if( a.iNeighbor != b.iNeighbor ) return a.iNeighbor < b.iNeighbor;
+        if( a.icomp     != b.icomp ) return a.icomp     < b.icomp;
+        return a.hindex < b.hindex;
+    } );
+
+    messages.clear();
+    for( unsigned int ientry = 0 ; ientry < entries.size() ; ientry++ ) {
+        Entry &entry = entries[ientry];
+        if( messages.size() == 0 || messages.back().rank != entry.rank ) {
+            Message message;
+            message.rank         = entry.rank;
+            message.node_rank    = use_shared_memory_ ? smpi->nodeRank( entry.rank ) : -1;
+            message.first_entry  = ientry;
+            message.last_entry   = ientry;
+            message.offset       = 0;
+            message.size         = 0;
+            message.peer_segment = NULL;
+            messages.push_back( message );
+        }
+        Field *sub_field = send ? entry.field->sendFields_[entry.ibuf] : entry.field->recvFields_[entry.ibuf];
+        messages.back().last_entry = ientry+1;
+        messages.back().size      += sub_field->size();
+    }
+}
+
+
+void NodeAwareExchange::pack( Message &message, double *buffer )
+{
+    MPI_Aint offset = 0;
+    for( unsigned int ientry = message.first_entry ; ientry < message.last_entry ; ientry++ ) {
+        Field *sub_field = send_entries_[ientry].field->sendFields_[send_entries_[ientry].ibuf];
+        memcpy( buffer+offset, sub_field->data_, sub_field->size()*sizeof( double ) );
+        offset += sub_field->size();
+    }
+    if( offset != message.size ) {
+        ERROR( "Node aware exchange : size of the sub-fields changed since the communication plan was built" );
+    }
+}
+
+
+void NodeAwareExchange::unpack( Message &message, double *buffer )
+{
+    MPI_Aint offset = 0;
+    for( unsigned int ientry = message.first_entry ; ientry < message.last_entry ; ientry++ ) {
+        Field *sub_field = recv_entries_[ientry].field->recvFields_[recv_entries_[ientry].ibuf];
+        memcpy( sub_field->data_, buffer+offset, sub_field->size()*sizeof( double ) );
+        offset += sub_field->size();
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pack and send all sub-fields, to be called by a single thread once all sub-fields have been extracted
+// ---------------------------------------------------------------------------------------------------------------------
+void NodeAwareExchange::post( vector<Field *> &fields, vector<int> &patch_index, VectorPatch &vecPatches, int iDim, SmileiMPI *smpi )
+{
+    if( !planned_ ) {
+        buildPlan( fields, patch_index, vecPatches, iDim, smpi );
+    }
+
+    for( unsigned int imsg = 0 ; imsg < send_messages_.size() ; imsg++ ) {
+        Message &message = send_messages_[imsg];
+        if( message.node_rank >= 0 ) {
+            pack( message, segment_+message.offset );
+        } else {
+            pack( message, &send_buffer_[message.offset] );
+        }
+    }
+    if( requests_.size() > 0 ) {
+        MPI_Startall( requests_.size(), &requests_[0] );
+    }
+    if( use_shared_memory_ ) {
+        MPI_Win_sync( window_ );
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Read the on-node messages in the segments of the senders, wait for the off-node ones
+// Collective over the node when shared memory is used
+// ---------------------------------------------------------------------------------------------------------------------
+void NodeAwareExchange::finalize()
+{
+    if( use_shared_memory_ ) {
+        // All segments of the node are written
+        MPI_Barrier( smpi_->node_comm_ );
+        MPI_Win_sync( window_ );
+        for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+            Message &message = recv_messages_[imsg];
+            if( message.node_rank >= 0 ) {
+                unpack( message, message.peer_segment+message.offset );
+            }
+        }
+        // All segments of the node are read, they can be overwritten by the next post
+        MPI_Barrier( smpi_->node_comm_ );
+    }
+
+    if( requests_.size() > 0 ) {
+        MPI_Waitall( requests_.size(), &requests_[0], MPI_STATUSES_IGNORE );
+    }
+    for( unsigned int imsg = 0 ; imsg < recv_messages_.size() ; imsg++ ) {
+        Message &message = recv_messages_[imsg];
+        if( message.node_rank < 0 ) {
+            unpack( message, &recv_buffer_[message.offset] );
+        }
+    }
+}
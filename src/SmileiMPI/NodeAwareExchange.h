@@ -0,0 +1,102 @@
+#ifndef NODEAWAREEXCHANGE_H
+#define NODEAWAREEXCHANGE_H
+
+#include <mpi.h>
+#include <vector>
+
+class Field;
+class VectorPatch;
+class SmileiMPI;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class NodeAwareExchange
+//! Exchange the sub-fields (sendFields_/recvFields_) of a list of fields along one direction with one message per
+//! remote MPI process instead of one message per patch and per field.
+//!     - messages to MPI processes of another node are packed in a single buffer per destination
+//!     - messages to MPI processes of the same node are written in a MPI-3 shared memory window and read by the
+//!       destination process
+//! The communication plan is built at the first exchange and must be invalidated each time patches move between
+//! MPI processes (load balancing, moving window).
+//  --------------------------------------------------------------------------------------------------------------------
+class NodeAwareExchange
+{
+public:
+    NodeAwareExchange();
+    ~NodeAwareExchange();
+
+    //! Force the communication plan to be rebuilt at the next exchange
+    inline void invalidate()
+    {
+        planned_ = false;
+    }
+
+    //! Release the MPI resources, collective on all MPI processes
+    void clear();
+
+    //! Pack and send the sendFields_ of all fields along iDim
+    //! \param fields list of fields, fields[i] belongs to the patch patch_index[i%patch_index.size()]
+    void post( std::vector<Field *> &fields, std::vector<int> &patch_index, VectorPatch &vecPatches, int iDim, SmileiMPI *smpi );
+
+    //! Wait for the messages posted by post() and unpack them in the recvFields_ of the fields
+    void finalize();
+
+private:
+    //! One sub-field sent to or received from a patch of another MPI process
+    struct Entry {
+        int rank;
+        int iNeighbor;
+        int icomp;
+        unsigned int hindex;
+        Field *field;
+        unsigned int ibuf;
+    };
+
+    //! All sub-fields exchanged with one MPI process, in the order shared by the sender and the receiver
+    struct Message {
+        int rank;
+        int node_rank;
+        unsigned int first_entry;
+        unsigned int last_entry;
+        //! Offset in the local buffer (off-node) or in the shared segment of the sender (on-node)
+        MPI_Aint offset;
+        MPI_Aint size;
+        //! Address of the shared segment of the sender (on-node receptions only)
+        double *peer_segment;
+    };
+
+    //! Build the send/recv entries and messages, (re)allocate the shared memory window
+    void buildPlan( std::vector<Field *> &fields, std::vector<int> &patch_index, VectorPatch &vecPatches, int iDim, SmileiMPI *smpi );
+
+    //! Release the persistent requests of the off-node messages
+    void freeRequests();
+
+    //! Group sorted entries in messages, sizes are read in the sendFields_ (send) or in the recvFields_
+    void groupEntries( std::vector<Entry> &entries, std::vector<Message> &messages, bool send, SmileiMPI *smpi );
+
+    //! Copy the sub-fields of the message to buffer (pack) or from buffer (unpack)
+    void pack( Message &message, double *buffer );
+    void unpack( Message &message, double *buffer );
+
+    bool planned_;
+    int iDim_;
+    SmileiMPI *smpi_;
+
+    std::vector<Entry> send_entries_, recv_entries_;
+    std::vector<Message> send_messages_, recv_messages_;
+
+    //! Communicator dedicated to this exchange (no tag conflict with the per patch exchanges)
+    MPI_Comm comm_;
+    //! Persistent requests of the off-node messages, started at each post()
+    std::vector<MPI_Request> requests_;
+
+    //! Packed off-node messages
+    std::vector<double> send_buffer_, recv_buffer_;
+
+    //! Shared memory window, the local segment holds the packed on-node messages
+    bool use_shared_memory_;
+    MPI_Win window_;
+    MPI_Aint window_size_;
+    double *segment_;
+};
+
+#endif
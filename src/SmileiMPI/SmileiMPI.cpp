@@ -75,9 +75,64 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
     MPI_Comm_rank( world_, &smilei_rk );
 
     MPI_Allreduce( &number_of_cores, &global_number_of_cores, 1, MPI_INT, MPI_SUM, world_ );
+
+    initNodeTopology();
 } // END SmileiMPI::SmileiMPI
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Identify the MPI processes which share the node of the current process (MPI-3 shared memory domain)
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::initNodeTopology()
+{
+    MPI_Comm_split_type( world_, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &node_comm_ );
+    MPI_Comm_size( node_comm_, &node_sz_ );
+    MPI_Comm_rank( node_comm_, &node_rk_ );
+
+    std::vector<int> world_ranks( node_sz_ );
+    MPI_Allgather( &smilei_rk, 1, MPI_INT, &world_ranks[0], 1, MPI_INT, node_comm_ );
+    node_rank_of_.assign( smilei_sz, -1 );
+    for( int irk = 0 ; irk < node_sz_ ; irk++ ) {
+        node_rank_of_[world_ranks[irk]] = irk;
+    }
+
+    // Node of each MPI process, identified by the rank of its first MPI process
+    int node_id = world_ranks[0];
+    node_id_.resize( smilei_sz );
+    MPI_Allgather( &node_id, 1, MPI_INT, &node_id_[0], 1, MPI_INT, world_ );
+} // END initNodeTopology
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Group the MPI processes which write the same subfile:
+//     - subfiling > 0 : groups of `subfiling` consecutive ranks
+//     - subfiling = -1: one group per node
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::initSubfiling( int subfiling )
+{
+    if( subfiling == 0 ) {
+        return;
+    }
+
+    subfile_of_.resize( smilei_sz );
+    if( subfiling > 0 ) {
+        for( int irk = 0 ; irk < smilei_sz ; irk++ ) {
+            subfile_of_[irk] = irk / subfiling;
+        }
+    } else {
+        // Nodes are numbered in the order of their first rank
+        std::vector<int> nodes( node_id_ );
+        std::sort( nodes.begin(), nodes.end() );
+        nodes.erase( std::unique( nodes.begin(), nodes.end() ), nodes.end() );
+        for( int irk = 0 ; irk < smilei_sz ; irk++ ) {
+            subfile_of_[irk] = std::lower_bound( nodes.begin(), nodes.end(), node_id_[irk] ) - nodes.begin();
+        }
+    }
+
+    MPI_Comm_split( world_, subfile_of_[smilei_rk], smilei_rk, &subfile_comm_ );
+} // END initSubfiling
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // SmileiMPI destructor :
 //     - Call MPI_Finalize
@@ -86,6 +141,13 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    if( node_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &node_comm_ );
+    }
+    if( subfile_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &subfile_comm_ );
+    }
+
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
@@ -143,6 +205,9 @@ void SmileiMPI::init( Params &params, DomainDecomposition *domain_decomposition
         init_patch_count( params, domain_decomposition );
     }
 
+    // Groups of MPI processes sharing output files
+    initSubfiling( params.subfiling );
+
     // Initialize buffers for particles push vectorization
     //     - 1 thread push particles for a unique patch at a given time
     //     - so 1 buffer per thread
@@ -477,6 +542,24 @@ void SmileiMPI::init_patch_count( Params &params, DomainDecomposition *domain_de
         patch_refHindexes[rk] = patch_refHindexes[rk-1] + patch_count[rk-1];
     }
 
+    // Move the boundaries between nodes to reduce the inter-node surface
+    nodeAwareMapping( params, domain_decomposition );
+
+    if( smilei_rk == 0 && params.node_aware_mapping_tolerance > 0. ) {
+        double inter_process, inter_node;
+        computeInterfaceSurface( params, domain_decomposition, inter_process, inter_node );
+        MESSAGE( 1, "Surface of the patches shared by MPI processes: " << inter_process << " cells, by nodes: " << inter_node << " cells" );
+        ofstream fout;
+        fout.open( "patch_load.txt", std::ofstream::out | std::ofstream::app );
+        fout << "Node aware mapping" << endl;
+        for( int irk=0; irk<smilei_sz; irk++ ) {
+            fout << "patch count = " << patch_count[irk]<<endl;
+        }
+        fout << "Inter-process surface = " << inter_process << endl;
+        fout << "Inter-node surface = " << inter_node << endl;
+        fout.close();
+    }
+
 } // END init_patch_count
 
 
@@ -638,18 +721,202 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         patch_refHindexes[rk] = patch_refHindexes[rk-1] + patch_count[rk-1];
     }
 
+    nodeAwareMapping( params, vecpatches.domain_decomposition_ );
+
     //Write patch_load.txt
     if( smilei_rk==0 ) {
         fout << "\tt = " << time_dual << endl;
         for( int irk=0; irk<smilei_sz; irk++ ) {
             fout << " patch_count[" << irk << "] = " << patch_count[irk] << endl;
         }
+        if( params.node_aware_mapping_tolerance > 0. ) {
+            double inter_process, inter_node;
+            computeInterfaceSurface( params, vecpatches.domain_decomposition_, inter_process, inter_node );
+            fout << " inter-process surface = " << inter_process << ", inter-node surface = " << inter_node << endl;
+        }
         fout.close();
     }
 
 } // END recompute_patch_count
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Hindex of the neighbour of the patch at coords along iDim (direction = -1 or +1), -1 at a non periodic boundary
+// ---------------------------------------------------------------------------------------------------------------------
+static int neighbourHindex( Params &params, DomainDecomposition *domain_decomposition, vector<unsigned int> &coords, unsigned int iDim, int direction )
+{
+    vector<int> xcall( coords.begin(), coords.end() );
+    int npatches = params.number_of_patches[iDim];
+    xcall[iDim] += direction;
+    if( xcall[iDim] < 0 || xcall[iDim] >= npatches ) {
+        if( params.EM_BCs[iDim][0] != "periodic" ) {
+            return -1;
+        }
+        xcall[iDim] = ( xcall[iDim] + npatches ) % npatches;
+    }
+    return domain_decomposition->getDomainId( xcall );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Number of cells of a patch face normal to iDim
+// ---------------------------------------------------------------------------------------------------------------------
+static double patchFaceArea( Params &params, unsigned int iDim )
+{
+    double area = 1.;
+    for( unsigned int jDim = 0; jDim < params.nDim_field; jDim++ ) {
+        if( jDim != iDim ) {
+            area *= params.patch_size_[jDim];
+        }
+    }
+    return area;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// True if the MPI processes of each node have consecutive ranks (block placement). Only then consecutive Hilbert
+// segments, which are distributed in the rank order, run on the same node.
+// ---------------------------------------------------------------------------------------------------------------------
+bool SmileiMPI::nodesAreContiguous()
+{
+    for( int rk = 1 ; rk < smilei_sz ; rk++ ) {
+        if( node_id_[rk] != node_id_[rk-1] && node_id_[rk] != rk ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Topology aware mapping of the Hilbert segments :
+//     - segments are distributed in the rank order, so that consecutive segments already run on the same node when
+//       MPI processes are placed by block
+//     - each boundary between two segments owned by different nodes is moved by at most
+//       node_aware_mapping_tolerance*patch_count patches to the position which minimizes the surface of the patch
+//       faces shared by different nodes (inter-node halo exchanges)
+//     - computed redundantly by all MPI processes from the same patch_count, no communication
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::nodeAwareMapping( Params &params, DomainDecomposition *domain_decomposition )
+{
+    if( params.node_aware_mapping_tolerance <= 0. || smilei_sz == 1 ) {
+        return;
+    }
+    if( !nodesAreContiguous() ) {
+        WARNING( "Node aware mapping ignored : MPI processes of a same node do not have consecutive ranks, prefer a block placement" );
+        return;
+    }
+
+    unsigned int nDim = params.nDim_field;
+    for( int rk = 0 ; rk < smilei_sz-1 ; rk++ ) {
+        if( node_id_[rk] == node_id_[rk+1] ) {
+            continue;
+        }
+        int cut = patch_refHindexes[rk+1];
+        int shift = ( int )( params.node_aware_mapping_tolerance * min( patch_count[rk], patch_count[rk+1] ) );
+        // Each process keeps at least one patch
+        int first = max( cut-shift, patch_refHindexes[rk]+1 );
+        int last  = min( cut+shift, patch_refHindexes[rk+1]+patch_count[rk+1]-1 );
+        if( last <= first ) {
+            continue;
+        }
+
+        // Neighbours of the patches which may change of node, and node of the neighbours outside this window
+        unsigned int nwindow = last-first;
+        vector<int> neighbour( nwindow*2*nDim ), neighbour_node( nwindow*2*nDim );
+        for( unsigned int ip = 0 ; ip < nwindow ; ip++ ) {
+            vector<unsigned int> coords = domain_decomposition->getDomainCoordinates( first+ip );
+            for( unsigned int iDim = 0 ; iDim < nDim ; iDim++ ) {
+                for( int iNeighbor = 0 ; iNeighbor < 2 ; iNeighbor++ ) {
+                    int h = neighbourHindex( params, domain_decomposition, coords, iDim, 2*iNeighbor-1 );
+                    unsigned int i = ( ip*nDim+iDim )*2+iNeighbor;
+                    neighbour[i] = h;
+                    neighbour_node[i] = -1;
+                    if( h >= 0 && ( h < first || h >= last ) ) {
+                        int owner = upper_bound( patch_refHindexes.begin(), patch_refHindexes.end(), h ) - patch_refHindexes.begin() - 1;
+                        neighbour_node[i] = node_id_[owner];
+                    }
+                }
+            }
+        }
+
+        // Candidates ordered by distance to the balanced cut, a move must strictly reduce the surface
+        int best_cut = cut;
+        double best_surface = -1.;
+        for( int distance = 0 ; distance <= max( cut-first, last-cut ) ; distance++ ) {
+            for( int sign = -1 ; sign <= 1 ; sign += 2 ) {
+                int candidate = cut + sign*distance;
+                if( candidate < first || candidate > last || ( distance == 0 && sign == 1 ) ) {
+                    continue;
+                }
+                double surface = 0.;
+                for( unsigned int ip = 0 ; ip < nwindow ; ip++ ) {
+                    int node = ( ( int )( first+ip ) < candidate ) ? node_id_[rk] : node_id_[rk+1];
+                    for( unsigned int iDim = 0 ; iDim < nDim ; iDim++ ) {
+                        for( int iNeighbor = 0 ; iNeighbor < 2 ; iNeighbor++ ) {
+                            unsigned int i = ( ip*nDim+iDim )*2+iNeighbor;
+                            int h = neighbour[i];
+                            if( h < 0 ) {
+                                continue;
+                            }
+                            int other_node = neighbour_node[i];
+                            if( h >= first && h < last ) {
+                                // Faces inside the window are counted once
+                                if( h < ( int )( first+ip ) ) {
+                                    continue;
+                                }
+                                other_node = ( h < candidate ) ? node_id_[rk] : node_id_[rk+1];
+                            }
+                            if( other_node != node ) {
+                                surface += patchFaceArea( params, iDim );
+                            }
+                        }
+                    }
+                }
+                if( best_surface < 0. || surface < best_surface ) {
+                    best_surface = surface;
+                    best_cut = candidate;
+                }
+            }
+        }
+
+        patch_count[rk]   += best_cut-cut;
+        patch_count[rk+1] -= best_cut-cut;
+        patch_refHindexes[rk+1] = best_cut;
+    }
+} // END nodeAwareMapping
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Surface (number of cells) of the patch faces shared by different MPI processes, and by different nodes
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::computeInterfaceSurface( Params &params, DomainDecomposition *domain_decomposition, double &inter_process, double &inter_node )
+{
+    inter_process = 0.;
+    inter_node = 0.;
+    int rk = 0;
+    for( int h = 0 ; h < ( int )params.tot_number_of_patches ; h++ ) {
+        while( h >= patch_refHindexes[rk]+patch_count[rk] ) {
+            rk++;
+        }
+        vector<unsigned int> coords = domain_decomposition->getDomainCoordinates( h );
+        for( unsigned int iDim = 0 ; iDim < params.nDim_field ; iDim++ ) {
+            int neighbour = neighbourHindex( params, domain_decomposition, coords, iDim, 1 );
+            if( neighbour < 0 ) {
+                continue;
+            }
+            int owner = upper_bound( patch_refHindexes.begin(), patch_refHindexes.end(), neighbour ) - patch_refHindexes.begin() - 1;
+            if( owner != rk ) {
+                inter_process += patchFaceArea( params, iDim );
+                if( node_id_[owner] != node_id_[rk] ) {
+                    inter_node += patchFaceArea( params, iDim );
+                }
+            }
+        }
+    }
+} // END computeInterfaceSurface
+
+
 // ----------------------------------------------------------------------
 // Returns the rank of the MPI process currently owning patch h.
 // ----------------------------------------------------------------------
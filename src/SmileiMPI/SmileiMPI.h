@@ -36,6 +36,7 @@ class SmileiMPI
     friend class VectorPatch;
     friend class SimWindow;
     friend class AsyncMPIbuffers;
+    friend class NodeAwareExchange;
 
 public:
     SmileiMPI() {};
@@ -61,6 +62,13 @@ public:
     // Returns the rank of the MPI process currently owning patch h.
     int hrank( int h );
 
+    //! Move the boundaries of the Hilbert segments between two nodes to reduce the inter-node surface
+    void nodeAwareMapping( Params &params, DomainDecomposition *domain_decomposition );
+    //! Surface (number of cells) of the patch faces shared by different MPI processes, and by different nodes
+    void computeInterfaceSurface( Params &params, DomainDecomposition *domain_decomposition, double &inter_process, double &inter_node );
+    //! True if the MPI processes of each node have consecutive ranks
+    bool nodesAreContiguous();
+
     // Create MPI type to exchange all particles properties of particles
     MPI_Datatype createMPIparticles( Particles *particles );
 
@@ -179,6 +187,43 @@ public:
         return world_;
     }
 
+    //! Return the number of MPI processes sharing the node of the current process
+    inline int getNodeSize()
+    {
+        return node_sz_;
+    }
+    //! Return the rank in node_comm_ of the MPI process world_rank (-1 if it runs on another node)
+    inline int nodeRank( int world_rank )
+    {
+        return node_rank_of_[world_rank];
+    }
+    //! Return true if the MPI process world_rank runs on the node of the current process
+    inline bool isOnSameNode( int world_rank )
+    {
+        return ( node_rank_of_[world_rank] >= 0 );
+    }
+
+    //! Return true if the output files are split in subfiles
+    inline bool hasSubfiles()
+    {
+        return subfile_comm_ != MPI_COMM_NULL;
+    }
+    //! Return the communicator of the MPI processes writing the subfile of the current process
+    inline MPI_Comm& subfileComm()
+    {
+        return subfile_comm_;
+    }
+    //! Return the index of the subfile of the MPI process world_rank
+    inline int subfileOf( int world_rank )
+    {
+        return subfile_of_[world_rank];
+    }
+    //! Return the index of the subfile of the current process
+    inline int subfileIndex()
+    {
+        return subfile_of_[smilei_rk];
+    }
+
     //! Return omp_max_threads
     inline int getOMPMaxThreads()
     {
@@ -412,6 +457,26 @@ protected:
     int smilei_sz;
     //! MPI process Id in the current communicator
     int smilei_rk;
+
+    //! Communicator of the MPI processes which can share memory with the current process
+    MPI_Comm node_comm_ = MPI_COMM_NULL;
+    //! Number of MPI process in node_comm_
+    int node_sz_ = 1;
+    //! MPI process Id in node_comm_
+    int node_rk_ = 0;
+    //! Rank in node_comm_ of each MPI process of world_ (-1 if on another node)
+    std::vector<int> node_rank_of_;
+    //! Node of each MPI process of world_, identified by the smallest rank of its MPI processes
+    std::vector<int> node_id_;
+    //! Build node_comm_, node_rank_of_ and node_id_
+    void initNodeTopology();
+
+    //! Communicator of the MPI processes writing the same subfile (MPI_COMM_NULL without subfiling)
+    MPI_Comm subfile_comm_ = MPI_COMM_NULL;
+    //! Subfile of each MPI process of world_
+    std::vector<int> subfile_of_;
+    //! Build subfile_comm_ and subfile_of_ from the `subfiling` parameter
+    void initSubfiling( int subfiling );
     //! OMP max number of threads in one MPI
     int smilei_omp_max_threads;
     //! OMP available cores in one MPI
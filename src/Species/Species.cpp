@@ -19,6 +19,7 @@
 #include "InterpolatorFactory.h"
 #include "IonizationFactory.h"
 #include "MergingFactory.h"
+#include "SplittingFactory.h"
 #include "MultiphotonBreitWheelerFactory.h"
 #include "PartBoundCond.h"
 #include "PartCompTimeFactory.h"
@@ -86,7 +87,8 @@ Species::Species( Params &params, Patch *patch ) :
     tracking_diagnostic( 10000 ),
     nDim_particle( params.nDim_particle ),
     nDim_field(    params.nDim_field  ),
-    merging_time_selection_( 0 )
+    merging_time_selection_( 0 ),
+    splitting_time_selection_( 0 )
 {
     // &particles_sorted[0]
     particles         = ParticlesFactory::create( params, *patch );
@@ -95,6 +97,7 @@ Species::Species( Params &params, Patch *patch ) :
     partBoundCond = NULL;
     min_loc = patch->getDomainLocalMin( 0 );
     merging_method_ = "none";
+    splitting_method_ = "none";
 
     PI2 = 2.0 * M_PI;
     PI_ov_2 = 0.5*M_PI;
@@ -368,6 +371,9 @@ void Species::initOperators( Params &params, Patch *patch )
     // assign the correct Merging method to Merge
     Merge = MergingFactory::create( this, patch->rand_ );
 
+    // assign the correct Splitting method to Split
+    Split = SplittingFactory::create( this, patch->rand_ );
+
     // Evaluation of the particle computation time
     if (params.has_adaptive_vectorization ) {
         part_comp_time_ = PartCompTimeFactory::create( params );
@@ -399,6 +405,7 @@ Species::~Species()
     delete Interp;
     delete Proj;
     delete Merge;
+    delete Split;
     delete Ionize;
     delete Radiate;
     delete part_comp_time_;
@@ -732,6 +739,10 @@ void Species::dynamics( double time_dual,
         SMILEI_ASSERT( particles->last_index.size() >= 1 );
         SMILEI_ASSERT( particles->last_index.back() == particles->last_index[0] );
 #endif
+        if( Ionize ) {
+            Proj->prepareIonizationCurrents( time_dual>time_frozen_ && !particles->is_test && mass_>0 );
+        }
+
         for( unsigned int ibin = 0 ; ibin < particles->numberOfBins() ; ibin++ ) {
 
             patch->startFineTimer(interpolation_timer_id_);
@@ -2758,6 +2769,13 @@ void Species::mergeParticles( double /*time_dual*/ )
 {
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Particle splitting cell by cell
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::splitParticles( double /*time_dual*/, std::vector<Diagnostic *> &/*localDiags*/ )
+{
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all particles of the species reacting to laser envelope
 //   - interpolate the fields at the particle position
@@ -36,6 +36,7 @@ class Patch;
 class SimWindow;
 class Radiation;
 class Merging;
+class Splitting;
 class PartCompTime;
 
 
@@ -297,6 +298,28 @@ public:
     //! Minimum momentum value in log scale
     double merge_min_momentum_log_scale_;
 
+    // Splitting parameters :
+    //! Splitting method
+    std::string splitting_method_;
+
+    //! Boolean to test if the species has the splitting ready
+    bool has_splitting_;
+
+    //! Time selection for the particle splitting
+    TimeSelection *splitting_time_selection_;
+
+    //! Cells with fewer particles are split
+    unsigned int split_target_particles_per_cell_;
+
+    //! Minimum weight of the daughter particles
+    double split_min_weight_;
+
+    //! Maximum number of particles created per patch at each splitting event
+    unsigned int split_max_new_particles_;
+
+    //! Distance between the daughter particles, in units of the cell length
+    double split_displacement_;
+
     //! Local minimum of MPI domain
     double min_loc;
 
@@ -333,6 +356,9 @@ public:
     //! Merging
     Merging *Merge;
 
+    //! Splitting
+    Splitting *Split;
+
     //! Particle Computation time evaluation
     PartCompTime *part_comp_time_ = NULL;
     
@@ -478,6 +504,9 @@ public:
     //! Method performing the merging of particles
     virtual void mergeParticles( double time_dual );
 
+    //! Method performing the splitting of particles
+    virtual void splitParticles( double time_dual, std::vector<Diagnostic *> &localDiags );
+
 
     //! Method calculating the Particle charge on the grid (projection)
     virtual void computeCharge( ElectroMagn *EMfields, bool old=false );
@@ -334,6 +334,66 @@ public:
             MESSAGE( 3, "| Maximum particle packet size: " << this_species->merge_max_packet_size_ );
         }
 
+        // Particle Splitting
+        this_species->splitting_method_ = "none"; // default value
+        this_species->has_splitting_ = false; // default value
+        PyTools::extract( "splitting_method", this_species->splitting_method_, "Species", ispec );
+        // Cancelation of the letter case for `splitting_method_`
+        std::transform( this_species->splitting_method_.begin(), this_species->splitting_method_.end(), this_species->splitting_method_.begin(), ::tolower );
+        // Manage particle splitting
+        if( this_species->splitting_method_ != "none" ) {
+            if( this_species->splitting_method_ != "pair" ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` splitting method must be `pair` or `none`",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            if( params.geometry == "AMcylindrical" ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` particle splitting is not available in AMcylindrical geometry",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            // get parameter "every" which describes a timestep selection
+            if( !this_species->splitting_time_selection_ ) {
+                this_species->splitting_time_selection_ = new TimeSelection(
+                    PyTools::extract_py( "split_every", "Species", ispec ), "Particle splitting"
+                );
+            }
+            // Read and check the threshold on the number of particles per cell
+            PyTools::extract( "split_target_particles_per_cell", this_species->split_target_particles_per_cell_ , "Species", ispec );
+            if( this_species->split_target_particles_per_cell_ < 2 ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` the target number of particles per cell "
+                    << "(`split_target_particles_per_cell`) must be >= 2",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            if( this_species->has_merging_
+                && this_species->split_target_particles_per_cell_ > this_species->merge_min_particles_per_cell_ ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` split_target_particles_per_cell must be <= merge_min_particles_per_cell, "
+                    << "otherwise the split particles would be merged again",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            // Minimum weight of the daughter particles
+            PyTools::extract( "split_min_weight", this_species->split_min_weight_ , "Species", ispec );
+            if( this_species->split_min_weight_ < 0 ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` split_min_weight must be >= 0",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            // Budget of new particles per patch
+            PyTools::extract( "split_max_new_particles", this_species->split_max_new_particles_ , "Species", ispec );
+            // Distance between the daughters
+            PyTools::extract( "split_displacement", this_species->split_displacement_ , "Species", ispec );
+            if( this_species->split_displacement_ < 0 || this_species->split_displacement_ > 0.5 ) {
+                ERROR_NAMELIST( "For species `" << species_name << "` split_displacement must be between 0 and 0.5",
+                    LINK_NAMELIST + std::string("#particle-splitting") );
+            }
+            // We activate the splitting
+            this_species->has_splitting_ = true;
+            // Output
+            MESSAGE( 2, "> Particle splitting with the method: " << this_species->splitting_method_ );
+            MESSAGE( 3, "| Splitting time selection: " << this_species->splitting_time_selection_->info() );
+            MESSAGE( 3, "| Target particle number per cell: " << this_species->split_target_particles_per_cell_ );
+            MESSAGE( 3, "| Minimum daughter weight: " << std::scientific << this_species->split_min_weight_ );
+            MESSAGE( 3, "| Maximum new particles per patch: " << std::fixed << this_species->split_max_new_particles_ );
+            MESSAGE( 3, "| Displacement of the daughters: " << this_species->split_displacement_ << " cell" );
+        }
+
         // Position initialization
         PyObject *py_pos_init = PyTools::extract_py( "position_initialization", "Species", ispec );
         if( PyTools::py2scalar( py_pos_init, this_species->position_initialization_ ) ) {
@@ -1061,6 +1121,13 @@ public:
         new_species->merge_min_momentum_cell_length_[0]       = species->merge_min_momentum_cell_length_[0];
         new_species->merge_min_momentum_cell_length_[1]       = species->merge_min_momentum_cell_length_[1];
         new_species->merge_min_momentum_cell_length_[2]       = species->merge_min_momentum_cell_length_[2];
+        new_species->splitting_method_                        = species->splitting_method_;
+        new_species->has_splitting_                           = species->has_splitting_;
+        new_species->splitting_time_selection_                = species->splitting_time_selection_;
+        new_species->split_target_particles_per_cell_         = species->split_target_particles_per_cell_;
+        new_species->split_min_weight_                        = species->split_min_weight_;
+        new_species->split_max_new_particles_                 = species->split_max_new_particles_;
+        new_species->split_displacement_                      = species->split_displacement_;
 
 
         new_species->charge_profile_                          = new Profile( species->charge_profile_ );
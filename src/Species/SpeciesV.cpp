@@ -35,6 +35,7 @@
 #include "Tools.h"
 
 #include "DiagnosticTrack.h"
+#include "Splitting.h"
 
 using namespace std;
 
@@ -332,6 +333,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
 #endif
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, ithread,0,5);
+                Proj->prepareIonizationCurrents( time_dual>time_frozen_ && !particles->is_test && mass_>0 );
                 for( unsigned int scell = 0 ; scell < particles->first_index.size() ; scell++ ) {
                     ( *Ionize )( particles, particles->first_index[scell], particles->last_index[scell], Epart, patch, Proj );
                 }
@@ -1478,32 +1480,56 @@ void SpeciesV::sortParticles( Params &params )
         //particles->cell_keys.resize( particles->last_index.back() ); // Merge this in particles.resize(..) ?
     }
 
-    //Loop over all cells
+    //Under CFL only a small fraction of the particles change cell during a timestep.
+    //First detect the displaced particles (read-only pass on the cell keys),
+    //then build the exchange cycles starting from these particles only.
+    int *const __restrict__ cell_keys = particles->getPtrCellKeys();
+    displaced_particles_.clear();
+    displaced_cells_.clear();
     for( int icell = 0 ; icell < ( int )ncell; icell++ ) {
-        for( unsigned int ip=( unsigned int )particles->first_index[icell]; ip < ( unsigned int )particles->last_index[icell] ; ip++ ) {
-            //update value of current cell 'icell' if necessary
-            //if particle changes cell, build a cycle of exchange as long as possible. Treats all particles
-            if( particles->cell_keys[ip] != icell ) {
-                cycle.resize( 1 );
-                cycle[0] = ip;
-                ip_src = ip;
-                //While the destination particle is not going out of the patch or back to the initial cell, keep building the cycle.
-                while( particles->cell_keys[ip_src] != icell ) {
-                    //Scan the next cell destination
-                    ip_dest = particles->first_index[particles->cell_keys[ip_src]];
-                    while( particles->cell_keys[ip_dest] == particles->cell_keys[ip_src] ) {
-                        ip_dest++;
-                    }
-                    //In the destination cell, if a particle is going out of this cell, add it to the cycle.
-                    particles->first_index[particles->cell_keys[ip_src]] = ip_dest + 1 ;
-                    cycle.push_back( ip_dest );
-                    ip_src = ip_dest; //Destination becomes source for the next iteration
+        const int istart = particles->first_index[icell];
+        const int iend   = particles->last_index[icell];
+        int ndisplaced = 0;
+        #pragma omp simd reduction(+:ndisplaced)
+        for( int ip = istart; ip < iend ; ip++ ) {
+            ndisplaced += ( cell_keys[ip] != icell );
+        }
+        if( ndisplaced > 0 ) {
+            for( int ip = istart; ip < iend ; ip++ ) {
+                if( cell_keys[ip] != icell ) {
+                    displaced_particles_.push_back( ip );
+                    displaced_cells_.push_back( icell );
                 }
-                //swap parts
-                particles->swapParticles( cycle );
             }
         }
-    } //end loop on cells
+    }
+
+    //Loop over displaced particles only
+    for( unsigned int idisp = 0 ; idisp < displaced_particles_.size() ; idisp++ ) {
+        const unsigned int ip = displaced_particles_[idisp];
+        const int icell = displaced_cells_[idisp];
+        //Cell keys are not updated by the cycles: the slot may already have been filled
+        //by a previous cycle, which is the case when it is below the cursor of its cell
+        if( ( int )ip >= particles->first_index[icell] ) {
+            cycle.resize( 1 );
+            cycle[0] = ip;
+            ip_src = ip;
+            //While the destination particle is not going out of the patch or back to the initial cell, keep building the cycle.
+            while( cell_keys[ip_src] != icell ) {
+                //Scan the next cell destination
+                ip_dest = particles->first_index[cell_keys[ip_src]];
+                while( cell_keys[ip_dest] == cell_keys[ip_src] ) {
+                    ip_dest++;
+                }
+                //In the destination cell, if a particle is going out of this cell, add it to the cycle.
+                particles->first_index[cell_keys[ip_src]] = ip_dest + 1 ;
+                cycle.push_back( ip_dest );
+                ip_src = ip_dest; //Destination becomes source for the next iteration
+            }
+            //swap parts
+            particles->swapParticles( cycle );
+        }
+    } //end loop on displaced particles
     // Restore particles->first_index initial value
     particles->first_index[0]=0;
     for( unsigned int ic=1; ic < ncell; ic++ ) {
@@ -1739,15 +1765,17 @@ void SpeciesV::mergeParticles( double time_dual )
 // #endif
 
 
-    // Only for moving particles
-    if( time_dual>time_frozen_ ) {
+    // Only for moving particles, and only in the patches with at least one
+    // cell above the threshold `merge_min_particles_per_cell`
+    if( time_dual>time_frozen_ && Merge->hasCellsToMerge( *particles ) ) {
 
         unsigned int scell ;
         // double weight_before = 0;
         // double weight_after = 0;
         // double energy_before = 0;
         // double energy_after = 0;
-        std::vector <int> mask(particles->last_index.back(), 1);
+        std::vector <int> &mask = Merging::scratch().mask;
+        mask.assign( particles->last_index.back(), 1 );
 
         // Resize the cell_keys
         // particles->cell_keys.resize( particles->last_index.back(), 1 );
@@ -1762,14 +1790,12 @@ void SpeciesV::mergeParticles( double time_dual )
         // }
 
         // For each cell, we apply independently the merging process
-        for( scell = 0 ; scell < particles->first_index.size() ; scell++ ) {
-
-            ( *Merge )( mass_, *particles, mask, particles->first_index[scell],
-                        particles->last_index[scell], count[scell]);
-
-        }
+        unsigned int removed = Merge->mergeCells( mass_, *particles, mask, count );
 
         // We remove empty space in an optimized manner
+        if( removed == 0 ) {
+            return;
+        }
         particles->eraseParticlesWithMask(0, particles->last_index.back(), mask);
 
         // Update of first and last cell indexes
@@ -1853,6 +1879,49 @@ void SpeciesV::mergeParticles( double time_dual )
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Particle splitting cell by cell
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::splitParticles( double time_dual, std::vector<Diagnostic *> &localDiags )
+{
+    // Only for moving particles, and only in the patches with at least one
+    // cell below the threshold `split_target_particles_per_cell`
+    if( time_dual>time_frozen_ && Split->hasCellsToSplit( *particles ) ) {
+
+        unsigned int ncells = particles->first_index.size();
+
+        // The parents are halved in place, the other daughters are created
+        // here, sorted by cell
+        Particles daughters;
+        daughters.initialize( 0, *particles );
+        std::vector<int> daughters_count( ncells, 0 );
+
+        unsigned int ndaughters = Split->splitCells( *particles, daughters, daughters_count );
+        if( ndaughters == 0 ) {
+            return;
+        }
+
+        // The daughters get their own IDs (the parent keeps its ID)
+        if( particles->tracked ) {
+            for( unsigned int ip = 0; ip < ndaughters; ip++ ) {
+                daughters.id( ip ) = 0;
+            }
+            dynamic_cast<DiagnosticTrack *>( localDiags[tracking_diagnostic] )->setIDs( daughters );
+        }
+
+        // Insert the daughters at the end of the cell of their parent
+        particles->insertParticlesPerCell( daughters, daughters_count );
+        for( unsigned int icell = 0 ; icell < ncells ; icell++ ) {
+            count[icell] += daughters_count[icell];
+        }
+
+        // Set place for new particles in species->particles->cell_keys
+        for( unsigned int ip = 0; ip < ndaughters; ip++ ) {
+            addSpaceForOneParticle();
+        }
+    }
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // For all particles of the species reacting to laser envelope
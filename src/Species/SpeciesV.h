@@ -86,6 +86,9 @@ public:
     //! Method performing the merging of particles
     virtual void mergeParticles( double time_dual )override;
 
+    //! Method performing the splitting of particles
+    virtual void splitParticles( double time_dual, std::vector<Diagnostic *> &localDiags )override;
+
 #ifdef _OMPTASKS
 
     //! Method calculating the Particle dynamics (interpolation, pusher, projection) with tasks
@@ -123,6 +126,11 @@ private:
     //! Size of the pack in number of particles
     unsigned int packsize_;
 
+    //! Indexes of the particles which changed cell since the last sort (reused between sorts)
+    std::vector<unsigned int> displaced_particles_;
+    //! Cell of the slot occupied by each displaced particle
+    std::vector<int> displaced_cells_;
+
     
     
 
@@ -123,6 +123,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
             //    (*Interp)(EMfields, *particles, smpi, &(particles->first_index[scell]), &(particles->last_index[scell]), ithread );
 
             smpi->traceEventIfDiagTracing(diag_PartEventTracing, ithread, 0, 5);
+            Proj->prepareIonizationCurrents( time_dual>time_frozen_ && !particles->is_test && mass_>0 );
             for( unsigned int scell = 0 ; scell < particles->first_index.size() ; scell++ ) {
 
 
@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+//! \file Splitting.cpp
+//
+//! \brief Class implementation for the generic class
+//!  Splitting dedicated to the particle splitting.
+//
+// ----------------------------------------------------------------------------
+
+#include "Splitting.h"
+
+#include <algorithm>
+#include <cmath>
+
+// -----------------------------------------------------------------------------
+//! Constructor for Splitting
+//! \param species Species object
+//! \param rand local random generator
+// -----------------------------------------------------------------------------
+Splitting::Splitting( Species *species, Random * rand )
+{
+    target_particles_per_cell_ = species->split_target_particles_per_cell_;
+    min_weight_                = species->split_min_weight_;
+    max_new_particles_         = species->split_max_new_particles_;
+    displacement_              = species->split_displacement_;
+
+    nDim_ = species->nDim_field;
+    cell_length_.resize( nDim_ );
+    cell_length_inv_.resize( nDim_ );
+    for( unsigned int i = 0 ; i < nDim_ ; i++ ) {
+        cell_length_[i]     = species->cell_length[i];
+        cell_length_inv_[i] = 1./species->cell_length[i];
+    }
+
+    // Pointer to the local patch random generator
+    rand_ = rand;
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for Splitting
+// -----------------------------------------------------------------------------
+Splitting::~Splitting()
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Split the particles of all the cells of a patch in a single pass
+// -----------------------------------------------------------------------------
+unsigned int Splitting::splitCells(
+    Particles &particles,
+    Particles &new_particles,
+    std::vector <int> &new_count )
+{
+    unsigned int created = 0;
+    for( unsigned int scell = 0 ; scell < particles.first_index.size() && created < max_new_particles_ ; scell++ ) {
+
+        unsigned int istart = particles.first_index[scell];
+        unsigned int iend   = particles.last_index[scell];
+        unsigned int npart  = iend - istart;
+        if( npart == 0 || npart >= target_particles_per_cell_ ) {
+            continue;
+        }
+
+        // Particles heavy enough to be split
+        candidates_.clear();
+        for( unsigned int ipart = istart ; ipart < iend ; ipart++ ) {
+            if( particles.weight( ipart ) >= 2.*min_weight_ ) {
+                candidates_.push_back( ipart );
+            }
+        }
+
+        // The heaviest particles are split first, each one at most once per event
+        unsigned int nsplit = std::min( ( unsigned int )candidates_.size(), target_particles_per_cell_ - npart );
+        std::partial_sort( candidates_.begin(), candidates_.begin() + nsplit, candidates_.end(),
+            [&particles]( unsigned int a, unsigned int b ) {
+                return particles.weight( a ) > particles.weight( b );
+            } );
+
+        unsigned int created_in_cell = 0;
+        for( unsigned int i = 0 ; i < nsplit && created + created_in_cell < max_new_particles_ ; i++ ) {
+            created_in_cell += ( *this )( particles, candidates_[i], new_particles );
+        }
+        new_count[scell] = created_in_cell;
+        created += created_in_cell;
+    }
+    return created;
+}
+
+// -----------------------------------------------------------------------------
+//! Whether at least one cell of the patch is under-resolved
+// -----------------------------------------------------------------------------
+bool Splitting::hasCellsToSplit( Particles &particles ) const
+{
+    for( unsigned int scell = 0 ; scell < particles.first_index.size() ; scell++ ) {
+        unsigned int npart = particles.last_index[scell] - particles.first_index[scell];
+        if( npart > 0 && npart < target_particles_per_cell_ ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+//! Largest displacement of the daughters along direction, in both ways,
+//! that keeps them in the cell of the parent. The cells are centered on
+//! the primal nodes, as for the cell keys. The daughters also remain between
+//! the two primal nodes around the parent, so that they never cross a patch border.
+// -----------------------------------------------------------------------------
+double Splitting::displacement( Particles &particles, unsigned int ipart, const double *direction ) const
+{
+    double d = displacement_;
+    for( unsigned int i = 0 ; i < nDim_ ; i++ ) {
+        double x = particles.position( i, ipart ) * cell_length_inv_[i];
+        double xcell = std::round( x );
+        double xnode = std::floor( x );
+        // Distance (in cells) to the closest boundary of the cell or node interval, with a margin
+        double margin = 0.5 * std::min( { 0.5 - std::abs( x - xcell ), x - xnode, xnode + 1. - x } );
+        double u = std::abs( direction[i] );
+        if( u * d > margin ) {
+            d = std::max( margin / u, 0. );
+        }
+    }
+    return d;
+}
+
+// -----------------------------------------------------------------------------
+//! Random unit vector in the space of the particle positions
+// -----------------------------------------------------------------------------
+void Splitting::randomDirection( double *direction )
+{
+    if( nDim_ == 1 ) {
+        direction[0] = 1.;
+    } else if( nDim_ == 2 ) {
+        double theta = rand_->uniform_2pi();
+        direction[0] = std::cos( theta );
+        direction[1] = std::sin( theta );
+    } else {
+        double cos_theta = 2.*rand_->uniform() - 1.;
+        double sin_theta = std::sqrt( 1. - cos_theta*cos_theta );
+        double phi = rand_->uniform_2pi();
+        direction[0] = cos_theta;
+        direction[1] = sin_theta * std::cos( phi );
+        direction[2] = sin_theta * std::sin( phi );
+    }
+}
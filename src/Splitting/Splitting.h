@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+//! \file Splitting.h
+//
+//! \brief Header for the generic class Splitting
+//! dedicated to the particle splitting, the counterpart of the merging
+//! in the under-resolved cells.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef SPLITTING_H
+#define SPLITTING_H
+
+#include <vector>
+
+#include "Params.h"
+#include "Particles.h"
+#include "Species.h"
+#include "Random.h"
+
+//  ----------------------------------------------------------------------------
+//! Class Splitting
+//  ----------------------------------------------------------------------------
+class Splitting
+{
+public:
+
+    //! Creator for Splitting
+    Splitting( Species *species, Random * rand );
+
+    virtual ~Splitting();
+
+    //! Split one particle
+    //! \param particles      particles of the current species
+    //! \param ipart          index of the particle to split, which becomes
+    //!                       the first daughter
+    //! \param new_particles  where the other daughters are appended
+    //! \return number of particles appended to new_particles
+    virtual unsigned int operator()(
+        Particles &particles,
+        unsigned int ipart,
+        Particles &new_particles ) = 0;
+
+    //! Split the particles of all the cells of a patch (particles.first_index
+    //! and particles.last_index) having less than the target number of
+    //! particles, the heaviest first, within the budget of the patch.
+    //! The daughters which do not replace their parent are appended to
+    //! new_particles, sorted by cell.
+    //! \param new_count  number of particles appended for each cell
+    //! \return number of particles appended
+    unsigned int splitCells(
+        Particles &particles,
+        Particles &new_particles,
+        std::vector <int> &new_count );
+
+    //! Whether at least one cell of the patch is under-resolved
+    bool hasCellsToSplit( Particles &particles ) const;
+
+protected:
+
+    //! Largest displacement of the daughters along direction, within
+    //! the cell of the parent so that the cell sorting is preserved,
+    //! and within its patch
+    double displacement( Particles &particles, unsigned int ipart, const double *direction ) const;
+
+    //! Random unit vector in the space of the particle positions
+    void randomDirection( double *direction );
+
+    // Local rand generator
+    Random * rand_;
+
+    // Cells with fewer particles are split
+    unsigned int target_particles_per_cell_;
+
+    // Minimum weight of the daughter particles
+    double min_weight_;
+
+    // Maximum number of particles created per patch at each splitting event
+    unsigned int max_new_particles_;
+
+    // Distance between the daughters, in units of the cell length
+    double displacement_;
+
+    // Number of dimensions of the particle positions
+    unsigned int nDim_;
+
+    // Cell length and its inverse
+    std::vector<double> cell_length_;
+    std::vector<double> cell_length_inv_;
+
+private:
+
+    // Particles of the current cell that may be split
+    std::vector<unsigned int> candidates_;
+
+};
+
+#endif
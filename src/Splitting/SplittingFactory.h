@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+//! \file SplittingFactory.h
+//
+//! \brief Header for the class SplittingFactory that
+//! manages the different particle splitting algorithms.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef SPLITTINGFACTORY_H
+#define SPLITTINGFACTORY_H
+
+#include "Splitting.h"
+#include "SplittingPair.h"
+
+//  ----------------------------------------------------------------------------
+//! Class SplittingFactory
+//  ----------------------------------------------------------------------------
+
+class SplittingFactory
+{
+public:
+
+    //  ------------------------------------------------------------------------
+    //! Create appropriate splitting method for the species `species`
+    //! \param species Species object
+    //! \param rand local random generator
+    //  ------------------------------------------------------------------------
+    static Splitting *create( Species *species, Random * rand )
+    {
+        Splitting *Split = NULL;
+
+        if( species->splitting_method_ == "pair" ) {
+            Split = new SplittingPair( species, rand );
+        }
+
+        return Split;
+    }
+};
+
+#endif
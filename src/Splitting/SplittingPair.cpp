@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+//! \file SplittingPair.cpp
+//
+//! \brief Functions of the class SplittingPair
+//! Particle splitting in pairs of half-weight particles
+//
+// ----------------------------------------------------------------------------
+
+#include "SplittingPair.h"
+
+// -----------------------------------------------------------------------------
+//! Constructor for SplittingPair
+//! \param species Species object
+//! \param rand local random generator
+// -----------------------------------------------------------------------------
+SplittingPair::SplittingPair( Species *species, Random * rand ) :
+    Splitting( species, rand )
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for SplittingPair
+// -----------------------------------------------------------------------------
+SplittingPair::~SplittingPair()
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Split the particle ipart in two particles of half its weight and the same
+//! momentum. The daughters are displaced by +/- d along a random direction,
+//! so that only the quadrupole moment of the charge distribution changes.
+//! The parent becomes the first daughter, the second one is appended to
+//! new_particles.
+// -----------------------------------------------------------------------------
+unsigned int SplittingPair::operator()(
+    Particles &particles,
+    unsigned int ipart,
+    Particles &new_particles )
+{
+    double direction[3];
+    randomDirection( direction );
+    double d = displacement( particles, ipart, direction );
+
+    particles.weight( ipart ) *= 0.5;
+    particles.copyParticle( ipart, new_particles );
+    unsigned int idaughter = new_particles.size() - 1;
+
+    for( unsigned int i = 0 ; i < nDim_ ; i++ ) {
+        double shift = d * direction[i] * cell_length_[i];
+        particles.position( i, ipart )         += shift;
+        new_particles.position( i, idaughter ) -= shift;
+    }
+
+    return 1;
+}
@@ -0,0 +1,38 @@
+// ----------------------------------------------------------------------------
+//! \file SplittingPair.h
+//
+//! \brief Header for the class SplittingPair
+//! Each particle is split into two particles of half its weight, with the
+//! same momentum, displaced symmetrically from the parent position.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef SPLITTINGPAIR_H
+#define SPLITTINGPAIR_H
+
+#include "Splitting.h"
+
+//------------------------------------------------------------------------------
+//! SplittingPair class: the total weight, charge, momentum and energy are
+//! exactly conserved, as well as the centroid of the parent particle.
+//------------------------------------------------------------------------------
+class SplittingPair : public Splitting
+{
+
+public:
+
+    //! Constructor for SplittingPair
+    SplittingPair( Species *species, Random * rand );
+
+    //! Destructor for SplittingPair
+    ~SplittingPair();
+
+    //! Overloading of () operator: split the particle ipart in two
+    unsigned int operator()(
+        Particles &particles,
+        unsigned int ipart,
+        Particles &new_particles ) override;
+
+};
+
+#endif
@@ -41,7 +41,7 @@ void H5::init( std::string file, unsigned access, MPI_Comm * comm, bool _raise )
     if( comm ) {
         H5Pset_fapl_mpio( fapl, *comm, MPI_INFO_NULL );
     }
-    if( access == H5F_ACC_RDWR ) {
+    if( access == H5F_ACC_TRUNC ) {
         fid_ = H5Fcreate( filepath_.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
     } else {
         fid_ = H5Fopen( filepath_.c_str(), access, fapl );
@@ -61,6 +61,8 @@ public:
 
 class H5
 {
+    friend class H5Subfiling;
+    
 public:
     //! Empty HDF5 object
     H5() {
@@ -128,9 +130,9 @@ protected:
 class H5Write : public H5
 {
 public:
-    //! Open HDF5 file + location
-    H5Write( std::string file, MPI_Comm * comm = NULL, bool _raise = true )
-     : H5( file, H5F_ACC_RDWR, comm, _raise ) {};
+    //! Open HDF5 file + location (the file is truncated, unless append)
+    H5Write( std::string file, MPI_Comm * comm = NULL, bool _raise = true, bool append = false )
+     : H5( file, append ? H5F_ACC_RDWR : H5F_ACC_TRUNC, comm, _raise ) {};
     
     //! Create group inside the given H5Write location
     H5Write( H5Write *loc, std::string group_name )
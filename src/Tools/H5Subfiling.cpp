@@ -0,0 +1,335 @@
+#include "H5Subfiling.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+    //! List the names of the links of a group
+    herr_t listLink( hid_t, const char *name, const H5L_info_t *, void *names )
+    {
+        static_cast<vector<string> *>( names )->push_back( name );
+        return 0;
+    }
+
+    //! Copy an attribute to the location pointed by destination
+    herr_t copyAttribute( hid_t source, const char *name, const H5A_info_t *, void *destination )
+    {
+        hid_t dest = *static_cast<hid_t *>( destination );
+        hid_t aid = H5Aopen( source, name, H5P_DEFAULT );
+        hid_t atype = H5Aget_type( aid );
+        hid_t aspace = H5Aget_space( aid );
+        hssize_t npoints = H5Sget_simple_extent_npoints( aspace );
+        vector<char> buffer( H5Tget_size( atype ) * max( npoints, ( hssize_t )1 ) );
+        H5Aread( aid, atype, &buffer[0] );
+
+        if( H5Aexists( dest, name ) > 0 ) {
+            H5Adelete( dest, name );
+        }
+        hid_t did = H5Acreate( dest, name, atype, aspace, H5P_DEFAULT, H5P_DEFAULT );
+        H5Awrite( did, atype, &buffer[0] );
+        H5Aclose( did );
+
+        // Variable-length data was allocated by H5Aread
+        if( H5Tdetect_class( atype, H5T_VLEN ) > 0 || H5Tis_variable_str( atype ) > 0 ) {
+#if H5_VERSION_GE( 1, 12, 0 )
+            H5Treclaim( atype, aspace, H5P_DEFAULT, &buffer[0] );
+#else
+            H5Dvlen_reclaim( atype, aspace, H5P_DEFAULT, &buffer[0] );
+#endif
+        }
+        H5Sclose( aspace );
+        H5Tclose( atype );
+        H5Aclose( aid );
+        return 0;
+    }
+
+    void copyAttributes( hid_t source, hid_t destination )
+    {
+        H5Aiterate2( source, H5_INDEX_NAME, H5_ITER_INC, NULL, copyAttribute, &destination );
+    }
+}
+
+
+H5Subfiling::H5Subfiling( string filename, MPI_Comm world, MPI_Comm subfile_comm, unsigned int subfile_index ) :
+    filename_( filename ),
+    world_( world ),
+    subfile_comm_( subfile_comm ),
+    subfile_index_( subfile_index ),
+    master_( NULL )
+{
+    int rank;
+    MPI_Comm_rank( world_, &rank );
+    if( rank == 0 ) {
+        master_ = new H5Write( filename_ );
+    }
+}
+
+
+H5Subfiling::~H5Subfiling()
+{
+    if( master_ ) {
+        delete master_;
+    }
+}
+
+
+string H5Subfiling::subfileName( string filename, unsigned int index )
+{
+    size_t i = filename.rfind( ".h5" );
+    ostringstream name( "" );
+    name << filename.substr( 0, i ) << ".subfile" << setfill( '0' ) << setw( 6 ) << index << ".h5";
+    return name.str();
+}
+
+
+H5Space * H5Subfiling::select( H5Space *global_space )
+{
+    unsigned int ndim = global_space->dims_.size();
+
+    // Blocks selected by this MPI process: start and end of each block
+    hssize_t nblocks = 0;
+    vector<hsize_t> list( 0 );
+    H5S_sel_type type = H5Sget_select_type( global_space->sid_ );
+    if( type == H5S_SEL_HYPERSLABS ) {
+        nblocks = H5Sget_select_hyper_nblocks( global_space->sid_ );
+        list.resize( 2 * ndim * nblocks );
+        if( nblocks > 0 ) {
+            H5Sget_select_hyper_blocklist( global_space->sid_, 0, nblocks, &list[0] );
+        }
+    } else if( type == H5S_SEL_ALL && global_space->global_ > 0 ) {
+        nblocks = 1;
+        list.resize( 2 * ndim, 0 );
+        for( unsigned int i=0; i<ndim; i++ ) {
+            list[ndim+i] = global_space->dims_[i] - 1;
+        }
+    }
+
+    // Bounding box of the subfile
+    vector<uint64_t> box_min( ndim, numeric_limits<uint64_t>::max() ), box_max( ndim, 0 );
+    for( hssize_t b=0; b<nblocks; b++ ) {
+        for( unsigned int i=0; i<ndim; i++ ) {
+            box_min[i] = min( box_min[i], ( uint64_t )list[2*ndim*b+i] );
+            box_max[i] = max( box_max[i], ( uint64_t )list[2*ndim*b+ndim+i] + 1 );
+        }
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &box_min[0], ndim, MPI_UINT64_T, MPI_MIN, subfile_comm_ );
+    MPI_Allreduce( MPI_IN_PLACE, &box_max[0], ndim, MPI_UINT64_T, MPI_MAX, subfile_comm_ );
+    vector<hsize_t> source_dims( ndim ), chunk( 0 );
+    bool empty = false;
+    for( unsigned int i=0; i<ndim; i++ ) {
+        if( box_max[i] <= box_min[i] ) {
+            empty = true;
+        }
+    }
+    for( unsigned int i=0; i<ndim; i++ ) {
+        source_dims[i] = empty ? 0 : box_max[i] - box_min[i];
+    }
+    // Chunks cannot be larger than the dataset
+    if( ! empty && ! global_space->chunk_.empty() ) {
+        chunk.resize( ndim );
+        for( unsigned int i=0; i<ndim; i++ ) {
+            chunk[i] = min( global_space->chunk_[i], source_dims[i] );
+        }
+    }
+
+    // Same selection, relative to the bounding box
+    H5Space *space = new H5Space( source_dims, {}, {}, chunk );
+    H5Sselect_none( space->sid_ );
+    vector<Block> blocks( nblocks );
+    vector<hsize_t> ones( ndim, 1 );
+    for( hssize_t b=0; b<nblocks; b++ ) {
+        blocks[b].subfile = subfile_index_;
+        blocks[b].virtual_start.resize( ndim );
+        blocks[b].source_start.resize( ndim );
+        blocks[b].count.resize( ndim );
+        for( unsigned int i=0; i<ndim; i++ ) {
+            blocks[b].virtual_start[i] = list[2*ndim*b+i];
+            blocks[b].source_start[i] = list[2*ndim*b+i] - box_min[i];
+            blocks[b].count[i] = list[2*ndim*b+ndim+i] - list[2*ndim*b+i] + 1;
+        }
+        H5Sselect_hyperslab( space->sid_, H5S_SELECT_OR, &blocks[b].source_start[0], NULL, &ones[0], &blocks[b].count[0] );
+    }
+
+    gather( global_space->dims_, source_dims, blocks );
+
+    return space;
+}
+
+
+void H5Subfiling::selectRange( uint64_t &size, uint64_t &offset, uint64_t npoints )
+{
+    int rank;
+    MPI_Comm_rank( subfile_comm_, &rank );
+    uint64_t subfile_offset = 0, subfile_size = 0;
+    MPI_Exscan( &npoints, &subfile_offset, 1, MPI_UINT64_T, MPI_SUM, subfile_comm_ );
+    if( rank == 0 ) {
+        subfile_offset = 0;
+    }
+    MPI_Allreduce( &npoints, &subfile_size, 1, MPI_UINT64_T, MPI_SUM, subfile_comm_ );
+
+    vector<Block> blocks( 0 );
+    if( npoints > 0 ) {
+        Block b;
+        b.subfile = subfile_index_;
+        b.virtual_start = { offset };
+        b.source_start = { subfile_offset };
+        b.count = { npoints };
+        blocks.push_back( b );
+    }
+    gather( { size }, { subfile_size }, blocks );
+
+    size = subfile_size;
+    offset = subfile_offset;
+}
+
+
+void H5Subfiling::gather( vector<hsize_t> global_dims, vector<hsize_t> source_dims, vector<Block> &blocks )
+{
+    unsigned int ndim = global_dims.size();
+
+    // Serialize the subfile index, the dimensions in the subfile and the blocks
+    vector<uint64_t> buffer( 1, subfile_index_ );
+    buffer.insert( buffer.end(), source_dims.begin(), source_dims.end() );
+    for( unsigned int b=0; b<blocks.size(); b++ ) {
+        buffer.insert( buffer.end(), blocks[b].virtual_start.begin(), blocks[b].virtual_start.end() );
+        buffer.insert( buffer.end(), blocks[b].source_start.begin(), blocks[b].source_start.end() );
+        buffer.insert( buffer.end(), blocks[b].count.begin(), blocks[b].count.end() );
+    }
+
+    int size, n = buffer.size();
+    MPI_Comm_size( world_, &size );
+    vector<int> counts( master_ ? size : 0 ), displs( master_ ? size : 0 );
+    MPI_Gather( &n, 1, MPI_INT, master_ ? &counts[0] : NULL, 1, MPI_INT, 0, world_ );
+    vector<uint64_t> all( 0 );
+    if( master_ ) {
+        int total = 0;
+        for( int r=0; r<size; r++ ) {
+            displs[r] = total;
+            total += counts[r];
+        }
+        all.resize( total );
+    }
+    MPI_Gatherv( &buffer[0], n, MPI_UINT64_T, master_ ? &all[0] : NULL,
+                 master_ ? &counts[0] : NULL, master_ ? &displs[0] : NULL, MPI_UINT64_T, 0, world_ );
+    if( ! master_ ) {
+        return;
+    }
+
+    global_dims_ = global_dims;
+    source_dims_.resize( 0 );
+    blocks_.resize( 0 );
+    for( int r=0; r<size; r++ ) {
+        unsigned int p = displs[r];
+        unsigned int subfile = all[p++];
+        if( subfile >= source_dims_.size() ) {
+            source_dims_.resize( subfile+1 );
+        }
+        source_dims_[subfile].assign( all.begin()+p, all.begin()+p+ndim );
+        p += ndim;
+        unsigned int nblocks = ( counts[r] - 1 - ndim ) / ( 3*ndim );
+        for( unsigned int b=0; b<nblocks; b++ ) {
+            Block block;
+            block.subfile = subfile;
+            block.virtual_start.assign( all.begin()+p, all.begin()+p+ndim );
+            block.source_start .assign( all.begin()+p+ndim, all.begin()+p+2*ndim );
+            block.count        .assign( all.begin()+p+2*ndim, all.begin()+p+3*ndim );
+            p += 3*ndim;
+            // Contiguous 1D ranges of the same subfile are merged
+            if( ndim == 1 && ! blocks_.empty() ) {
+                Block &last = blocks_.back();
+                if( last.subfile == subfile
+                    && last.virtual_start[0] + last.count[0] == block.virtual_start[0]
+                    && last.source_start[0] + last.count[0] == block.source_start[0] ) {
+                    last.count[0] += block.count[0];
+                    continue;
+                }
+            }
+            blocks_.push_back( block );
+        }
+    }
+}
+
+
+void H5Subfiling::mirror( H5 *subfile, string path )
+{
+    if( ! master_ ) {
+        return;
+    }
+    hid_t source = H5Oopen( subfile->fid_, path.c_str(), H5P_DEFAULT );
+    mirrorObject( source, path );
+    H5Oclose( source );
+}
+
+
+void H5Subfiling::mirrorObject( hid_t source, string path )
+{
+    hid_t file = master_->fid_;
+
+    if( H5Iget_type( source ) == H5I_GROUP ) {
+
+        hid_t group;
+        if( path == "/" || H5Lexists( file, path.c_str(), H5P_DEFAULT ) > 0 ) {
+            group = H5Oopen( file, path.c_str(), H5P_DEFAULT );
+        } else {
+            hid_t lcpl = H5Pcreate( H5P_LINK_CREATE );
+            H5Pset_create_intermediate_group( lcpl, 1 );
+            group = H5Gcreate( file, path.c_str(), lcpl, H5P_DEFAULT, H5P_DEFAULT );
+            H5Pclose( lcpl );
+        }
+        copyAttributes( source, group );
+        H5Oclose( group );
+
+        vector<string> names( 0 );
+        H5Literate( source, H5_INDEX_NAME, H5_ITER_INC, NULL, listLink, &names );
+        for( unsigned int i=0; i<names.size(); i++ ) {
+            hid_t child = H5Oopen( source, names[i].c_str(), H5P_DEFAULT );
+            mirrorObject( child, ( path == "/" ? "" : path ) + "/" + names[i] );
+            H5Oclose( child );
+        }
+
+    } else if( H5Iget_type( source ) == H5I_DATASET ) {
+
+        if( H5Lexists( file, path.c_str(), H5P_DEFAULT ) > 0 ) {
+            return;
+        }
+
+        // Datasets shaped as the subfile selection become virtual, the others are copied
+        hid_t sspace = H5Dget_space( source );
+        int ndim = H5Sget_simple_extent_ndims( sspace );
+        vector<hsize_t> dims( max( ndim, 0 ) );
+        if( ndim > 0 ) {
+            H5Sget_simple_extent_dims( sspace, &dims[0], NULL );
+        }
+        H5Sclose( sspace );
+        if( subfile_index_ >= source_dims_.size() || dims != source_dims_[subfile_index_] ) {
+            H5Ocopy( source, ".", file, path.c_str(), H5P_DEFAULT, H5P_DEFAULT );
+            return;
+        }
+
+        hid_t dcpl = H5Pcreate( H5P_DATASET_CREATE );
+        hid_t vspace = H5Screate_simple( ndim, &global_dims_[0], NULL );
+        vector<hsize_t> ones( ndim, 1 );
+        for( unsigned int b=0; b<blocks_.size(); b++ ) {
+            H5Sselect_hyperslab( vspace, H5S_SELECT_SET, &blocks_[b].virtual_start[0], NULL, &ones[0], &blocks_[b].count[0] );
+            hid_t srcspace = H5Screate_simple( ndim, &source_dims_[blocks_[b].subfile][0], NULL );
+            H5Sselect_hyperslab( srcspace, H5S_SELECT_SET, &blocks_[b].source_start[0], NULL, &ones[0], &blocks_[b].count[0] );
+            // The subfile name is relative: it is found next to the master file
+            string name = subfileName( filename_.substr( filename_.find_last_of( "/" ) + 1 ), blocks_[b].subfile );
+            H5Pset_virtual( dcpl, vspace, name.c_str(), path.c_str(), srcspace );
+            H5Sclose( srcspace );
+        }
+        H5Sselect_all( vspace );
+        hid_t type = H5Dget_type( source );
+        hid_t dataset = H5Dcreate( file, path.c_str(), type, vspace, H5P_DEFAULT, dcpl, H5P_DEFAULT );
+        copyAttributes( source, dataset );
+        H5Dclose( dataset );
+        H5Tclose( type );
+        H5Sclose( vspace );
+        H5Pclose( dcpl );
+    }
+}
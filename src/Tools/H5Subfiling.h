@@ -0,0 +1,90 @@
+#ifndef H5SUBFILING_H
+#define H5SUBFILING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "H5.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class H5Subfiling
+//! Splits an output file in subfiles: each group of MPI processes writes its own subfile, with parallel HDF5 on the
+//! communicator of the group. The MPI master writes a master file, with the usual name, where each dataset is a
+//! virtual dataset (VDS) mapping the corresponding datasets of all subfiles, so that readers see a single file.
+//!     - select() and selectRange() define which part of the virtual datasets each MPI process writes, and where
+//!       it goes in the datasets of its subfile. They must be called by all MPI processes.
+//!     - mirror() copies a location of the subfile of the MPI master into the master file: groups and attributes
+//!       are copied, and the datasets become virtual datasets.
+//  --------------------------------------------------------------------------------------------------------------------
+class H5Subfiling
+{
+public:
+    //! \param filename name of the master file
+    //! \param subfile_comm communicator of the MPI processes writing the same subfile
+    //! \param subfile_index index of the subfile of the current MPI process
+    H5Subfiling( std::string filename, MPI_Comm world, MPI_Comm subfile_comm, unsigned int subfile_index );
+    ~H5Subfiling();
+
+    //! Name of the subfile #index of the master file filename
+    static std::string subfileName( std::string filename, unsigned int index );
+
+    //! Name of the subfile of the current MPI process
+    std::string subfileName()
+    {
+        return subfileName( filename_, subfile_index_ );
+    }
+
+    //! Translates the selection of global_space (ND) into the subfile, where the datasets only span the bounding
+    //! box of the selections of the MPI processes of the subfile. Returns the space to be written in the subfile.
+    H5Space * select( H5Space *global_space );
+
+    //! Translates the range [offset, offset+npoints[ of a 1D dataset into the subfile, where the datasets
+    //! concatenate the ranges of the MPI processes of the subfile.
+    //! \param[in,out] size, offset: size of the dataset and offset of the range, replaced by those in the subfile
+    void selectRange( uint64_t &size, uint64_t &offset, uint64_t npoints );
+
+    //! Copy the location path of the subfile into the master file (only done by the MPI master)
+    void mirror( H5 *subfile, std::string path );
+
+    //! Master file (NULL except on the MPI master)
+    H5Write * master()
+    {
+        return master_;
+    }
+
+    void flush()
+    {
+        if( master_ ) {
+            master_->flush();
+        }
+    }
+
+private:
+    //! Part of a virtual dataset found in a subfile
+    struct Block {
+        unsigned int subfile;
+        std::vector<hsize_t> virtual_start, source_start, count;
+    };
+
+    //! Send the blocks of all MPI processes to the MPI master
+    void gather( std::vector<hsize_t> global_dims, std::vector<hsize_t> source_dims, std::vector<Block> &blocks );
+
+    void mirrorObject( hid_t source, std::string path );
+
+    std::string filename_;
+    MPI_Comm world_, subfile_comm_;
+    unsigned int subfile_index_;
+
+    //! Master file (MPI master only)
+    H5Write *master_;
+
+    //! Dimensions of the virtual datasets (MPI master only)
+    std::vector<hsize_t> global_dims_;
+    //! Dimensions of the datasets in each subfile (MPI master only)
+    std::vector<std::vector<hsize_t> > source_dims_;
+    //! Mapping of the virtual datasets (MPI master only)
+    std::vector<Block> blocks_;
+};
+
+#endif
@@ -22,6 +22,7 @@ Timers::Timers( SmileiMPI *smpi ) :
     syncField( "Sync Fields" ),             // Call sumRhoJ(s), exchangeB (MPI & Patch sync)
     syncDens( "Sync Densities" ),           // If necessary the following timers can be reintroduced
     particleMerging( "Part Merging" ),      // Particle merging
+    particleSplitting( "Part Splitting" ),  // Particle splitting
     particleInjection( "Part Injection" ),  // Particle injection
     diagsNEW( "DiagnosticsNEW" ),           // Diags.runAllDiags + MPI & Patch sync
     reconfiguration( "Reconfiguration" ),   // Patch reconfiguration
@@ -63,6 +64,7 @@ Timers::Timers( SmileiMPI *smpi ) :
     timers.push_back( &syncField );
     timers.push_back( &syncDens );
     timers.push_back( &particleMerging );
+    timers.push_back( &particleSplitting );
     timers.push_back( &particleInjection );
     timers.push_back( &diagsNEW );
     timers.push_back( &reconfiguration );
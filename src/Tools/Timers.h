@@ -32,6 +32,7 @@ public:
     Timer syncField ;
     Timer syncDens  ;
     Timer particleMerging;
+    Timer particleSplitting;
     Timer particleInjection;
     Timer diagsNEW  ;
     Timer reconfiguration  ;
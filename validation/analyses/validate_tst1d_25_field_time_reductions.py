@@ -0,0 +1,26 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The plane wave Ey = a0*sin(t-x) fills the box during the last reduction period,
+# which spans an integer number of optical cycles:
+# rms ~ a0/sqrt(2), max ~ a0, dft amplitude ~ a0 at omega and ~ 0 at 2*omega
+last = S.Field.Field0("Ey").getAvailableTimesteps()[-1]
+subset = {"x":[0,10000,4]}
+
+rms = S.Field.Field0("Ey", timesteps=last, subset=subset).getData()[0]
+Validate("Field rms of Ey", rms, 1e-6)
+
+amax = S.Field.Field1("Ey", timesteps=last, subset=subset).getData()[0]
+Validate("Field max of Ey", amax, 1e-6)
+
+for ifreq in range(2):
+    for part in ["re", "im"]:
+        name = "Ey_dft%d_%s"%(ifreq, part)
+        dft = S.Field.Field2(name, timesteps=last, subset=subset).getData()[0]
+        Validate("Field dft "+name, dft, 1e-6)
+
+# Probe at the center of the box
+rms = S.Probe(0, "Ey").getData()
+Validate("Probe rms of Ey vs time", rms, 1e-6)
@@ -0,0 +1,12 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The electron density 1+delta*cos(k*y) over uniform ions gives Ey = -delta/k*sin(k*y)
+# far from the open boundaries along x, where the potential is set to zero.
+# The precision covers the differences with the default CG solver, which also matches the reference
+Ex = S.Field.Field0.Ex(timesteps=0, subset={"x":[0,10000,8], "y":[0,10000,4]}).getData()[0]
+Ey = S.Field.Field0.Ey(timesteps=0, subset={"x":[0,10000,8], "y":[0,10000,4]}).getData()[0]
+Validate("Ex field at iteration 0", Ex, 1e-6)
+Validate("Ey field at iteration 0", Ey, 1e-6)
@@ -0,0 +1,14 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Neutral particles: the splitting must conserve the total weight and momentum
+idiag = 0
+for name in ["split", "split_displaced"]:
+    Ntot = np.array(S.Scalar("Ntot_"+name).getData())
+    Validate("Number of particles of "+name+" vs time", Ntot)
+    for quantity in ["weight", "weight_px", "weight_py"]:
+        total = np.array(S.ParticleBinning(idiag).getData()).flatten()
+        Validate("Total "+quantity+" of "+name+" vs time", total, 1e-10, "relative_error")
+        idiag += 1
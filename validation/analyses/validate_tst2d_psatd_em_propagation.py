@@ -0,0 +1,35 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+xa = S.namelist.xa
+dt = S.namelist.Main.timestep
+dx = S.namelist.Main.cell_length[0]
+
+# Ez profile (uniform along y) of the pulses emitted by the antenna, after it has stopped
+Ez = S.Field.Field0("Ez", average={"y":"all"})
+steps = Ez.getTimesteps()
+for step in steps:
+    Validate("Ez profile at iteration %d"%step, Ez.getData(timestep=step)[0][::4], 1e-6)
+
+# Dispersion-free: the pulses travel at c
+t = np.array(steps)*dt
+for side, direction in [("right", 1.), ("left", -1.)]:
+    centroid = []
+    for step in steps:
+        profile = np.array(Ez.getData(timestep=step)[0])**2
+        x = np.arange(profile.size)*dx
+        mask = direction*(x-xa) > 0.
+        centroid += [ np.sum(x[mask]*profile[mask])/np.sum(profile[mask]) ]
+    Validate("Velocity of the pulse going "+side, direction*(centroid[1]-centroid[0])/(t[1]-t[0]), 0.01)
+
+# Energy of the fields, constant after the antenna has stopped
+Uelm = S.Scalar("Uelm").getData()
+Validate("Electromagnetic energy vs time", Uelm, 1e-3*np.max(Uelm))
+
+# Poynting flux on each side of the antenna, and its time integral: the energy carried by each pulse
+for iprobe, side in [(0, "left"), (1, "right")]:
+    PoyX = np.array(S.Probe(iprobe, "PoyX").getData())
+    Validate("Poynting flux on the "+side+" vs time", PoyX[::8], 1e-3*np.abs(PoyX).max())
+    Validate("Energy flowing on the "+side, np.sum(PoyX)*dt*S.namelist.Main.grid_length[1], 1e-3*np.max(Uelm))